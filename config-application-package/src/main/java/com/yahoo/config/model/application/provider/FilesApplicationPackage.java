@@ -810,11 +810,11 @@ public class FilesApplicationPackage extends AbstractApplicationPackage {
         // Note: Directories intentionally not validated: MODELS_DIR (custom models can contain files with any extension)
 
         // TODO: Files that according to doc (https://docs.vespa.ai/en/reference/schema-reference.html) can be anywhere in the application package:
-        //   constant tensors (.json, .json.lz4)
+        //   constant tensors (.json, .json.lz4, .mtf)
         //   onnx model files (.onnx)
         validFileExtensions = Map.ofEntries(
                 Map.entry(Path.fromString(COMPONENT_DIR), Set.of(".jar")),
-                Map.entry(CONSTANTS_DIR, Set.of(".json", ".json.lz4")),
+                Map.entry(CONSTANTS_DIR, Set.of(".json", ".json.lz4", ".mtf")),
                 Map.entry(Path.fromString(DOCPROCCHAINS_DIR), Set.of(".xml")),
                 Map.entry(PAGE_TEMPLATES_DIR, Set.of(".xml")),
                 Map.entry(Path.fromString(PROCESSORCHAINS_DIR), Set.of(".xml")),
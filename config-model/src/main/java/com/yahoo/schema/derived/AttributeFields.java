@@ -218,6 +218,9 @@ public class AttributeFields extends Derived {
         if (attribute.isPaged()) {
             aaB.paged(true);
         }
+        aaB.memory.hugepages(AttributesConfig.Attribute.Memory.Hugepages.Enum.valueOf(attribute.hugePages().toString()));
+        aaB.memory.numa(AttributesConfig.Attribute.Memory.Numa.Enum.valueOf(attribute.numa().toString()));
+        aaB.memory.numanodes(attribute.numaNodes());
         if (attribute.getSorting().isDescending()) {
             aaB.sortascending(false);
         }
@@ -43,6 +43,12 @@ public final class Attribute implements Cloneable, Serializable {
 
     public enum DistanceMetric { EUCLIDEAN, ANGULAR, GEODEGREES, INNERPRODUCT, HAMMING, PRENORMALIZED_ANGULAR, DOTPRODUCT }
 
+    /** Huge page policy for the memory used by this attribute */
+    public enum HugePages { DEFAULT, NONE, TRANSPARENT, EXPLICIT_2M, EXPLICIT_1G }
+
+    /** NUMA placement policy for the memory used by this attribute */
+    public enum Numa { DEFAULT, INTERLEAVE, BIND }
+
     // Remember to change hashCode and equals when you add new fields
 
     private String name;
@@ -59,6 +65,9 @@ public final class Attribute implements Cloneable, Serializable {
     private boolean fastAccess = false;
     private boolean mutable = false;
     private boolean paged = false;
+    private HugePages hugePages = HugePages.DEFAULT;
+    private Numa numa = Numa.DEFAULT;
+    private long numaNodes = 0;
     private int arity = BooleanIndexDefinition.DEFAULT_ARITY;
     private long lowerBound = BooleanIndexDefinition.DEFAULT_LOWER_BOUND;
     private long upperBound = BooleanIndexDefinition.DEFAULT_UPPER_BOUND;
@@ -203,6 +212,9 @@ public final class Attribute implements Cloneable, Serializable {
     public boolean isFastRank()            {  return fastRank; }
     public boolean isFastAccess()           { return fastAccess; }
     public boolean isPaged()                { return paged; }
+    public HugePages hugePages()            { return hugePages; }
+    public Numa numa()                      { return numa; }
+    public long numaNodes()                 { return numaNodes; }
     public boolean isPosition()             { return isPosition; }
     public boolean isMutable()              { return mutable; }
 
@@ -247,6 +259,9 @@ public final class Attribute implements Cloneable, Serializable {
     }
     public void setFastSearch(boolean fastSearch)                { this.fastSearch = fastSearch; }
     public void setPaged(boolean paged)                          { this.paged = paged; }
+    public void setHugePages(HugePages hugePages)                { this.hugePages = hugePages; }
+    public void setNuma(Numa numa)                               { this.numa = numa; }
+    public void setNumaNodes(long numaNodes)                     { this.numaNodes = numaNodes; }
     public void setFastAccess(boolean fastAccess)                { this.fastAccess = fastAccess; }
     public void setPosition(boolean position)                    { this.isPosition = position; }
     public void setMutable(boolean mutable)                      { this.mutable = mutable; }
@@ -393,7 +408,7 @@ public final class Attribute implements Cloneable, Serializable {
     public int hashCode() {
         return Objects.hash(
                 name, type, collectionType, sorting, dictionary, isPrefetch(), fastAccess, removeIfZero,
-                createIfNonExistent, isPosition, mutable, paged, enableOnlyBitVector,
+                createIfNonExistent, isPosition, mutable, paged, hugePages, numa, numaNodes, enableOnlyBitVector,
                 tensorType, referenceDocumentType, distanceMetric, hnswIndexParams);
     }
 
@@ -416,6 +431,9 @@ public final class Attribute implements Cloneable, Serializable {
         if (this.fastSearch != other.fastSearch) return false;
         if (this.mutable != other.mutable) return false;
         if (this.paged != other.paged) return false;
+        if (this.hugePages != other.hugePages) return false;
+        if (this.numa != other.numa) return false;
+        if (this.numaNodes != other.numaNodes) return false;
         if (! this.sorting.equals(other.sorting)) return false;
         if (! Objects.equals(dictionary, other.dictionary)) return false;
         if (! Objects.equals(tensorType, other.tensorType)) return false;
@@ -110,12 +110,28 @@ public class ConvertParsedFields {
             upper = upper.replace('-', '_');
             attribute.setDistanceMetric(Attribute.DistanceMetric.valueOf(upper));
         }
+        var hugePages = parsed.getHugePages();
+        if (hugePages.isPresent()) {
+            attribute.setHugePages(Attribute.HugePages.valueOf(toEnumName(hugePages.get())));
+        }
+        var numa = parsed.getNuma();
+        if (numa.isPresent()) {
+            attribute.setNuma(Attribute.Numa.valueOf(toEnumName(numa.get())));
+        }
+        var numaNodes = parsed.getNumaNodes();
+        if (numaNodes.isPresent()) {
+            attribute.setNumaNodes(numaNodes.get());
+        }
         var sorting = parsed.getSorting();
         if (sorting.isPresent()) {
             convertSorting(schema, field, sorting.get(), name);
         }
     }
 
+    private static String toEnumName(String value) {
+        return value.toUpperCase(Locale.ENGLISH).replace('-', '_');
+    }
+
     private void convertRankType(SDField field, String indexName, String rankType) {
         RankType type = RankType.fromString(rankType);
         if (indexName == null || indexName.equals("")) {
@@ -23,6 +23,9 @@ public class ParsedAttribute extends ParsedBlock {
     private final Map<String, String> aliases = new LinkedHashMap<>();
     private ParsedSorting sortSettings = null;
     private String distanceMetric = null;
+    private String hugePages = null;
+    private String numa = null;
+    private Long numaNodes = null;
 
     public ParsedAttribute(String name) {
         super(name, "attribute");
@@ -31,6 +34,9 @@ public class ParsedAttribute extends ParsedBlock {
     List<String> getAliases() { return List.copyOf(aliases.keySet()); }
     String lookupAliasedFrom(String alias) { return aliases.get(alias); }
     Optional<String> getDistanceMetric() { return Optional.ofNullable(distanceMetric); }
+    Optional<String> getHugePages() { return Optional.ofNullable(hugePages); }
+    Optional<String> getNuma() { return Optional.ofNullable(numa); }
+    Optional<Long> getNumaNodes() { return Optional.ofNullable(numaNodes); }
     boolean getEnableOnlyBitVector() { return this.enableOnlyBitVector; }
     boolean getFastAccess() { return this.enableFastAccess; }
     boolean getFastRank() { return this.enableFastRank; }
@@ -49,6 +55,21 @@ public class ParsedAttribute extends ParsedBlock {
         this.distanceMetric = value;
     }
 
+    public void setHugePages(String value) {
+        verifyThat(hugePages == null, "already has huge-pages", hugePages);
+        this.hugePages = value;
+    }
+
+    public void setNuma(String value) {
+        verifyThat(numa == null, "already has numa", numa);
+        this.numa = value;
+    }
+
+    public void setNumaNodes(long value) {
+        verifyThat(numaNodes == null, "already has numa-nodes", numaNodes);
+        this.numaNodes = value;
+    }
+
     public ParsedSorting sortInfo() {
         if (sortSettings == null) sortSettings = new ParsedSorting(name(), "attribute.sorting");
         return this.sortSettings;
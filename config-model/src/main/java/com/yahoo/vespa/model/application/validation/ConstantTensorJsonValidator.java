@@ -94,9 +94,12 @@ public class ConstantTensorJsonValidator {
         else if (fileName.endsWith(".tbf")) {
             // don't validate; internal format, so this constant is written by us
         }
+        else if (fileName.endsWith(".mtf")) {
+            // don't validate; binary dense tensor written by vespa-make-mapped-tensor, memory mapped by the content nodes
+        }
         else {
             // (don't mention the internal format to users)
-            throw new IllegalArgumentException("Ranking constant file names must end with either '.json' or '.json.lz4'");
+            throw new IllegalArgumentException("Ranking constant file names must end with either '.json', '.json.lz4' or '.mtf'");
         }
     }
 
@@ -112,6 +112,9 @@ public class AttributeChangeValidator {
                 validateAttributeProperty(id, current, next, AttributeChangeValidator::extractDictionaryCase, "dictionary: cased/uncased", result);
                 validateAttributePredicate(id, current, next, Attribute::isPaged, "paged", result);
                 validatePagedAttributeRemoval(current, next);
+                validateAttributeProperty(id, current, next, Attribute::hugePages, "huge-pages", result);
+                validateAttributeProperty(id, current, next, Attribute::numa, "numa", result);
+                validateAttributeProperty(id, current, next, Attribute::numaNodes, "numa-nodes", result);
                 validateAttributeProperty(id, current, next, Attribute::densePostingListThreshold, "dense-posting-list-threshold", result);
                 validateAttributePredicate(id, current, next, Attribute::isEnabledOnlyBitVector, "rank: filter", result);
                 validateAttributeProperty(id, current, next, Attribute::distanceMetric, "distance-metric", result);
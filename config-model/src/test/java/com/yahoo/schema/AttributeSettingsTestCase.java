@@ -366,5 +366,45 @@ public class AttributeSettingsTestCase extends AbstractSchemaTestCase {
                         "}"));
     }
 
+    @Test
+    void memory_policy_is_default_when_not_set() throws ParseException {
+        var cfg = getAttributesConfig(joinLines("search test {",
+                "  document test {",
+                "    field f type array<int> {",
+                "      indexing: attribute",
+                "    }",
+                "  }",
+                "}"));
+        assertEquals(AttributesConfig.Attribute.Memory.Hugepages.DEFAULT, cfg.attribute(0).memory().hugepages());
+        assertEquals(AttributesConfig.Attribute.Memory.Numa.DEFAULT, cfg.attribute(0).memory().numa());
+        assertEquals(0, cfg.attribute(0).memory().numanodes());
+    }
+
+    @Test
+    void memory_policy_is_propagated_to_attributes_config() throws ParseException {
+        var cfg = getAttributesConfig(joinLines("search test {",
+                "  document test {",
+                "    field f type array<int> {",
+                "      indexing: attribute",
+                "      attribute {",
+                "        huge-pages: explicit-2m",
+                "        numa: interleave",
+                "        numa-nodes: 3",
+                "      }",
+                "    }",
+                "  }",
+                "}"));
+        assertEquals(AttributesConfig.Attribute.Memory.Hugepages.EXPLICIT_2M, cfg.attribute(0).memory().hugepages());
+        assertEquals(AttributesConfig.Attribute.Memory.Numa.INTERLEAVE, cfg.attribute(0).memory().numa());
+        assertEquals(3, cfg.attribute(0).memory().numanodes());
+    }
+
+    private AttributesConfig getAttributesConfig(String sd) throws ParseException {
+        var attrs = new AttributeFields(getSchema(sd));
+        var builder = new AttributesConfig.Builder();
+        attrs.getConfig(builder, AttributeFields.FieldSet.ALL, 100);
+        return builder.build();
+    }
+
 
 }
@@ -385,4 +385,18 @@ public class ConstantTensorJsonValidatorTest {
                         "{'address':{'a':'qux','c':'zip'},'values':[[9,8],[7,6],[5,4]]}]}"));
     }
 
+    @Test
+    void ensure_that_mapped_tensor_files_are_accepted_without_validation() {
+        new ConstantTensorJsonValidator(TensorType.fromSpec("tensor<float>(x[1000000])"))
+                .validate("embeddings.mtf", new StringReader("not json"));
+    }
+
+    @Test
+    void ensure_that_unknown_file_suffix_is_rejected() {
+        Throwable exception = assertThrows(IllegalArgumentException.class, () ->
+                new ConstantTensorJsonValidator(TensorType.fromSpec("tensor(x[3])"))
+                        .validate("constant.bin", new StringReader("")));
+        assertTrue(exception.getMessage().contains("must end with either '.json', '.json.lz4' or '.mtf'"));
+    }
+
 }
@@ -151,6 +151,8 @@ public class FileDBRegistry implements FileRegistry {
             relative += ".json.lz4";
         } else if (uri.endsWith(".lz4")) {
             relative += ".lz4";
+        } else if (uri.endsWith(".mtf")) {
+            relative += ".mtf";
         }
         return relative;
     }
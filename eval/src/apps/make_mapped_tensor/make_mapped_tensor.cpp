@@ -0,0 +1,41 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/eval/value_cache/mapped_constant_value.h>
+#include <cstdio>
+#include <string>
+
+using namespace vespalib::eval;
+
+int usage(const char *self) {
+    fprintf(stderr, "usage: %s <constant-file> <tensor-type> <output-file>\n", self);
+    fprintf(stderr, "  convert a dense ranking constant to a memory mappable tensor file\n");
+    fprintf(stderr, "  the constant file is read in any format accepted for ranking constants\n");
+    fprintf(stderr, "  ('.json', '.json.lz4' or '.tbf'); the output file should end with '.mtf'\n");
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 4) {
+        return usage(argv[0]);
+    }
+    std::string input = argv[1];
+    std::string type = argv[2];
+    std::string output = argv[3];
+    auto value_type = ValueType::from_spec(type);
+    if (value_type.is_error() || !value_type.is_dense()) {
+        fprintf(stderr, "error: '%s' is not a dense tensor type\n", type.c_str());
+        return 1;
+    }
+    auto constant = ConstantTensorLoader(FastValueBuilderFactory::get()).create(input, type);
+    if (constant->type().is_error()) {
+        fprintf(stderr, "error: could not load '%s' as '%s'\n", input.c_str(), type.c_str());
+        return 1;
+    }
+    if (!MappedConstantValue::save(output, constant->value())) {
+        fprintf(stderr, "error: could not write '%s'\n", output.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -2,6 +2,7 @@
 
 #include <vespa/eval/eval/fast_value.hpp>
 #include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/simple_value.h>
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/eval/eval/test/gen_spec.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -64,6 +65,27 @@ TEST(FastCellsTest, add_cells_works) {
     EXPECT_EQ(*cells.get(5), 6.0);
 }
 
+TEST(FastCellsTest, stashed_cells_are_copied_when_growing) {
+    Stash stash;
+    FastCells<float> cells(3, stash);
+    EXPECT_EQ(cells.capacity, 4);
+    auto arr1 = cells.add_cells(3);
+    arr1[0] = 1.0;
+    arr1[1] = 2.0;
+    arr1[2] = 3.0;
+    const float *old_data = cells.get(0);
+    auto arr2 = cells.add_cells(3);
+    EXPECT_EQ(cells.capacity, 8);
+    EXPECT_NE(cells.get(0), old_data);
+    arr2[0] = 4.0;
+    arr2[1] = 5.0;
+    arr2[2] = 6.0;
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(*cells.get(i), float(i + 1));
+    }
+    EXPECT_EQ(cells.estimate_extra_memory_usage().allocatedBytes(), 0u);
+}
+
 TEST(FastValueTest, insert_subspace) {
     Handle foo("foo");
     Handle bar("bar");
@@ -271,4 +293,139 @@ TEST(FastValueBuilderFactoryTest, fast_values_can_be_copied) {
     }
 }
 
+const Value &stashed_copy(const ValueBuilderFactory &factory, const Value &value, Stash &stash) {
+    const ValueType &type = value.type();
+    size_t num_mapped = type.count_mapped_dimensions();
+    size_t subspace_size = type.dense_subspace_size();
+    auto cells = value.cells().typify<double>();
+    auto &builder = factory.create_stashed_value_builder<double>(type, num_mapped, subspace_size,
+                                                                 value.index().size(), stash);
+    std::vector<string_id> addr(num_mapped);
+    std::vector<string_id*> addr_refs;
+    for (auto &label: addr) {
+        addr_refs.push_back(&label);
+    }
+    size_t subspace;
+    auto view = value.index().create_view({});
+    view->lookup({});
+    while (view->next_result(addr_refs, subspace)) {
+        auto dst = builder.add_subspace(addr);
+        for (size_t i = 0; i < subspace_size; ++i) {
+            dst[i] = cells[subspace * subspace_size + i];
+        }
+    }
+    return builder.build_stashed(stash);
+}
+
+TEST(FastValueBuilderFactoryTest, stashed_values_can_be_built) {
+    for (const ValueBuilderFactory *factory: {static_cast<const ValueBuilderFactory *>(&FastValueBuilderFactory::get()),
+                                              static_cast<const ValueBuilderFactory *>(&SimpleValueBuilderFactory::get())})
+    {
+        Stash stash;
+        for (const auto &layout: layouts) {
+            auto expect = layout.cpy().cells_double();
+            std::unique_ptr<Value> value = value_from_spec(expect, *factory);
+            const Value &copy = stashed_copy(*factory, *value, stash);
+            EXPECT_EQ(spec_from_value(copy), expect);
+        }
+        stash.reset();
+        for (const auto &layout: layouts) {
+            auto expect = layout.cpy().cells_double();
+            std::unique_ptr<Value> value = value_from_spec(expect, *factory);
+            const Value &copy = stashed_copy(*factory, *value, stash);
+            EXPECT_EQ(spec_from_value(copy), expect);
+        }
+    }
+}
+
+TEST(FastValueBuilderFactoryTest, stashed_dense_values_keep_their_cells_in_the_stash) {
+    Stash stash;
+    auto expect = G().idx("x", 3).idx("y", 5).cells_double();
+    std::unique_ptr<Value> value = value_from_spec(expect, FastValueBuilderFactory::get());
+    size_t used_before = stash.count_used();
+    const Value &copy = stashed_copy(FastValueBuilderFactory::get(), *value, stash);
+    EXPECT_GE(stash.count_used() - used_before, 15 * sizeof(double));
+    EXPECT_EQ(copy.cells().size, 15u);
+    EXPECT_EQ(spec_from_value(copy), expect);
+}
+
+std::vector<Handle> make_sorted_handles(const std::vector<std::string> &names) {
+    std::vector<Handle> handles;
+    for (const auto &name: names) {
+        handles.emplace_back(name);
+    }
+    std::sort(handles.begin(), handles.end(), [](const Handle &a, const Handle &b)
+              { return (a.id().value() < b.id().value()); });
+    return handles;
+}
+
+std::unique_ptr<FastValue<double,true>> make_sparse(const std::vector<Handle> &handles, const std::vector<size_t> &order) {
+    auto value = std::make_unique<FastValue<double,true>>(ValueType::from_spec("tensor(x{})"), 1, 1, order.size());
+    for (size_t idx: order) {
+        value->add_singledim_mapping(handles[idx].id());
+        value->my_cells.push_back_fast(double(idx));
+    }
+    return value;
+}
+
+void verify_sorted_labels(const FastAddrMap &map) {
+    ASSERT_TRUE(map.has_sorted_labels());
+    auto sorted = map.sorted_labels();
+    ASSERT_EQ(sorted.size(), map.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        EXPECT_EQ(map.labels()[sorted.subspace(i)], sorted.labels[i]);
+        if (i > 0) {
+            EXPECT_LT(sorted.labels[i - 1].value(), sorted.labels[i].value());
+        }
+    }
+}
+
+TEST(FastValueTest, labels_added_in_increasing_order_are_sorted) {
+    auto handles = make_sorted_handles({"a", "b", "c", "d"});
+    auto value = make_sparse(handles, {0, 1, 3});
+    const auto &map = as_fast(value->index()).map;
+    verify_sorted_labels(map);
+    EXPECT_EQ(map.sorted_labels().subspaces, nullptr);
+    value->add_singledim_mapping(handles[2].id());
+    EXPECT_FALSE(map.has_sorted_labels());
+}
+
+TEST(FastValueTest, sorted_label_index_can_be_added) {
+    auto handles = make_sorted_handles({"a", "b", "c", "d", "e"});
+    auto value = make_sparse(handles, {3, 0, 4, 1});
+    const auto &map = as_fast(value->index()).map;
+    EXPECT_FALSE(map.has_sorted_labels());
+    size_t usage_before = value->get_memory_usage().usedBytes();
+    add_sorted_label_index(*value);
+    verify_sorted_labels(map);
+    EXPECT_NE(map.sorted_labels().subspaces, nullptr);
+    EXPECT_GT(value->get_memory_usage().usedBytes(), usage_before);
+    value->add_singledim_mapping(handles[2].id());
+    EXPECT_FALSE(map.has_sorted_labels());
+}
+
+TEST(FastValueTest, sorted_label_index_is_not_added_for_multiple_dimensions) {
+    auto value = value_from_spec(G().map("x", {"a", "b"}).map("y", {"c", "d"}), FastValueBuilderFactory::get());
+    add_sorted_label_index(*value);
+    EXPECT_FALSE(as_fast(value->index()).map.has_sorted_labels());
+}
+
+TEST(FastValueTest, common_labels_are_found_by_merging_sorted_labels) {
+    auto handles = make_sorted_handles({"a", "b", "c", "d", "e", "f", "g"});
+    auto lhs = make_sparse(handles, {5, 0, 2, 3});
+    auto rhs = make_sparse(handles, {1, 2, 4, 5, 6});
+    add_sorted_label_index(*lhs);
+    const auto &lhs_map = as_fast(lhs->index()).map;
+    const auto &rhs_map = as_fast(rhs->index()).map;
+    EXPECT_TRUE(FastAddrMap::use_merge(lhs_map, rhs_map));
+    std::vector<std::pair<double,double>> common;
+    FastAddrMap::each_common_label(lhs_map.sorted_labels(), rhs_map.sorted_labels(),
+                                   [&](auto lhs_subspace, auto rhs_subspace) {
+                                       common.emplace_back(lhs->my_cells.get(0)[lhs_subspace],
+                                                           rhs->my_cells.get(0)[rhs_subspace]);
+                                   });
+    std::vector<std::pair<double,double>> expect = {{2.0, 2.0}, {5.0, 5.0}};
+    EXPECT_EQ(common, expect);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
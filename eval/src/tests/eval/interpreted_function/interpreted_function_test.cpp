@@ -5,10 +5,12 @@
 #include <vespa/eval/eval/tensor_function.h>
 #include <vespa/eval/eval/operation.h>
 #include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/interpreted_function_cache.h>
 #include <vespa/eval/eval/compile_tensor_function.h>
 #include <vespa/eval/eval/test/eval_spec.h>
 #include <vespa/eval/eval/basic_nodes.h>
 #include <vespa/eval/eval/simple_value.h>
+#include <vespa/eval/eval/value_codec.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
@@ -219,4 +221,39 @@ TEST(InterpretedFunctionTest, require_that_compilation_meta_data_can_be_collecte
 
 //-----------------------------------------------------------------------------
 
+TEST(InterpretedFunctionTest, require_that_interpreted_functions_can_be_shared_and_evicted)
+{
+    const auto &factory = FastValueBuilderFactory::get();
+    std::string expr = "reduce(a*b,sum)";
+    std::string other_expr = "reduce(a+b,sum)";
+    auto fun = Function::parse({"a", "b"}, expr);
+    auto other_fun = Function::parse({"a", "b"}, other_expr);
+    std::vector<ValueType> types = {ValueType::from_spec("tensor(x[3])"), ValueType::from_spec("tensor(x[3])")};
+    std::vector<ValueType> other_types = {ValueType::from_spec("tensor(x{})"), ValueType::from_spec("tensor(x{})")};
+    {
+        auto f1 = InterpretedFunctionCache::create(factory, expr, *fun, types);
+        auto f2 = InterpretedFunctionCache::create(factory, expr, *fun, types);
+        auto f3 = InterpretedFunctionCache::create(factory, expr, *fun, other_types);
+        auto f4 = InterpretedFunctionCache::create(factory, other_expr, *other_fun, types);
+        auto f5 = InterpretedFunctionCache::create(SimpleValueBuilderFactory::get(), expr, *fun, types);
+        EXPECT_EQ(&(f1->get()), &(f2->get()));
+        EXPECT_NE(&(f1->get()), &(f3->get()));
+        EXPECT_NE(&(f1->get()), &(f4->get()));
+        EXPECT_NE(&(f1->get()), &(f5->get()));
+        EXPECT_EQ(InterpretedFunctionCache::num_cached(), 4u);
+        EXPECT_EQ(InterpretedFunctionCache::count_refs(), 5u);
+        auto a = TensorSpec("tensor(x[3])").add({{"x", 0}}, 1).add({{"x", 1}}, 2).add({{"x", 2}}, 3);
+        auto b = TensorSpec("tensor(x[3])").add({{"x", 0}}, 4).add({{"x", 1}}, 5).add({{"x", 2}}, 6);
+        auto a_value = value_from_spec(a, factory);
+        auto b_value = value_from_spec(b, factory);
+        SimpleObjectParams params({*a_value, *b_value});
+        InterpretedFunction::Context ctx(f2->get());
+        EXPECT_EQ(f2->get().eval(ctx, params).as_double(), 32.0);
+    }
+    EXPECT_EQ(InterpretedFunctionCache::num_cached(), 0u);
+    EXPECT_EQ(InterpretedFunctionCache::count_refs(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+
 GTEST_MAIN_RUN_ALL_TESTS()
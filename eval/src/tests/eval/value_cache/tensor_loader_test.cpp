@@ -1,9 +1,11 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/eval/value_cache/mapped_constant_value.h>
 #include <vespa/eval/eval/simple_value.h>
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/eval/eval/tensor_spec.h>
+#include <filesystem>
 
 using namespace vespalib::eval;
 
@@ -130,6 +132,41 @@ TEST_F("require that bad lz4 file fails to load creating empty result", Constant
     TEST_DO(verify_tensor(sparse_tensor_nocells(), f1.create(TEST_PATH("bad_lz4.json.lz4"), "tensor(x{},y{})")));
 }
 
+void verify_mapped_tensor(const TensorSpec &spec) {
+    std::string path = "saved.mtf";
+    ASSERT_TRUE(MappedConstantValue::save(path, *value_from_spec(spec, factory)));
+    auto actual = ConstantTensorLoader(factory).create(path, spec.type());
+    ASSERT_EQUAL(spec.type(), actual->type().to_spec());
+    EXPECT_TRUE(dynamic_cast<const MappedConstantValue *>(actual.get()));
+    EXPECT_TRUE(dynamic_cast<const DenseValueView *>(&actual->value()));
+    EXPECT_EQUAL(spec, spec_from_value(actual->value()));
+    std::filesystem::remove(path);
+}
+
+TEST("require that dense tensors can be saved and memory mapped") {
+    TEST_DO(verify_mapped_tensor(make_dense_tensor()));
+    TEST_DO(verify_mapped_tensor(make_simple_dense_tensor()));
+    TEST_DO(verify_mapped_tensor(TensorSpec("tensor<float>(x[3])")
+                                 .add({{"x", 0}}, 1.5).add({{"x", 1}}, 2.5).add({{"x", 2}}, 3.5)));
+}
+
+TEST("require that memory mapped tensor with wrong type gives bad constant value") {
+    std::string path = "wrong_type.mtf";
+    ASSERT_TRUE(MappedConstantValue::save(path, *value_from_spec(make_dense_tensor(), factory)));
+    TEST_DO(verify_invalid(ConstantTensorLoader(factory).create(path, "tensor(x[4])")));
+    std::filesystem::remove(path);
+}
+
+TEST("require that missing or invalid memory mapped tensor gives bad constant value") {
+    TEST_DO(verify_invalid(ConstantTensorLoader(factory).create(TEST_PATH("missing_file.mtf"), "tensor(x[2],y[2])")));
+    TEST_DO(verify_invalid(MappedConstantValue::load(TEST_PATH("dense.tbf"))));
+}
+
+TEST("require that only dense tensors can be saved as memory mapped tensors") {
+    EXPECT_FALSE(MappedConstantValue::save("sparse.mtf", *value_from_spec(make_sparse_tensor(), factory)));
+    EXPECT_FALSE(std::filesystem::exists("sparse.mtf"));
+}
+
 void checkBitEq(double a, double b) {
     size_t aa, bb;
     memcpy(&aa, &a, sizeof(aa));
@@ -58,6 +58,12 @@ TEST(BestSimilarityFunctionTest, max_sim_can_be_optimized) {
     verify(gen_float("A3_2B3d8", 3), gen_float("b5_2d8", 7), max_sim);
 }
 
+TEST(BestSimilarityFunctionTest, max_sim_with_int8_cells_can_be_optimized) {
+    verify(gen_int8("A3_2B3d8", 3), gen_int8("b5d8", 7), max_sim);
+    verify(gen_int8("A3_2B3d8", 3), gen_int8("b5_2d8", 7), max_sim);
+    verify(gen_int8("d8", 3), gen_int8("b5_2d8", 7), max_sim);
+}
+
 TEST(BestSimilarityFunctionTest, min_hamming_can_be_optimized) {
     verify(gen_int8("A3_2B3d8", 3), gen_int8("b5d8", 7), min_hamming);
     verify(gen_int8("A3_2B3d8", 3), gen_int8("b5_2d8", 7), min_hamming);
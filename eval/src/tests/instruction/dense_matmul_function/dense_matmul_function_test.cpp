@@ -7,12 +7,15 @@
 #include <vespa/eval/eval/test/gen_spec.h>
 #include <vespa/eval/instruction/dense_matmul_function.h>
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/util/stash.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 using namespace vespalib;
 using namespace vespalib::eval;
 using namespace vespalib::eval::test;
 using namespace vespalib::eval::tensor_function;
+using vespalib::make_string_short::fmt;
 
 const ValueBuilderFactory &prod_factory = FastValueBuilderFactory::get();
 
@@ -101,4 +104,28 @@ TEST("require that matmul outer/outer works correctly") {
     TEST_DO(verify_optimized("reduce(b5d3*b5c2,sum,b)", details));
 }
 
+TEST("require that large matmul gives same result when split across threads") {
+    SimpleThreadBundle thread_bundle(4);
+    std::vector<std::vector<std::string>> layouts = {
+        {"a64d256", "b64d256", "d"},
+        {"a64d256", "d256e64", "d"},
+        {"b256c64", "b256d64", "b"}
+    };
+    for (CellType ct: {CellType::DOUBLE, CellType::FLOAT, CellType::BFLOAT16}) {
+        for (const auto &layout: layouts) {
+            auto expr = fmt("reduce(x*y,sum,%s)", layout[2].c_str());
+            TEST_STATE(fmt("%s with x: %s, y: %s", expr.c_str(), layout[0].c_str(), layout[1].c_str()).c_str());
+            auto param_repo = EvalFixture::ParamRepo()
+                              .add("x", GenSpec::from_desc(layout[0]).cells(ct))
+                              .add("y", GenSpec::from_desc(layout[1]).cells(ct));
+            EvalFixture fixture(prod_factory, expr, param_repo, true);
+            EXPECT_EQUAL(fixture.find_all<DenseMatMulFunction>().size(), 1u);
+            EXPECT_EQUAL(fixture.eval_with_thread_bundle(thread_bundle), fixture.result());
+            if (ct == CellType::DOUBLE) {
+                EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+            }
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -7,6 +7,7 @@
 #include <vespa/eval/eval/test/gen_spec.h>
 #include <vespa/eval/eval/test/eval_fixture.h>
 
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 
@@ -138,4 +139,20 @@ TEST("require that trivial dimensions can be trivially reduced") {
     TEST_DO(verify_optimized_multi("a1b1c2", "c,b", 1, 2, 1));
 }
 
+TEST("require that large dense single reduce gives same result when split across threads") {
+    SimpleThreadBundle thread_bundle(4);
+    for (CellType ct: {CellType::DOUBLE, CellType::FLOAT}) {
+        auto param_repo = EvalFixture::ParamRepo().add("x", GenSpec::from_desc("a64b128c32").cells(ct));
+        for (const auto &expr: {"reduce(x,sum,b)", "reduce(x,avg,b)", "reduce(x,max,c)", "reduce(x,sum,a)"}) {
+            TEST_STATE(expr);
+            EvalFixture fixture(EvalFixture::prod_factory(), expr, param_repo, true);
+            EXPECT_EQUAL(fixture.find_all<DenseSingleReduceFunction>().size(), 1u);
+            EXPECT_EQUAL(fixture.eval_with_thread_bundle(thread_bundle), fixture.result());
+            if (ct == CellType::DOUBLE) {
+                EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+            }
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -6,7 +6,9 @@
 #include <vespa/eval/instruction/generic_join.h>
 #include <vespa/eval/eval/interpreted_function.h>
 #include <vespa/eval/eval/test/reference_operations.h>
+#include <vespa/eval/eval/test/eval_fixture.h>
 #include <vespa/eval/eval/test/gen_spec.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -103,6 +105,33 @@ TEST(GenericJoinTest, dense_join_plan_can_be_executed) {
     EXPECT_EQ(c, expect);
 }
 
+TEST(GenericJoinTest, dense_join_plan_can_be_executed_in_outer_ranges) {
+    auto plan = DenseJoinPlan(ValueType::from_spec("tensor(a[5],b[3])"),
+                              ValueType::from_spec("tensor(b[3],c[2])"));
+    std::vector<std::pair<size_t,size_t>> expect;
+    plan.execute(0, 0, [&](size_t a_idx, size_t b_idx) { expect.emplace_back(a_idx, b_idx); });
+    std::vector<std::pair<size_t,size_t>> actual;
+    auto collect = [&](size_t a_idx, size_t b_idx) { actual.emplace_back(a_idx, b_idx); };
+    ASSERT_EQ(plan.outer_cnt(), 5);
+    plan.execute_outer_range(0, 2, collect);
+    EXPECT_EQ(actual.size(), 2 * (plan.out_size / plan.outer_cnt()));
+    plan.execute_outer_range(2, 5, collect);
+    EXPECT_EQ(actual, expect);
+}
+
+TEST(GenericJoinTest, large_dense_join_gives_same_result_when_split_across_threads) {
+    SimpleThreadBundle thread_bundle(4);
+    EvalFixture::ParamRepo param_repo;
+    param_repo.add("a", G().idx("x", 64).idx("y", 1024));
+    param_repo.add("b", G().idx("y", 1024).idx("z", 4));
+    for (const auto &expr: {"a*b", "b-a"}) {
+        SCOPED_TRACE(expr);
+        EvalFixture fixture(EvalFixture::prod_factory(), expr, param_repo, false);
+        EXPECT_EQ(fixture.eval_with_thread_bundle(thread_bundle), fixture.result());
+        EXPECT_EQ(fixture.result(), EvalFixture::ref(expr, param_repo));
+    }
+}
+
 TEST(GenericJoinTest, generic_join_works_for_simple_and_fast_values) {
     ASSERT_TRUE((join_layouts.size() % 2) == 0);
     for (size_t i = 0; i < join_layouts.size(); i += 2) {
@@ -6,7 +6,9 @@
 #include <vespa/eval/instruction/generic_reduce.h>
 #include <vespa/eval/eval/interpreted_function.h>
 #include <vespa/eval/eval/test/reference_operations.h>
+#include <vespa/eval/eval/test/eval_fixture.h>
 #include <vespa/eval/eval/test/gen_spec.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <optional>
@@ -61,6 +63,20 @@ TEST(GenericReduceTest, dense_reduce_plan_can_be_created) {
     EXPECT_EQ(plan.out_stride, expect_out_stride);
 }
 
+TEST(GenericReduceTest, dense_reduce_plan_can_be_executed_in_outer_ranges) {
+    auto type = ValueType::from_spec("tensor(a[4],b[3],c[2])");
+    auto plan = DenseReducePlan(type, type.reduce({"b"}));
+    EXPECT_TRUE(plan.can_split_outer());
+    EXPECT_FALSE(DenseReducePlan(type, type.reduce({"a"})).can_split_outer());
+    std::vector<std::pair<size_t,size_t>> expect;
+    plan.execute(0, [&](size_t in_idx, size_t out_idx) { expect.emplace_back(in_idx, out_idx); });
+    std::vector<std::pair<size_t,size_t>> actual;
+    auto collect = [&](size_t in_idx, size_t out_idx) { actual.emplace_back(in_idx, out_idx); };
+    plan.execute_outer_range(0, 0, 1, collect);
+    plan.execute_outer_range(0, 1, 4, collect);
+    EXPECT_EQ(actual, expect);
+}
+
 TEST(GenericReduceTest, sparse_reduce_plan_can_be_created) {
     auto type = ValueType::from_spec("tensor(a{},aa[10],b{},c{},cc[5],d{},e{},ee[1],f{})");
     auto plan = SparseReducePlan(type, type.reduce({"a", "d", "e"}));
@@ -99,5 +115,17 @@ TEST(GenericReduceTest, generic_reduce_works_for_fast_values) {
     test_generic_reduce_with(FastValueBuilderFactory::get());
 }
 
+TEST(GenericReduceTest, large_dense_reduce_gives_same_result_when_split_across_threads) {
+    SimpleThreadBundle thread_bundle(4);
+    EvalFixture::ParamRepo param_repo;
+    param_repo.add("a", G().idx("x", 64).idx("y", 128).idx("z", 32));
+    for (const auto &expr: {"reduce(a,sum,y)", "reduce(a,max,y,z)", "reduce(a,median,y)", "reduce(a,sum,x)"}) {
+        SCOPED_TRACE(expr);
+        EvalFixture fixture(EvalFixture::prod_factory(), expr, param_repo, false);
+        EXPECT_EQ(fixture.eval_with_thread_bundle(thread_bundle), fixture.result());
+        EXPECT_EQ(fixture.result(), EvalFixture::ref(expr, param_repo));
+    }
+}
+
 
 GTEST_MAIN_RUN_ALL_TESTS()
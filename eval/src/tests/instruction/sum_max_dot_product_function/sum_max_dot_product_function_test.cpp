@@ -1,10 +1,16 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/make_tensor_function.h>
+#include <vespa/eval/eval/optimize_tensor_function.h>
 #include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/value_codec.h>
 #include <vespa/eval/eval/test/eval_fixture.h>
 #include <vespa/eval/eval/test/gen_spec.h>
 #include <vespa/eval/instruction/sum_max_dot_product_function.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/require.h>
 #include <vespa/vespalib/gtest/gtest.h>
 
 using namespace vespalib;
@@ -12,6 +18,8 @@ using namespace vespalib::eval;
 using namespace vespalib::eval::test;
 
 const ValueBuilderFactory &prod_factory = FastValueBuilderFactory::get();
+bool bench = false;
+double budget = 1.0;
 
 //-----------------------------------------------------------------------------
 
@@ -72,6 +80,22 @@ TEST(SumMaxDotProduct, expressions_can_be_optimized)
     assert_optimized(empty_query, empty_document, 5);
 }
 
+TEST(SumMaxDotProduct, more_query_vectors_than_block_size_can_be_optimized)
+{
+    assert_optimized(QueGen(19, 5), DocGen(7, 5), 5);
+    assert_optimized(QueGen(16, 5), DocGen(3, 5), 5);
+}
+
+TEST(SumMaxDotProduct, bfloat16_and_int8_cells_can_be_optimized)
+{
+    assert_optimized(Que().cells(CellType::BFLOAT16), Doc().cells(CellType::BFLOAT16), 5);
+    assert_optimized(QueGen(11, 5).cells(CellType::BFLOAT16), Doc().cells(CellType::BFLOAT16), 5);
+    auto int8_query = GenSpec().cells(CellType::INT8).map("x", 11).idx("z", 16).seq(Seq({-3, 2, 5, -1, 0, 7, -8}));
+    auto int8_document = GenSpec().cells(CellType::INT8).map("y", 6).idx("z", 16).seq(Seq({4, -2, 9, 1, -6}));
+    assert_optimized(int8_query, int8_document, 16);
+    assert_optimized(int8_document, int8_query, 16);
+}
+
 TEST(SumMaxDotProduct, double_cells_are_not_optimized) {
     auto double_query = Que().cells_double();
     auto double_document = Doc().cells_double();
@@ -80,6 +104,11 @@ TEST(SumMaxDotProduct, double_cells_are_not_optimized) {
     assert_not_optimized(double_query, double_document);
 }
 
+TEST(SumMaxDotProduct, mixed_cell_types_are_not_optimized) {
+    assert_not_optimized(query, Doc().cells(CellType::BFLOAT16));
+    assert_not_optimized(Que().cells(CellType::INT8), document);
+}
+
 TEST(SumMaxDotProduct, trivial_dot_product_is_not_optimized) {
     auto trivial_query = QueTrivialZ();
     auto trivial_document = DocTrivialZ();
@@ -122,4 +151,61 @@ TEST(SumMaxDotProduct, similar_expressions_are_not_optimized) {
 
 //-----------------------------------------------------------------------------
 
-GTEST_MAIN_RUN_ALL_TESTS()
+double benchmark_cost(const TensorSpec &query_spec, const TensorSpec &document_spec, bool optimize) {
+    auto fun = Function::parse({"a", "b"}, main_expr);
+    REQUIRE(!fun->has_error());
+    auto query_value = value_from_spec(query_spec, prod_factory);
+    auto document_value = value_from_spec(document_spec, prod_factory);
+    SimpleObjectParams params({*query_value, *document_value});
+    NodeTypes node_types(*fun, {query_value->type(), document_value->type()});
+    REQUIRE(!node_types.get_type(fun->root()).is_error());
+    Stash stash;
+    const TensorFunction &plain_fun = make_tensor_function(prod_factory, fun->root(), node_types, stash);
+    const TensorFunction &my_fun = optimize ? optimize_tensor_function(prod_factory, plain_fun, stash) : plain_fun;
+    REQUIRE_EQ(as<SumMaxDotProductFunction>(my_fun) != nullptr, optimize);
+    InterpretedFunction ifun(prod_factory, my_fun);
+    InterpretedFunction::Context ctx(ifun);
+    BenchmarkTimer timer(budget);
+    while (timer.has_budget()) {
+        timer.before();
+        const Value &result = ifun.eval(ctx, params);
+        (void) result;
+        timer.after();
+    }
+    return timer.min_time() * 1000.0 * 1000.0;
+}
+
+void benchmark(CellType cell_type, size_t query_vectors, size_t document_vectors, size_t dp_size) {
+    auto query_spec = QueGen(query_vectors, dp_size).cells(cell_type).seq(Seq({-3, 2, 5, -1, 0, 7, -8})).gen();
+    auto document_spec = DocGen(document_vectors, dp_size).cells(cell_type).seq(Seq({4, -2, 9, 1, -6})).gen();
+    double generic_cost = benchmark_cost(query_spec, document_spec, false);
+    double optimized_cost = benchmark_cost(query_spec, document_spec, true);
+    fprintf(stderr, "%s: %zu query vectors, %zu document vectors, %zu cells each:\n"
+            "  generic: %10.3f us, optimized: %8.3f us, speedup: %7.3f\n",
+            value_from_spec(query_spec, prod_factory)->type().to_spec().c_str(),
+            query_vectors, document_vectors, dp_size, generic_cost, optimized_cost, generic_cost / optimized_cost);
+}
+
+TEST(SumMaxDotProduct, bench_sum_max_dot_product) {
+    if (!bench) {
+        fprintf(stderr, "benchmarking disabled, run with 'bench' parameter to enable\n");
+        return;
+    }
+    for (CellType cell_type: {CellType::FLOAT, CellType::BFLOAT16, CellType::INT8}) {
+        benchmark(cell_type, 32, 128, 128);
+        benchmark(cell_type, 32, 512, 128);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+    const std::string bench_option = "bench";
+    if ((argc > 1) && (bench_option == argv[1])) {
+        bench = true;
+        ++argv;
+        --argc;
+    }
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -18,7 +18,10 @@
 // operation for reduce since those are the most optimized operations
 // across all implementations. When benchmarking different
 // implementations against each other, a smoke test is performed by
-// verifying that all implementations produce the same result.
+// verifying that all implementations produce the same result. The
+// average number of heap allocations (through operator new) needed
+// for each evaluation is also reported, to keep track of how well
+// intermediate values are kept inside the per-evaluation stash.
 
 #include <vespa/eval/eval/fast_value.h>
 #include <vespa/eval/eval/interpreted_function.h>
@@ -47,6 +50,9 @@
 #include <vespa/vespalib/util/stringfmt.h>
 #include <optional>
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
 
 using namespace vespalib;
 using namespace vespalib::eval;
@@ -55,6 +61,20 @@ using vespalib::make_string_short::fmt;
 
 using vespalib::slime::JsonFormat;
 
+//-----------------------------------------------------------------------------
+
+std::atomic<size_t> num_allocations(0);
+
+void *operator new(size_t size) {
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
 using Instruction = InterpretedFunction::Instruction;
 using EvalSingle = InterpretedFunction::EvalSingle;
 
@@ -428,6 +448,16 @@ struct EvalOp {
         }
         return timer.min_time() * 1000.0 * 1000.0 / double(loop_cnt);
     }
+    double count_allocations() {
+        constexpr size_t loop_cnt = 16;
+        single.eval(stack); // warm up the stash
+        size_t before = num_allocations.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < loop_cnt; ++i) {
+            single.eval(stack);
+        }
+        size_t after = num_allocations.load(std::memory_order_relaxed);
+        return double(after - before) / double(loop_cnt);
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -451,7 +481,8 @@ void benchmark(const std::string &desc, const std::vector<EvalOp::UP> &list) {
     size_t ref_idx = (list.size() > 1 ? 1u : 0u);
     for (const auto &eval: list) {
         double time = eval->estimate_cost_us(loop_cnt[eval->impl.order], loop_cnt[ref_idx]);
-        fprintf(stderr, "    %s(%s): %10.3f us\n", eval->impl.name.c_str(), eval->impl.short_name.c_str(), time);
+        double allocs = eval->count_allocations();
+        fprintf(stderr, "    %s(%s): %10.3f us, %8.2f allocs\n", eval->impl.name.c_str(), eval->impl.short_name.c_str(), time, allocs);
         result.sample(eval->impl.order, time);
     }
     result.normalize();
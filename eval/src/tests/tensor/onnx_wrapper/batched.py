@@ -0,0 +1,32 @@
+# Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+import onnx
+from onnx import helper, TensorProto
+
+IN1 = helper.make_tensor_value_info('in1', TensorProto.FLOAT, ['batch', 3])
+IN2 = helper.make_tensor_value_info('in2', TensorProto.FLOAT, ['batch', 3])
+PROD = helper.make_tensor_value_info('prod', TensorProto.FLOAT, ['batch', 3])
+OUT = helper.make_tensor_value_info('out', TensorProto.FLOAT, ['batch', 3])
+
+nodes = [
+    helper.make_node(
+        'Mul',
+        ['in1', 'in2'],
+        ['prod'],
+    ),
+    helper.make_node(
+        'Add',
+        ['prod', 'in1'],
+        ['out'],
+    ),
+]
+graph_def = helper.make_graph(
+    nodes,
+    'batched',
+    [
+        IN1,
+        IN2,
+    ],
+    [PROD, OUT],
+)
+model_def = helper.make_model(graph_def, producer_name='batched.py', opset_imports=[onnx.OperatorSetIdProto(version=12)])
+onnx.save(model_def, 'batched.onnx')
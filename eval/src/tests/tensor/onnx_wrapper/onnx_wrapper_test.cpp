@@ -30,6 +30,8 @@ std::string guess_batch_model = source_dir + "/guess_batch.onnx";
 std::string unstable_types_model = source_dir + "/unstable_types.onnx";
 std::string float_to_int8_model = source_dir + "/float_to_int8.onnx";
 std::string probe_model = source_dir + "/probe_model.onnx";
+std::string batched_model = source_dir + "/batched.onnx";
+std::string scalar_model = source_dir + "/scalar.onnx";
 
 void dump_info(const char *ctx, const std::vector<TensorInfo> &info) {
     fprintf(stderr, "%s:\n", ctx);
@@ -510,6 +512,64 @@ TEST(OnnxModelCacheTest, share_and_evict_onnx_models) {
     EXPECT_EQ(OnnxModelCache::count_refs(), 0);
 }
 
+TEST(OnnxTest, free_batch_dimension_is_detected) {
+    EXPECT_TRUE(Onnx(batched_model, Onnx::Optimize::DISABLE).has_free_batch_dimension());
+    EXPECT_FALSE(Onnx(simple_model, Onnx::Optimize::DISABLE).has_free_batch_dimension());
+    // 'attribute_tensor' has no batch dimension
+    EXPECT_FALSE(Onnx(dynamic_model, Onnx::Optimize::DISABLE).has_free_batch_dimension());
+    // different symbolic names for the first dimension
+    EXPECT_FALSE(Onnx(guess_batch_model, Onnx::Optimize::DISABLE).has_free_batch_dimension());
+    // scalar inputs and outputs have no dimensions at all
+    Onnx scalar(scalar_model, Onnx::Optimize::DISABLE);
+    ASSERT_EQ(scalar.inputs().size(), 2);
+    EXPECT_TRUE(scalar.inputs()[0].dimensions.empty());
+    EXPECT_FALSE(scalar.has_free_batch_dimension());
+}
+
+TEST(OnnxTest, batched_model_evaluation_gives_same_results_as_single_evaluation) {
+    Onnx model(batched_model, Onnx::Optimize::ENABLE);
+    ValueType in1_type = ValueType::from_spec("tensor<float>(a[1],b[3])");
+    ValueType in2_type = ValueType::from_spec("tensor<double>(a[1],b[3])");
+    Onnx::WirePlanner planner;
+    EXPECT_TRUE(planner.bind_input_type(in1_type, model.inputs()[0]));
+    EXPECT_TRUE(planner.bind_input_type(in2_type, model.inputs()[1]));
+    EXPECT_EQ(planner.make_output_type(model.outputs()[0]).to_spec(), "tensor<float>(d0[1],d1[3])");
+    EXPECT_EQ(planner.make_output_type(model.outputs()[1]).to_spec(), "tensor<float>(d0[1],d1[3])");
+    auto wire_info = planner.get_wire_info(model);
+    Onnx::EvalContext single(model, wire_info);
+    Onnx::BatchEvalContext batch(model, wire_info, 4);
+    EXPECT_EQ(batch.max_batch_size(), 4);
+    EXPECT_EQ(batch.num_params(), 2);
+    EXPECT_EQ(batch.num_results(), 2);
+    std::vector<std::vector<float>> in1_values;
+    std::vector<std::vector<double>> in2_values;
+    for (size_t i = 0; i < 4; ++i) {
+        in1_values.push_back({float(i + 1), float(i + 2), float(i + 3)});
+        in2_values.push_back({double(i), double(2 * i), double(3 * i)});
+    }
+    auto in1 = [&](size_t i) { return DenseValueView(in1_type, TypedCells(in1_values[i])); };
+    auto in2 = [&](size_t i) { return DenseValueView(in2_type, TypedCells(in2_values[i])); };
+    for (size_t batch_size: {3, 4, 1, 3}) {
+        for (size_t i = 0; i < batch_size; ++i) {
+            batch.bind_param(i, 0, in1(i));
+            batch.bind_param(i, 1, in2(i));
+        }
+        batch.eval(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            single.bind_param(0, in1(i));
+            single.bind_param(1, in2(i));
+            single.eval();
+            for (size_t r = 0; r < 2; ++r) {
+                EXPECT_EQ(TensorSpec::from_value(batch.get_result(i, r)),
+                          TensorSpec::from_value(single.get_result(r)));
+            }
+        }
+    }
+    // out = in1 * in2 + in1
+    EXPECT_EQ(TensorSpec::from_value(batch.get_result(2, 1)),
+              TensorSpec::from_expr("tensor<float>(d0[1],d1[3]):[[9,20,35]]"));
+}
+
 TensorSpec val(const std::string &expr) {
     auto result = TensorSpec::from_expr(expr);
     EXPECT_FALSE(ValueType::from_spec(result.type()).is_error());
@@ -2,13 +2,46 @@
 
 #include "fast_addr_map.h"
 #include <vespa/vespalib/stllike/hashtable.hpp>
+#include <algorithm>
+#include <numeric>
 
 namespace vespalib::eval {
 
 FastAddrMap::FastAddrMap(size_t num_mapped_dims, const StringIdVector &labels_in, size_t expected_subspaces)
     : _labels(num_mapped_dims, labels_in),
-      _map(expected_subspaces * 2, Hash(), Equal(_labels))
+      _map(expected_subspaces * 2, Hash(), Equal(_labels)),
+      _last_hash(0),
+      _in_label_order(true),
+      _sorted_index()
 {}
 FastAddrMap::~FastAddrMap() = default;
 
+void
+FastAddrMap::build_sorted_index()
+{
+    if ((addr_size() != 1) || has_sorted_labels()) {
+        return;
+    }
+    auto index = std::make_unique<SortedIndex>();
+    index->subspaces.resize(size());
+    std::iota(index->subspaces.begin(), index->subspaces.end(), 0);
+    const auto &my_labels = labels();
+    std::sort(index->subspaces.begin(), index->subspaces.end(),
+              [&my_labels](uint32_t a, uint32_t b) noexcept { return (my_labels[a].value() < my_labels[b].value()); });
+    index->labels.reserve(size());
+    for (uint32_t subspace: index->subspaces) {
+        index->labels.push_back(my_labels[subspace]);
+    }
+    _sorted_index = std::move(index);
+}
+
+MemoryUsage
+FastAddrMap::sorted_index_memory_usage() const
+{
+    MemoryUsage usage = self_memory_usage<SortedIndex>();
+    usage.merge(vector_extra_memory_usage(_sorted_index->labels));
+    usage.merge(vector_extra_memory_usage(_sorted_index->subspaces));
+    return usage;
+}
+
 }
@@ -6,7 +6,9 @@
 #include <vespa/vespalib/util/string_id.h>
 #include <vespa/vespalib/stllike/identity.h>
 #include <vespa/vespalib/stllike/hashtable.h>
+#include <memory>
 #include <span>
+#include <vector>
 
 namespace vespalib::eval {
 
@@ -15,6 +17,13 @@ namespace vespalib::eval {
  * labels (a sparse address) to an integer value (dense subspace
  * index). Labels are represented by string enum values stored and
  * handled outside this class.
+ *
+ * For maps with a single dimension, the labels can also be visited
+ * in increasing label (string id) order, enabling merge-based
+ * intersection of two maps instead of hash lookups. If the labels
+ * were added in increasing order (which is tracked while adding
+ * them) the subspace order itself is used; otherwise a separate
+ * sorted index must be built explicitly.
  **/
 class FastAddrMap
 {
@@ -99,9 +108,29 @@ public:
 
     using HashType = hashtable<Entry, Entry, Hash, Equal, Identity, hashtable_base::and_modulator>;
 
+    // labels of a single-dimension map in increasing label order,
+    // together with the subspace each of them maps to
+    struct SortedLabels {
+        std::span<const string_id> labels;
+        const uint32_t *subspaces; // nullptr: labels are in subspace order
+        size_t size() const noexcept { return labels.size(); }
+        uint32_t subspace(size_t i) const noexcept { return subspaces ? subspaces[i] : i; }
+    };
+
+    // merging is only faster than hash lookups when the sizes are comparable
+    static constexpr size_t max_merge_size_ratio = 8;
+
 private:
+    struct SortedIndex {
+        StringIdVector labels;
+        std::vector<uint32_t> subspaces;
+    };
+
     LabelView _labels;
     HashType _map;
+    uint32_t _last_hash;
+    bool _in_label_order;
+    std::unique_ptr<SortedIndex> _sorted_index;
 
 public:
     FastAddrMap(size_t num_mapped_dims, const StringIdVector &labels_in, size_t expected_subspaces);
@@ -135,8 +164,61 @@ public:
     }
     void add_mapping(uint32_t hash) {
         uint32_t idx = _map.size();
+        // the hash of a single label is the label itself
+        _in_label_order = _in_label_order && ((idx == 0) || (hash > _last_hash));
+        _last_hash = hash;
+        if (__builtin_expect(bool(_sorted_index), false)) {
+            _sorted_index.reset();
+        }
         _map.force_insert(Entry{{idx}, hash});
     }
+    // remove all mappings, keeping the allocated memory for re-use;
+    // the referenced labels are expected to be replaced as well
+    void clear() {
+        _map.clear();
+        _last_hash = 0;
+        _in_label_order = true;
+        _sorted_index.reset();
+    }
+    bool has_sorted_labels() const noexcept {
+        return (addr_size() == 1) && (_in_label_order || _sorted_index);
+    }
+    // only valid if has_sorted_labels() is true
+    SortedLabels sorted_labels() const noexcept {
+        if (_in_label_order) {
+            return {{labels().data(), size()}, nullptr};
+        }
+        return {_sorted_index->labels, _sorted_index->subspaces.data()};
+    }
+    MemoryUsage sorted_index_memory_usage() const;
+    // make has_sorted_labels() true for single-dimension maps
+    void build_sorted_index();
+    // should two maps be intersected by merging their sorted labels?
+    static bool use_merge(const FastAddrMap &a, const FastAddrMap &b) noexcept {
+        size_t small = std::min(a.size(), b.size());
+        size_t big = std::max(a.size(), b.size());
+        return (big <= (small * max_merge_size_ratio)) && a.has_sorted_labels() && b.has_sorted_labels();
+    }
+    // call f(a_subspace, b_subspace) for each label found in both, in increasing label order
+    template <typename F>
+    static void each_common_label(const SortedLabels &a, const SortedLabels &b, F &&f) {
+        const string_id *a_labels = a.labels.data();
+        const string_id *b_labels = b.labels.data();
+        size_t a_size = a.size();
+        size_t b_size = b.size();
+        size_t i = 0;
+        size_t j = 0;
+        while ((i < a_size) && (j < b_size)) {
+            uint32_t a_label = a_labels[i].value();
+            uint32_t b_label = b_labels[j].value();
+            if (a_label == b_label) {
+                f(a.subspace(i), b.subspace(j));
+            }
+            // advance without branching on which side is behind
+            i += (a_label <= b_label);
+            j += (b_label <= a_label);
+        }
+    }
     template <typename F>
     void each_map_entry(F &&f) const {
         _map.for_each([&](const auto &entry)
@@ -154,6 +236,9 @@ public:
         map_allocated = std::min(map_allocated, map_allocated - map_self_size);
         extra_usage.incUsedBytes(map_used);
         extra_usage.incAllocatedBytes(map_allocated);
+        if (_sorted_index) {
+            extra_usage.merge(sorted_index_memory_usage());
+        }
         return extra_usage;
     }
 };
@@ -25,6 +25,21 @@ struct CreateFastValueBuilderBase {
     }
 };
 
+struct CreateFastStashedValueBuilderBase {
+    template <typename T> static ValueBuilderBase *invoke(const ValueType &type, size_t num_mapped_dims,
+            size_t subspace_size, size_t expected_subspaces, Stash &stash)
+    {
+        assert(check_cell_type<T>(type.cell_type()));
+        if (type.is_double()) {
+            return &stash.create<FastDoubleValueBuilder>();
+        } else if (num_mapped_dims == 0) {
+            return &stash.create<FastStashedDenseValueBuilder<T>>(type, subspace_size, stash);
+        } else {
+            return &stash.create<FastValue<T,true>>(type, num_mapped_dims, subspace_size, expected_subspaces, stash);
+        }
+    }
+};
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 
@@ -175,6 +190,23 @@ FastValueBuilderFactory::create_value_builder_base(const ValueType &type, bool t
     return typify_invoke<2,MyTypify,CreateFastValueBuilderBase>(type.cell_type(), transient, type, num_mapped_dims, subspace_size, expected_subspaces);
 }
 
+ValueBuilderBase *
+FastValueBuilderFactory::create_stashed_value_builder_base(const ValueType &type, size_t num_mapped_dims, size_t subspace_size,
+                                                           size_t expected_subspaces, Stash &stash) const
+{
+    return typify_invoke<1,TypifyCellType,CreateFastStashedValueBuilderBase>(type.cell_type(), type, num_mapped_dims, subspace_size,
+                                                                            expected_subspaces, stash);
+}
+
 //-----------------------------------------------------------------------------
 
+void
+add_sorted_label_index(Value &value)
+{
+    if (is_fast(value.index())) {
+        // the index is owned by the value, which is not shared yet
+        const_cast<FastValueIndex &>(as_fast(value.index())).map.build_sorted_index();
+    }
+}
+
 }
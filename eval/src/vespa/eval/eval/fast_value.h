@@ -21,8 +21,21 @@ private:
     static FastValueBuilderFactory _factory;
     std::unique_ptr<ValueBuilderBase> create_value_builder_base(const ValueType &type, bool transient,
             size_t num_mapped_dims, size_t subspace_size, size_t expected_subspaces) const override;
+    ValueBuilderBase *create_stashed_value_builder_base(const ValueType &type, size_t num_mapped_dims,
+            size_t subspace_size, size_t expected_subspaces, Stash &stash) const override;
 public:
     static const FastValueBuilderFactory &get() { return _factory; }
 };
 
+/**
+ * Make sure a value with a single mapped dimension built by the
+ * FastValueBuilderFactory can visit its labels in sorted order,
+ * enabling merge-based sparse joins and dot products against other
+ * such values. This is useful for long-lived values (like query
+ * tensors) that take part in many operations. Values whose labels
+ * were added in increasing order need no extra index. The value must
+ * not be shared with other threads while this is called.
+ **/
+void add_sorted_label_index(Value &value);
+
 }
@@ -36,7 +36,10 @@ struct FastCells {
     size_t capacity;
     size_t size;
     mutable alloc::Alloc memory;
+    Stash *stash; // if set, cells are allocated here instead of in 'memory'
+    T *data;
     explicit FastCells(size_t initial_capacity);
+    FastCells(size_t initial_capacity, Stash &stash_in);
     FastCells(const FastCells &) = delete;
     FastCells & operator = (const FastCells &) = delete;
     ~FastCells();
@@ -47,7 +50,7 @@ struct FastCells {
     }
     void reallocate(size_t need);
     constexpr T *get(size_t offset) const {
-        return reinterpret_cast<T*>(memory.get()) + offset;
+        return data + offset;
     }
     void push_back_fast(T value) {
         *get(size++) = value;
@@ -70,7 +73,21 @@ template <typename T>
 FastCells<T>::FastCells(size_t initial_capacity)
     : capacity(roundUp2inN(initial_capacity)),
       size(0),
-      memory(alloc::Alloc::alloc(elem_size * capacity))
+      memory(alloc::Alloc::alloc(elem_size * capacity)),
+      stash(nullptr),
+      data(reinterpret_cast<T*>(memory.get()))
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(can_skip_destruction<T>);
+}
+
+template <typename T>
+FastCells<T>::FastCells(size_t initial_capacity, Stash &stash_in)
+    : capacity(roundUp2inN(initial_capacity)),
+      size(0),
+      memory(),
+      stash(&stash_in),
+      data(stash_in.create_uninitialized_array<T>(capacity).data())
 {
     static_assert(std::is_trivially_copyable_v<T>);
     static_assert(can_skip_destruction<T>);
@@ -80,11 +97,19 @@ template <typename T>
 void
 FastCells<T>::reallocate(size_t need) {
     capacity = roundUp2inN(size + need);
+    if (stash != nullptr) {
+        // old cells are left in the stash until it is reset
+        T *new_data = stash->create_uninitialized_array<T>(capacity).data();
+        memcpy(new_data, data, elem_size * size);
+        data = new_data;
+        return;
+    }
     alloc::Alloc new_memory = alloc::Alloc::alloc(elem_size * capacity);
     if (memory.get()) {
         memcpy(new_memory.get(), memory.get(), elem_size * size);
     }
     memory = std::move(new_memory);
+    data = reinterpret_cast<T*>(memory.get());
 }
 
 template <typename T>
@@ -108,6 +133,9 @@ struct FastValue final : Value, ValueBuilder<T> {
     FastCells<T> my_cells;
 
     FastValue(const ValueType &type_in, size_t num_mapped_dims_in, size_t subspace_size_in, size_t expected_subspaces_in);
+    // cells are allocated in the stash, which must also own the value itself
+    FastValue(const ValueType &type_in, size_t num_mapped_dims_in, size_t subspace_size_in, size_t expected_subspaces_in,
+              Stash &stash);
     ~FastValue() override;
     const ValueType &type() const override { return my_type; }
     const Value::Index &index() const override { return my_index; }
@@ -118,7 +146,7 @@ struct FastValue final : Value, ValueBuilder<T> {
             // not called
             abort();
         } else {
-            return TypedCells(my_cells.memory.get(), get_cell_type<T>(), my_cells.size);
+            return TypedCells(my_cells.get(0), get_cell_type<T>(), my_cells.size);
         }
     }
     void add_mapping(std::span<const std::string_view> addr) {
@@ -182,6 +210,13 @@ struct FastValue final : Value, ValueBuilder<T> {
         self.release();
         return std::unique_ptr<Value>(this);
     }
+    const Value &build_stashed(Stash &) override {
+        if (my_index.map.addr_size() == 0) {
+            assert(my_index.map.size() == 1);
+        }
+        assert(my_cells.size == (my_index.map.size() * my_subspace_size));
+        return *this;
+    }
     MemoryUsage get_memory_usage() const override {
         MemoryUsage usage = self_memory_usage<FastValue<T,transient>>();
         usage.merge(vector_extra_memory_usage(my_type.dimensions()));
@@ -203,6 +238,17 @@ FastValue<T,transient>::FastValue(const ValueType &type_in, size_t num_mapped_di
     my_handles.reserve(expected_subspaces_in * num_mapped_dims_in);
 }
 
+template <typename T,bool transient>
+FastValue<T,transient>::FastValue(const ValueType &type_in, size_t num_mapped_dims_in,
+                                  size_t subspace_size_in, size_t expected_subspaces_in, Stash &stash)
+    : my_type(type_in), my_subspace_size(subspace_size_in),
+      my_handles(),
+      my_index(num_mapped_dims_in, get_view(my_handles), expected_subspaces_in),
+      my_cells(subspace_size_in * expected_subspaces_in, stash)
+{
+    my_handles.reserve(expected_subspaces_in * num_mapped_dims_in);
+}
+
 template <typename T,bool transient>
 FastValue<T,transient>::~FastValue() = default;
 
@@ -222,7 +268,7 @@ struct FastDenseValue final : Value, ValueBuilder<T> {
     ~FastDenseValue() override;
     const ValueType &type() const override { return my_type; }
     const Value::Index &index() const override { return TrivialIndex::get(); }
-    TypedCells cells() const override { return TypedCells(my_cells.memory.get(), get_cell_type<T>(), my_cells.size); }
+    TypedCells cells() const override { return TypedCells(my_cells.get(0), get_cell_type<T>(), my_cells.size); }
     std::span<T> add_subspace(std::span<const std::string_view>) override {
         return std::span<T>(my_cells.get(0), my_cells.size);
     }
@@ -245,11 +291,37 @@ template <typename T> FastDenseValue<T>::~FastDenseValue() = default;
 
 //-----------------------------------------------------------------------------
 
+// Builds a dense value where both the cells and the value (a view of
+// the cells) live in a stash. Used for transient values created
+// during evaluation.
+template <typename T>
+struct FastStashedDenseValueBuilder final : ValueBuilder<T> {
+
+    const ValueType &my_type;
+    std::span<T> my_cells;
+
+    FastStashedDenseValueBuilder(const ValueType &type_in, size_t subspace_size_in, Stash &stash)
+        : my_type(type_in), my_cells(stash.create_uninitialized_array<T>(subspace_size_in)) {}
+    ~FastStashedDenseValueBuilder() override;
+    std::span<T> add_subspace(std::span<const std::string_view>) override { return my_cells; }
+    std::span<T> add_subspace(std::span<const string_id>) override { return my_cells; }
+    std::unique_ptr<Value> build(std::unique_ptr<ValueBuilder<T>>) override {
+        abort(); // owned by a stash; use build_stashed
+    }
+    const Value &build_stashed(Stash &stash) override {
+        return stash.create<DenseValueView>(my_type, TypedCells(my_cells.data(), get_cell_type<T>(), my_cells.size()));
+    }
+};
+template <typename T> FastStashedDenseValueBuilder<T>::~FastStashedDenseValueBuilder() = default;
+
+//-----------------------------------------------------------------------------
+
 struct FastDoubleValueBuilder final : ValueBuilder<double> {
     double _value;
     std::span<double> add_subspace(std::span<const std::string_view>) final override { return std::span<double>(&_value, 1); }
     std::span<double> add_subspace(std::span<const string_id>) final override { return std::span<double>(&_value, 1); };
     std::unique_ptr<Value> build(std::unique_ptr<ValueBuilder<double>>) final override { return std::make_unique<DoubleValue>(_value); }
+    const Value &build_stashed(Stash &stash) final override { return stash.create<DoubleValue>(_value); }
 };
 
 //-----------------------------------------------------------------------------
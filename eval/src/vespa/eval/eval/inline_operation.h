@@ -3,6 +3,8 @@
 #pragma once
 
 #include "operation.h"
+#include "int8float.h"
+#include <vespa/vespalib/hwaccelerated/iaccelerated.h>
 #include <vespa/vespalib/util/typify.h>
 #include <cblas.h>
 #include <cmath>
@@ -174,6 +176,16 @@ struct DotProduct<double,double> {
     }
 };
 
+// int8 cells are multiplied and accumulated as integers (exact)
+template <>
+struct DotProduct<Int8Float,Int8Float> {
+    static double apply(const Int8Float * lhs, const Int8Float * rhs, size_t count) {
+        static const auto &hw = hwaccelerated::IAccelerated::getAccelerator();
+        static_assert(sizeof(Int8Float) == sizeof(int8_t));
+        return hw.dotProduct(reinterpret_cast<const int8_t *>(lhs), reinterpret_cast<const int8_t *>(rhs), count);
+    }
+};
+
 //-----------------------------------------------------------------------------
 
 }
@@ -52,7 +52,8 @@ InterpretedFunction::State::State(const ValueBuilderFactory &factory_in)
       stash(),
       stack(),
       program_offset(0),
-      if_cnt(0)
+      if_cnt(0),
+      thread_bundle(nullptr)
 {
 }
 
@@ -61,7 +62,7 @@ InterpretedFunction::State::~State() = default;
 void
 InterpretedFunction::State::init(const LazyParams &params_in) {
     params = &params_in;
-    stash.clear();
+    stash.reset();
     stack.clear();
     program_offset = 0;
     if_cnt = 0;
@@ -193,7 +194,7 @@ InterpretedFunction::EvalSingle::EvalSingle(const ValueBuilderFactory &factory,
 const Value &
 InterpretedFunction::EvalSingle::eval(const std::vector<Value::CREF> &stack)
 {
-    _state.stash.clear();
+    _state.stash.reset();
     _state.stack = stack;
     _op.perform(_state);
     assert(_state.stack.size() == 1);
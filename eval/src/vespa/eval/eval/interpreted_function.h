@@ -9,6 +9,8 @@
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/time.h>
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace vespalib::eval {
 
 namespace nodes { struct Node; }
@@ -25,7 +27,10 @@ struct ValueBuilderFactory;
  * run-time state related to the evaluation of an interpreted
  * function. The result of an evaluation is only valid until either
  * the context is destructed or the context is re-used to perform
- * another evaluation.
+ * another evaluation. Intermediate values are allocated in a stash
+ * owned by the context. It is reset (but keeps its memory) when the
+ * next evaluation starts, so repeated evaluations using the same
+ * context will normally not need to allocate any memory for them.
  **/
 class InterpretedFunction
 {
@@ -37,6 +42,8 @@ public:
         std::vector<Value::CREF>   stack;
         uint32_t                   program_offset;
         uint32_t                   if_cnt;
+        // optional; used to split large tensor operations into parts
+        ThreadBundle              *thread_bundle;
 
         State(const ValueBuilderFactory &factory_in);
         ~State();
@@ -69,6 +76,9 @@ public:
     public:
         explicit Context(const InterpretedFunction &ifun);
         uint32_t if_cnt() const { return _state.if_cnt; }
+        // The thread bundle must be idle while the function is
+        // evaluated, and kept alive until it is detached (nullptr).
+        void set_thread_bundle(ThreadBundle *bundle) { _state.thread_bundle = bundle; }
     };
     struct ProfiledContext {
         Context context;
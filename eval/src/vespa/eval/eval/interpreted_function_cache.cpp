@@ -0,0 +1,69 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "interpreted_function_cache.h"
+#include "node_types.h"
+#include <cassert>
+
+namespace vespalib::eval {
+
+namespace {
+
+std::string make_key(const std::string &expression, const std::vector<ValueType> &param_types) {
+    std::string key = expression;
+    for (const auto &type: param_types) {
+        key.push_back('\n');
+        key.append(type.to_spec());
+    }
+    return key;
+}
+
+}
+
+std::mutex InterpretedFunctionCache::_lock{};
+InterpretedFunctionCache::Map InterpretedFunctionCache::_cached{};
+
+void
+InterpretedFunctionCache::release(Map::iterator entry)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (--(entry->second.num_refs) == 0) {
+        _cached.erase(entry);
+    }
+}
+
+InterpretedFunctionCache::Token::UP
+InterpretedFunctionCache::create(const ValueBuilderFactory &factory, const std::string &expression,
+                                 const Function &function, const std::vector<ValueType> &param_types)
+{
+    Key key(&factory, make_key(expression, param_types));
+    std::lock_guard<std::mutex> guard(_lock);
+    auto pos = _cached.find(key);
+    if (pos == _cached.end()) {
+        NodeTypes node_types(function, param_types);
+        auto interpreted = std::make_unique<InterpretedFunction>(factory, function, node_types);
+        auto res = _cached.emplace(std::move(key), std::move(interpreted));
+        assert(res.second);
+        pos = res.first;
+    }
+    return std::make_unique<Token>(pos, ctor_tag());
+}
+
+size_t
+InterpretedFunctionCache::num_cached()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _cached.size();
+}
+
+size_t
+InterpretedFunctionCache::count_refs()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    size_t refs = 0;
+    for (const auto &entry: _cached) {
+        refs += entry.second.num_refs;
+    }
+    return refs;
+}
+
+}
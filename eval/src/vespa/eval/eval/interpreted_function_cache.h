@@ -0,0 +1,65 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "interpreted_function.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace vespalib::eval {
+
+/**
+ * Cache used to share interpreted functions between users (typically
+ * the same ranking expression set up by multiple rank profiles, or by
+ * consecutive config generations). Functions are keyed on the
+ * expression they were parsed from together with the types of their
+ * parameters and the value builder factory used. The cache itself
+ * will not keep anything alive, but will let you find functions that
+ * are currently in use by others.
+ **/
+class InterpretedFunctionCache
+{
+private:
+    struct ctor_tag {};
+    using Key = std::pair<const ValueBuilderFactory *, std::string>;
+    struct Value {
+        size_t num_refs;
+        std::unique_ptr<InterpretedFunction> function;
+        Value(std::unique_ptr<InterpretedFunction> function_in) : num_refs(0), function(std::move(function_in)) {}
+        const InterpretedFunction &get() { return *function; }
+    };
+    using Map = std::map<Key,Value>;
+    static std::mutex _lock;
+    static Map _cached;
+
+    static void release(Map::iterator entry);
+
+public:
+    class Token
+    {
+    private:
+        InterpretedFunctionCache::Map::iterator _entry;
+    public:
+        Token(Token &&) = delete;
+        Token(const Token &) = delete;
+        Token &operator=(Token &&) = delete;
+        Token &operator=(const Token &) = delete;
+        using UP = std::unique_ptr<Token>;
+        explicit Token(InterpretedFunctionCache::Map::iterator entry, ctor_tag) : _entry(entry) {
+            ++_entry->second.num_refs;
+        }
+        const InterpretedFunction &get() const { return _entry->second.get(); }
+        ~Token() { InterpretedFunctionCache::release(_entry); }
+    };
+
+    // 'function' must be the result of parsing 'expression'
+    static Token::UP create(const ValueBuilderFactory &factory, const std::string &expression,
+                            const Function &function, const std::vector<ValueType> &param_types);
+    static size_t num_cached();
+    static size_t count_refs();
+};
+
+}
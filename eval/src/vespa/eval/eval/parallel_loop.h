@@ -0,0 +1,58 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/runnable.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <algorithm>
+#include <vector>
+
+namespace vespalib::eval {
+
+// This file contains a helper used to split the outermost loop of
+// large tensor operations into disjoint ranges that are performed in
+// parallel by an (optional) thread bundle. The callable is invoked
+// with the [begin, end) range of outer iterations it should handle,
+// and must only write output belonging to that range. Operations
+// with too little work to make it worthwhile to wake up other
+// threads are performed directly in the calling thread.
+
+namespace parallel_loop {
+
+// minimal amount of work (typically cells visited) for each part
+constexpr size_t min_work_per_part = 64 * 1024;
+
+inline size_t num_parts(const ThreadBundle *bundle, size_t outer_cnt, size_t work) {
+    if (bundle == nullptr) {
+        return 1;
+    }
+    return std::max(size_t(1), std::min({bundle->size(), outer_cnt, work / min_work_per_part}));
+}
+
+template <typename F>
+struct Part : Runnable {
+    const F &f;
+    size_t begin;
+    size_t end;
+    Part(const F &f_in, size_t begin_in, size_t end_in) noexcept
+      : f(f_in), begin(begin_in), end(end_in) {}
+    void run() override { f(begin, end); }
+};
+
+} // namespace parallel_loop
+
+template <typename F>
+void run_parallel_loop(ThreadBundle *bundle, size_t outer_cnt, size_t work, const F &f) {
+    size_t parts = parallel_loop::num_parts(bundle, outer_cnt, work);
+    if (parts == 1) {
+        return f(size_t(0), outer_cnt);
+    }
+    std::vector<parallel_loop::Part<F>> list;
+    list.reserve(parts);
+    for (size_t i = 0; i < parts; ++i) {
+        list.emplace_back(f, (i * outer_cnt) / parts, ((i + 1) * outer_cnt) / parts);
+    }
+    bundle->run(list);
+}
+
+} // namespace vespalib::eval
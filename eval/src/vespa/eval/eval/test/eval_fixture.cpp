@@ -198,6 +198,14 @@ EvalFixture::num_params() const
     return _param_values.size();
 }
 
+TensorSpec
+EvalFixture::eval_with_thread_bundle(ThreadBundle &thread_bundle) const
+{
+    InterpretedFunction::Context ctx(_ifun);
+    ctx.set_thread_bundle(&thread_bundle);
+    return spec_from_value(_ifun.eval(ctx, _params));
+}
+
 TensorSpec
 EvalFixture::ref(const std::string &expr, const ParamRepo &param_repo)
 {
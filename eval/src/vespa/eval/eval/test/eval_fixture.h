@@ -122,6 +122,9 @@ public:
     const Value &param_value(size_t idx) const { return *(_param_values[idx]); }
     const TensorSpec &result() const { return _result; }
     size_t num_params() const;
+    // evaluate again (in a separate context) letting large operations
+    // be split across the given thread bundle
+    TensorSpec eval_with_thread_bundle(ThreadBundle &thread_bundle) const;
     static TensorSpec ref(const std::string &expr, const ParamRepo &param_repo);
     static TensorSpec prod(const std::string &expr, const ParamRepo &param_repo) {
         return EvalFixture(FastValueBuilderFactory::get(), expr, param_repo, true, false).result();
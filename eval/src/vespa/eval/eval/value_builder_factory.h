@@ -3,6 +3,8 @@
 #pragma once
 
 #include "value.h"
+#include <vespa/vespalib/util/stash.h>
+#include <cstdlib>
 
 namespace vespalib::eval {
 
@@ -40,6 +42,43 @@ struct ValueBuilder : ValueBuilderBase {
     // created value. This means that builders can only be used once,
     // it also means values can build themselves.
     virtual std::unique_ptr<Value> build(std::unique_ptr<ValueBuilder> self) = 0;
+
+    // Produce the newly created value from a builder owned by a
+    // stash (see ValueBuilderFactory::create_stashed_value_builder).
+    // The value will be owned by the same stash.
+    virtual const Value &build_stashed(Stash &stash);
+};
+
+template <typename T>
+const Value &
+ValueBuilder<T>::build_stashed(Stash &)
+{
+    abort(); // only builders created in a stash can build into it
+}
+
+/**
+ * Makes a heap allocated value builder owned by a stash. Used for
+ * factories that are not able to create value builders in a stash
+ * directly.
+ **/
+template <typename T>
+struct StashedValueBuilderAdapter final : ValueBuilder<T> {
+    std::unique_ptr<ValueBuilder<T>> builder;
+    explicit StashedValueBuilderAdapter(std::unique_ptr<ValueBuilder<T>> builder_in) noexcept
+      : builder(std::move(builder_in)) {}
+    ~StashedValueBuilderAdapter() override = default;
+    std::span<T> add_subspace(std::span<const std::string_view> addr) override {
+        return builder->add_subspace(addr);
+    }
+    std::span<T> add_subspace(std::span<const string_id> addr) override {
+        return builder->add_subspace(addr);
+    }
+    std::unique_ptr<Value> build(std::unique_ptr<ValueBuilder<T>>) override {
+        abort(); // owned by a stash; use build_stashed
+    }
+    const Value &build_stashed(Stash &stash) override {
+        return *stash.create<std::unique_ptr<Value>>(builder->build(std::move(builder)));
+    }
 };
 
 /**
@@ -81,11 +120,34 @@ public:
     {
         return create_value_builder<T>(type, false, type.count_mapped_dimensions(), type.dense_subspace_size(), 1);
     }
+    // Create a transient value builder owned by the given stash. The
+    // value is obtained by calling build_stashed with the same stash
+    // and is owned by the stash as well. This is intended for
+    // intermediate values created during evaluation, where the stash
+    // is reset between evaluations; factories able to do so will
+    // place as much as possible of the value inside the stash instead
+    // of allocating it on the heap. Note that the value type must be
+    // kept alive for as long as the value is used.
+    template <typename T>
+    ValueBuilder<T> &create_stashed_value_builder(const ValueType &type, size_t num_mapped_dims_in,
+            size_t subspace_size_in, size_t expected_subspaces, Stash &stash) const
+    {
+        assert(check_cell_type<T>(type.cell_type()));
+        if (auto *base = create_stashed_value_builder_base(type, num_mapped_dims_in, subspace_size_in, expected_subspaces, stash)) {
+            return *static_cast<ValueBuilder<T>*>(base);
+        }
+        return stash.create<StashedValueBuilderAdapter<T>>(
+                create_transient_value_builder<T>(type, num_mapped_dims_in, subspace_size_in, expected_subspaces));
+    }
     std::unique_ptr<Value> copy(const Value &value) const;
     virtual ~ValueBuilderFactory() = default;
 protected:
     virtual std::unique_ptr<ValueBuilderBase> create_value_builder_base(const ValueType &type, bool transient,
             size_t num_mapped_dims_in, size_t subspace_size_in, size_t expected_subspaces) const = 0;
+    // returns nullptr if builders cannot be created in a stash
+    virtual ValueBuilderBase *create_stashed_value_builder_base(const ValueType &, size_t, size_t, size_t, Stash &) const {
+        return nullptr;
+    }
 };
 
 }
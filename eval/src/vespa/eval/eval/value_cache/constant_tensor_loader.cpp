@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "constant_tensor_loader.h"
+#include "mapped_constant_value.h"
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/vespalib/data/lz4_input_decoder.h>
@@ -279,6 +280,15 @@ ConstantTensorLoader::create(const std::string &path, const std::string &type) c
         LOG(warning, "invalid type specification: %s", type.c_str());
         return std::make_unique<BadConstantValue>();
     }
+    if (path.ends_with(".mtf")) {
+        auto mapped = MappedConstantValue::load(path);
+        if (!mapped->type().is_error() && (mapped->type() != value_type)) {
+            LOG(warning, "mapped tensor file '%s' has type '%s', expected '%s'", path.c_str(),
+                mapped->type().to_spec().c_str(), type.c_str());
+            return std::make_unique<BadConstantValue>();
+        }
+        return mapped;
+    }
     if (path.ends_with(".tbf")) {
         vespalib::MappedFileInput file(path);
         vespalib::Memory content = file.get();
@@ -12,7 +12,9 @@ struct ValueBuilderFactory;
 /**
  * A ConstantValueFactory that will load constant tensor values from
  * file. The file is expected to be in json format with the same
- * structure used when feeding.
+ * structure used when feeding, in binary tensor format ('.tbf'), or
+ * to be a memory mappable dense tensor ('.mtf', see
+ * MappedConstantValue).
  **/
 class ConstantTensorLoader : public ConstantValueFactory
 {
@@ -0,0 +1,94 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mapped_constant_value.h"
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/fastos/file.h>
+#include <sys/mman.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.eval.value_cache.mapped_constant_value");
+
+namespace vespalib::eval {
+
+namespace {
+
+const std::string tensor_type_tag("tensorType");
+const std::string num_cells_tag("numCells");
+
+}
+
+MappedConstantValue::MappedConstantValue(std::unique_ptr<MappedFileInput> file, ValueType type, TypedCells cells)
+    : _file(std::move(file)),
+      _type(std::move(type)),
+      _value(_type, cells)
+{
+}
+
+MappedConstantValue::~MappedConstantValue() = default;
+
+ConstantValue::UP
+MappedConstantValue::load(const std::string &path)
+{
+    auto file = std::make_unique<MappedFileInput>(path);
+    if (!file->valid()) {
+        LOG(warning, "could not map file: %s", path.c_str());
+        return std::make_unique<BadConstantValue>();
+    }
+    Memory content = file->get();
+    DataBuffer header_buf(content.data, content.size);
+    GenericHeader::BufferReader reader(header_buf);
+    FileHeader header(header_alignment);
+    size_t header_size = 0;
+    try {
+        header_size = header.read(reader);
+    } catch (const IllegalHeaderException &e) {
+        LOG(warning, "bad header in mapped tensor file '%s': %s", path.c_str(), e.what());
+        return std::make_unique<BadConstantValue>();
+    }
+    if (!header.hasTag(tensor_type_tag) || !header.hasTag(num_cells_tag)) {
+        LOG(warning, "missing tensor type or cell count in mapped tensor file: %s", path.c_str());
+        return std::make_unique<BadConstantValue>();
+    }
+    auto type = ValueType::from_spec(header.getTag(tensor_type_tag).asString());
+    size_t num_cells = header.getTag(num_cells_tag).asInteger();
+    if (!type.is_dense() || (type.dense_subspace_size() != num_cells)) {
+        LOG(warning, "mapped tensor file '%s' does not contain a dense tensor", path.c_str());
+        return std::make_unique<BadConstantValue>();
+    }
+    size_t cells_size = num_cells * CellTypeUtils::mem_size(type.cell_type(), 1);
+    if ((header_size + cells_size) > content.size) {
+        LOG(warning, "mapped tensor file '%s' is truncated", path.c_str());
+        return std::make_unique<BadConstantValue>();
+    }
+    const char *cells = content.data + header_size;
+    // cells are looked up in arbitrary order, override the sequential access advice of the file
+    madvise(const_cast<char *>(content.data), content.size, MADV_NORMAL);
+    TypedCells typed_cells(cells, type.cell_type(), num_cells);
+    return std::make_unique<MappedConstantValue>(std::move(file), std::move(type), typed_cells);
+}
+
+bool
+MappedConstantValue::save(const std::string &path, const Value &value)
+{
+    const auto &type = value.type();
+    if (!type.is_dense()) {
+        LOG(warning, "only dense tensors can be saved as mapped tensor files, got '%s'", type.to_spec().c_str());
+        return false;
+    }
+    TypedCells cells = value.cells();
+    FileHeader header(header_alignment);
+    header.putTag(FileHeader::Tag(tensor_type_tag, type.to_spec()));
+    header.putTag(FileHeader::Tag(num_cells_tag, uint64_t(cells.size)));
+    FastOS_File file;
+    if (!file.OpenWriteOnlyTruncate(path.c_str())) {
+        LOG(warning, "could not open mapped tensor file for writing: %s", path.c_str());
+        return false;
+    }
+    header.writeFile(file);
+    bool ok = file.CheckedWrite(cells.data, CellTypeUtils::mem_size(cells.type, cells.size));
+    ok = file.Close() && ok;
+    return ok;
+}
+
+}
@@ -0,0 +1,45 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "constant_value.h"
+#include <vespa/vespalib/io/mapped_file_input.h>
+#include <memory>
+#include <string>
+
+namespace vespalib::eval {
+
+/**
+ * A constant dense tensor whose cells are memory mapped directly
+ * from a file, avoiding both decoding and heap allocation of large
+ * constants (like embedding tables). Since the cells live in the page
+ * cache, they are also shared by all users of the same file, even
+ * across config generations.
+ *
+ * The file starts with a vespalib::FileHeader aligned to the page
+ * size, containing the tensor type ('tensorType') and the number of
+ * cells ('numCells'), followed by the cells in host byte order.
+ * Files are expected to have the '.mtf' suffix.
+ **/
+class MappedConstantValue : public ConstantValue
+{
+private:
+    std::unique_ptr<MappedFileInput> _file;
+    ValueType                        _type;
+    DenseValueView                   _value;
+
+public:
+    MappedConstantValue(std::unique_ptr<MappedFileInput> file, ValueType type, TypedCells cells);
+    static constexpr size_t header_alignment = 4096;
+    ~MappedConstantValue() override;
+    const ValueType &type() const override { return _type; }
+    const Value &value() const override { return _value; }
+
+    // returns a BadConstantValue if the file could not be mapped
+    static ConstantValue::UP load(const std::string &path);
+
+    // write a dense value in the format understood by load
+    static bool save(const std::string &path, const Value &value);
+};
+
+}
@@ -25,6 +25,12 @@ struct UseDotProduct {
     }
 };
 
+struct UseInt8DotProduct {
+    static float calc(const Int8Float *pri, const Int8Float *sec, size_t size) {
+        return DotProduct<Int8Float,Int8Float>::apply(pri, sec, size);
+    }
+};
+
 struct UseHammingDist {
     static float calc(const Int8Float *pri, const Int8Float *sec, size_t size) {
         return binary_hamming_distance(pri, sec, size);
@@ -151,6 +157,9 @@ struct SelectFun {
         if ((best_aggr == Aggr::MAX) && (join_fun == Mul::f) && (cell_types == CellType::FLOAT)) {
             return my_best_similarity_op<R1::value, float, aggr::Max<float>, UseDotProduct>;
         }
+        if ((best_aggr == Aggr::MAX) && (join_fun == Mul::f) && (cell_types == CellType::INT8)) {
+            return my_best_similarity_op<R1::value, Int8Float, aggr::Max<float>, UseInt8DotProduct>;
+        }
         if ((best_aggr == Aggr::MIN) && (join_fun == Hamming::f) && (cell_types == CellType::INT8)) {
             return my_best_similarity_op<R1::value, Int8Float, aggr::Min<float>, UseHammingDist>;
         }
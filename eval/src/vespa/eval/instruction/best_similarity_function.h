@@ -11,6 +11,8 @@ namespace vespalib::eval {
  * to find the best one. This function supports the following cases:
  *
  * - maximum dot product of vectors with float cell type (MaxSim)
+ * - maximum dot product of vectors with int8 cell type (MaxSim on
+ *   quantized vectors, accumulated as integers)
  * - minimum hamming distance of bitvectors with int8 cell type
  *
  * The vectors used to calculate the individual distance metrics must
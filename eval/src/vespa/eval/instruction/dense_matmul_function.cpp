@@ -4,6 +4,7 @@
 #include <vespa/vespalib/objects/objectvisitor.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/parallel_loop.h>
 #include <cassert>
 #include <cblas.h>
 
@@ -25,23 +26,36 @@ OCT my_dot_product(const LCT *lhs, const RCT *rhs, size_t lhs_size, size_t commo
     return result;
 }
 
+// distance between the start of adjacent lhs rows
+size_t lhs_row_offset(const DenseMatMulFunction::Self &self, bool lhs_common_inner) {
+    return (lhs_common_inner ? self.common_size : 1);
+}
+
+// number of multiply-adds; used to decide whether to split rows across threads
+size_t matmul_work(const DenseMatMulFunction::Self &self) {
+    return (self.lhs_size * self.common_size * self.rhs_size);
+}
+
 template <typename LCT, typename RCT, typename OCT, bool lhs_common_inner, bool rhs_common_inner>
 void my_matmul_op(InterpretedFunction::State &state, uint64_t param) {
     const DenseMatMulFunction::Self &self = unwrap_param<DenseMatMulFunction::Self>(param);
     auto lhs_cells = state.peek(1).cells().typify<LCT>();
     auto rhs_cells = state.peek(0).cells().typify<RCT>();
     auto dst_cells = state.stash.create_uninitialized_array<OCT>(self.lhs_size * self.rhs_size);
-    OCT *dst = dst_cells.data();
-    const LCT *lhs = lhs_cells.data();
-    for (size_t i = 0; i < self.lhs_size; ++i) {
-        const RCT *rhs = rhs_cells.data();
-        for (size_t j = 0; j < self.rhs_size; ++j) {
-            *dst++ = my_dot_product<LCT,RCT,OCT,lhs_common_inner,rhs_common_inner>(lhs, rhs,
-                                                                                   self.lhs_size, self.common_size, self.rhs_size);
-            rhs += (rhs_common_inner ? self.common_size : 1);
+    auto matmul_rows = [&](size_t begin, size_t end) {
+        OCT *dst = dst_cells.data() + (begin * self.rhs_size);
+        const LCT *lhs = lhs_cells.data() + (begin * lhs_row_offset(self, lhs_common_inner));
+        for (size_t i = begin; i < end; ++i) {
+            const RCT *rhs = rhs_cells.data();
+            for (size_t j = 0; j < self.rhs_size; ++j) {
+                *dst++ = my_dot_product<LCT,RCT,OCT,lhs_common_inner,rhs_common_inner>(lhs, rhs,
+                                                                                       self.lhs_size, self.common_size, self.rhs_size);
+                rhs += (rhs_common_inner ? self.common_size : 1);
+            }
+            lhs += lhs_row_offset(self, lhs_common_inner);
         }
-        lhs += (lhs_common_inner ? self.common_size : 1);
-    }
+    };
+    run_parallel_loop(state.thread_bundle, self.lhs_size, matmul_work(self), matmul_rows);
     state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
 }
 
@@ -51,11 +65,14 @@ void my_cblas_double_matmul_op(InterpretedFunction::State &state, uint64_t param
     auto lhs_cells = state.peek(1).cells().typify<double>();
     auto rhs_cells = state.peek(0).cells().typify<double>();
     auto dst_cells = state.stash.create_array<double>(self.lhs_size * self.rhs_size);
-    cblas_dgemm(CblasRowMajor, lhs_common_inner ? CblasNoTrans : CblasTrans, rhs_common_inner ? CblasTrans : CblasNoTrans,
-                self.lhs_size, self.rhs_size, self.common_size, 1.0,
-                lhs_cells.data(), lhs_common_inner ? self.common_size : self.lhs_size,
-                rhs_cells.data(), rhs_common_inner ? self.common_size : self.rhs_size,
-                0.0, dst_cells.data(), self.rhs_size);
+    auto matmul_rows = [&](size_t begin, size_t end) {
+        cblas_dgemm(CblasRowMajor, lhs_common_inner ? CblasNoTrans : CblasTrans, rhs_common_inner ? CblasTrans : CblasNoTrans,
+                    end - begin, self.rhs_size, self.common_size, 1.0,
+                    lhs_cells.data() + (begin * lhs_row_offset(self, lhs_common_inner)), lhs_common_inner ? self.common_size : self.lhs_size,
+                    rhs_cells.data(), rhs_common_inner ? self.common_size : self.rhs_size,
+                    0.0, dst_cells.data() + (begin * self.rhs_size), self.rhs_size);
+    };
+    run_parallel_loop(state.thread_bundle, self.lhs_size, matmul_work(self), matmul_rows);
     state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
 }
 
@@ -65,11 +82,14 @@ void my_cblas_float_matmul_op(InterpretedFunction::State &state, uint64_t param)
     auto lhs_cells = state.peek(1).cells().typify<float>();
     auto rhs_cells = state.peek(0).cells().typify<float>();
     auto dst_cells = state.stash.create_array<float>(self.lhs_size * self.rhs_size);
-    cblas_sgemm(CblasRowMajor, lhs_common_inner ? CblasNoTrans : CblasTrans, rhs_common_inner ? CblasTrans : CblasNoTrans,
-                self.lhs_size, self.rhs_size, self.common_size, 1.0,
-                lhs_cells.data(), lhs_common_inner ? self.common_size : self.lhs_size,
-                rhs_cells.data(), rhs_common_inner ? self.common_size : self.rhs_size,
-                0.0, dst_cells.data(), self.rhs_size);
+    auto matmul_rows = [&](size_t begin, size_t end) {
+        cblas_sgemm(CblasRowMajor, lhs_common_inner ? CblasNoTrans : CblasTrans, rhs_common_inner ? CblasTrans : CblasNoTrans,
+                    end - begin, self.rhs_size, self.common_size, 1.0,
+                    lhs_cells.data() + (begin * lhs_row_offset(self, lhs_common_inner)), lhs_common_inner ? self.common_size : self.lhs_size,
+                    rhs_cells.data(), rhs_common_inner ? self.common_size : self.rhs_size,
+                    0.0, dst_cells.data() + (begin * self.rhs_size), self.rhs_size);
+    };
+    run_parallel_loop(state.thread_bundle, self.lhs_size, matmul_work(self), matmul_rows);
     state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
 }
 
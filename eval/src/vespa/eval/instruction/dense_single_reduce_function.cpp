@@ -3,6 +3,7 @@
 #include "dense_single_reduce_function.h"
 #include <vespa/vespalib/util/typify.h>
 #include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/parallel_loop.h>
 #include <cassert>
 #include <array>
 
@@ -66,10 +67,10 @@ auto reduce_cells_atleast_8(const ICT *src, size_t n, size_t stride) {
 }
 
 template <typename ICT, typename OCT, typename AGGR, bool atleast_8, bool is_inner>
-void trace_reduce_impl(const Params &params, const ICT *src, OCT *dst) {
+void trace_reduce_impl(const Params &params, size_t outer_size, const ICT *src, OCT *dst) {
     constexpr bool aggr_is_complex = is_complex(AGGR::enum_value());
     const size_t block_size = (params.reduce_size * params.inner_size);
-    for (size_t outer = 0; outer < params.outer_size; ++outer) {
+    for (size_t outer = 0; outer < outer_size; ++outer) {
         for (size_t inner = 0; inner < params.inner_size; ++inner) {
             if (atleast_8 && !aggr_is_complex) {
                 if (is_inner) {
@@ -86,8 +87,8 @@ void trace_reduce_impl(const Params &params, const ICT *src, OCT *dst) {
 }
 
 template <typename ICT, typename OCT, typename AGGR>
-void fold_reduce_impl(const Params &params, const ICT *src, OCT *dst) {
-    for (size_t outer = 0; outer < params.outer_size; ++outer) {
+void fold_reduce_impl(const Params &params, size_t outer_size, const ICT *src, OCT *dst) {
+    for (size_t outer = 0; outer < outer_size; ++outer) {
         auto saved_dst = dst;
         for (size_t inner = 0; inner < params.inner_size; ++inner) {
             *dst++ = *src++;
@@ -110,11 +111,15 @@ void my_single_reduce_op(InterpretedFunction::State &state, uint64_t param) {
     const ICT *src = state.peek(0).cells().typify<ICT>().data();
     auto dst_cells = state.stash.create_uninitialized_array<OCT>(params.outer_size * params.inner_size);
     OCT *dst = dst_cells.data();
-    if constexpr (aggr_is_simple && !is_inner) {
-        fold_reduce_impl<ICT, OCT, AGGR>(params, src, dst);
-    } else {
-        trace_reduce_impl<ICT, OCT, AGGR, atleast_8, is_inner>(params, src, dst);
-    }
+    const size_t block_size = (params.reduce_size * params.inner_size);
+    auto reduce_range = [&](size_t begin, size_t end) {
+        if constexpr (aggr_is_simple && !is_inner) {
+            fold_reduce_impl<ICT, OCT, AGGR>(params, end - begin, src + begin * block_size, dst + begin * params.inner_size);
+        } else {
+            trace_reduce_impl<ICT, OCT, AGGR, atleast_8, is_inner>(params, end - begin, src + begin * block_size, dst + begin * params.inner_size);
+        }
+    };
+    run_parallel_loop(state.thread_bundle, params.outer_size, params.outer_size * block_size, reduce_range);
     state.pop_push(state.stash.create<DenseValueView>(params.result_type, TypedCells(dst_cells)));
 }
 
@@ -3,7 +3,7 @@
 #include "dense_xw_product_function.h"
 #include <vespa/vespalib/objects/objectvisitor.h>
 #include <vespa/eval/eval/value.h>
-#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/inline_operation.h>
 #include <cassert>
 
 #include <cblas.h>
@@ -17,13 +17,25 @@ namespace {
 
 template <typename LCT, typename RCT, typename OCT, bool common_inner>
 OCT my_dot_product(const LCT *lhs, const RCT *rhs, size_t vector_size, size_t result_size) {
-    OCT result = 0.0;
-    for (size_t i = 0; i < vector_size; ++i) {
-        result += ((*lhs) * (*rhs));
-        ++lhs;
-        rhs += (common_inner ? 1 : result_size);
+    if constexpr (std::is_same_v<LCT,Int8Float> && std::is_same_v<RCT,Int8Float> && common_inner) {
+        return DotProduct<Int8Float,Int8Float>::apply(lhs, rhs, vector_size);
+    } else if constexpr (std::is_same_v<LCT,Int8Float> && std::is_same_v<RCT,Int8Float>) {
+        int64_t result = 0;
+        for (size_t i = 0; i < vector_size; ++i) {
+            result += int32_t(lhs->get_bits()) * int32_t(rhs->get_bits());
+            ++lhs;
+            rhs += result_size;
+        }
+        return result;
+    } else {
+        OCT result = 0.0;
+        for (size_t i = 0; i < vector_size; ++i) {
+            result += ((*lhs) * (*rhs));
+            ++lhs;
+            rhs += (common_inner ? 1 : result_size);
+        }
+        return result;
     }
-    return result;
 }
 
 template <typename LCT, typename RCT, typename OCT, bool common_inner>
@@ -39,26 +39,28 @@ struct ConcatParam
 };
 
 template <typename LCT, typename RCT, typename OCT>
-std::unique_ptr<Value>
+const Value &
 generic_concat(const Value &a, const Value &b,
                const SparseJoinPlan &sparse_plan,
                const DenseConcatPlan &dense_plan,
-               const ValueType &res_type, const ValueBuilderFactory &factory)
+               const ValueType &res_type, const ValueBuilderFactory &factory,
+               Stash &stash)
 {
     auto a_cells = a.cells().typify<LCT>();
     auto b_cells = b.cells().typify<RCT>();
     SparseJoinState sparse(sparse_plan, a.index(), b.index());
-    auto builder = factory.create_transient_value_builder<OCT>(res_type,
-                                                               sparse_plan.sources.size(),
-                                                               dense_plan.output_size,
-                                                               sparse.first_index.size());
+    auto &builder = factory.create_stashed_value_builder<OCT>(res_type,
+                                                              sparse_plan.sources.size(),
+                                                              dense_plan.output_size,
+                                                              sparse.first_index.size(),
+                                                              stash);
     auto outer = sparse.first_index.create_view({});
     auto inner = sparse.second_index.create_view(sparse.second_view_dims);
     outer->lookup({});
     while (outer->next_result(sparse.first_address, sparse.first_subspace)) {
         inner->lookup(sparse.address_overlap);
         while (inner->next_result(sparse.second_only_address, sparse.second_subspace)) {
-            OCT *dst = builder->add_subspace(sparse.full_address).data();
+            OCT *dst = builder.add_subspace(sparse.full_address).data();
             {
                 size_t left_input_offset = dense_plan.left.input_size * sparse.lhs_subspace;
                 auto copy_left = [&](size_t in_idx, size_t out_idx) { dst[out_idx] = a_cells[in_idx]; };
@@ -71,7 +73,7 @@ generic_concat(const Value &a, const Value &b,
             }
         }
     }
-    return builder->build(std::move(builder));
+    return builder.build_stashed(stash);
 }
 
 template <typename LCT, typename RCT, typename OCT>
@@ -79,13 +81,11 @@ void my_generic_concat_op(State &state, uint64_t param_in) {
     const auto &param = unwrap_param<ConcatParam>(param_in);
     const Value &lhs = state.peek(1);
     const Value &rhs = state.peek(0);
-    auto res_value = generic_concat<LCT, RCT, OCT>(
+    const Value &result = generic_concat<LCT, RCT, OCT>(
             lhs, rhs,
             param.sparse_plan, param.dense_plan,
-            param.res_type, param.factory);
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(res_value));
-    const Value &result_ref = *(result.get());
-    state.pop_pop_push(result_ref);
+            param.res_type, param.factory, state.stash);
+    state.pop_pop_push(result);
 }
 
 template <typename LCT, typename RCT, typename OCT, bool forward_lhs>
@@ -2,6 +2,7 @@
 
 #include "generic_join.h"
 #include <vespa/eval/eval/inline_operation.h>
+#include <vespa/eval/eval/parallel_loop.h>
 #include <vespa/eval/eval/wrap_param.h>
 #include <vespa/eval/eval/value_builder_factory.h>
 #include <vespa/vespalib/util/overload.h>
@@ -21,8 +22,8 @@ using Instruction = InterpretedFunction::Instruction;
 //-----------------------------------------------------------------------------
 
 template <typename LCT, typename RCT, typename OCT, typename Fun>
-Value::UP
-generic_mixed_join(const Value &lhs, const Value &rhs, const JoinParam &param)
+const Value &
+generic_mixed_join(const Value &lhs, const Value &rhs, const JoinParam &param, Stash &stash)
 {
     Fun fun(param.function);
     auto dense_join = [&](const LCT *my_lhs, const RCT *my_rhs, OCT *my_res)
@@ -38,7 +39,7 @@ generic_mixed_join(const Value &lhs, const Value &rhs, const JoinParam &param)
     if (param.sparse_plan.lhs_overlap.empty() && param.sparse_plan.rhs_overlap.empty()) {
         expected_subspaces = expected_subspaces * sparse.second_index.size();
     }
-    auto builder = param.factory.create_transient_value_builder<OCT>(param.res_type, param.sparse_plan.sources.size(), param.dense_plan.out_size, expected_subspaces);
+    auto &builder = param.factory.create_stashed_value_builder<OCT>(param.res_type, param.sparse_plan.sources.size(), param.dense_plan.out_size, expected_subspaces, stash);
     auto outer = sparse.first_index.create_view({});
     auto inner = sparse.second_index.create_view(sparse.second_view_dims);
     outer->lookup({});
@@ -47,10 +48,10 @@ generic_mixed_join(const Value &lhs, const Value &rhs, const JoinParam &param)
         while (inner->next_result(sparse.second_only_address, sparse.second_subspace)) {
             dense_join(lhs_cells.data() + param.dense_plan.lhs_size * sparse.lhs_subspace,
                        rhs_cells.data() + param.dense_plan.rhs_size * sparse.rhs_subspace,
-                       builder->add_subspace(sparse.full_address).data());
+                       builder.add_subspace(sparse.full_address).data());
         }
     }
-    return builder->build(std::move(builder));
+    return builder.build_stashed(stash);
 }
 
 namespace {
@@ -60,10 +61,7 @@ void my_mixed_join_op(State &state, uint64_t param_in) {
     const auto &param = unwrap_param<JoinParam>(param_in);
     const Value &lhs = state.peek(1);
     const Value &rhs = state.peek(0);
-    auto up = generic_mixed_join<LCT, RCT, OCT, Fun>(lhs, rhs, param);
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(up));
-    const Value &result_ref = *(result.get());
-    state.pop_pop_push(result_ref);
+    state.pop_pop_push(generic_mixed_join<LCT, RCT, OCT, Fun>(lhs, rhs, param, state.stash));
 }
 
 //-----------------------------------------------------------------------------
@@ -102,13 +100,18 @@ void my_mixed_dense_join_op(State &state, uint64_t param_in) {
 template <typename LCT, typename RCT, typename OCT, typename Fun>
 void my_dense_join_op(State &state, uint64_t param_in) {
     const auto &param = unwrap_param<JoinParam>(param_in);
-    Fun fun(param.function);
     auto lhs_cells = state.peek(1).cells().typify<LCT>();
     auto rhs_cells = state.peek(0).cells().typify<RCT>();
     std::span<OCT> out_cells = state.stash.create_uninitialized_array<OCT>(param.dense_plan.out_size);
-    OCT *dst = out_cells.data();
-    auto join_cells = [&](size_t lhs_idx, size_t rhs_idx) { *dst++ = fun(lhs_cells[lhs_idx], rhs_cells[rhs_idx]); };
-    param.dense_plan.execute(0, 0, join_cells);
+    size_t outer_cnt = param.dense_plan.outer_cnt();
+    size_t outer_size = param.dense_plan.out_size / outer_cnt;
+    auto join_range = [&](size_t begin, size_t end) {
+        Fun fun(param.function);
+        OCT *dst = out_cells.data() + (begin * outer_size);
+        auto join_cells = [&](size_t lhs_idx, size_t rhs_idx) { *dst++ = fun(lhs_cells[lhs_idx], rhs_cells[rhs_idx]); };
+        param.dense_plan.execute_outer_range(begin, end, join_cells);
+    };
+    run_parallel_loop(state.thread_bundle, outer_cnt, param.dense_plan.out_size, join_range);
     state.pop_pop_push(state.stash.create<DenseValueView>(param.res_type, TypedCells(out_cells)));
 }
 
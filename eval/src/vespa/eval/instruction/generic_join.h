@@ -19,8 +19,9 @@ using join_fun_t = operation::op2_t;
 
 struct JoinParam;
 
+// the result is owned by the stash
 template <typename LCT, typename RCT, typename OCT, typename Fun>
-Value::UP generic_mixed_join(const Value &lhs, const Value &rhs, const JoinParam &param);
+const Value &generic_mixed_join(const Value &lhs, const Value &rhs, const JoinParam &param, Stash &stash);
 
 struct GenericJoin {
     static InterpretedFunction::Instruction
@@ -50,6 +51,17 @@ struct DenseJoinPlan {
     template <typename F> void execute(size_t lhs, size_t rhs, const F &f) const {
         run_nested_loop(lhs, rhs, loop_cnt, lhs_stride, rhs_stride, f);
     }
+    // number of iterations of the outermost loop
+    size_t outer_cnt() const { return loop_cnt.empty() ? 1 : loop_cnt[0]; }
+    // only perform iterations [begin, end) of the outermost loop
+    template <typename F> void execute_outer_range(size_t begin, size_t end, const F &f) const {
+        if (loop_cnt.empty()) {
+            return f(size_t(0), size_t(0));
+        }
+        SmallVector<size_t> range_cnt(loop_cnt);
+        range_cnt[0] = (end - begin);
+        run_nested_loop(begin * lhs_stride[0], begin * rhs_stride[0], range_cnt, lhs_stride, rhs_stride, f);
+    }
 };
 
 /**
@@ -20,9 +20,9 @@ MergeParam::~MergeParam() = default;
 //-----------------------------------------------------------------------------
 
 template <typename LCT, typename RCT, typename OCT, typename Fun>
-std::unique_ptr<Value>
+const Value &
 generic_mixed_merge(const Value &a, const Value &b,
-                    const MergeParam &params)
+                    const MergeParam &params, Stash &stash)
 {
     Fun fun(params.function);
     auto lhs_cells = a.cells().typify<LCT>();
@@ -30,7 +30,7 @@ generic_mixed_merge(const Value &a, const Value &b,
     const size_t num_mapped = params.num_mapped_dimensions;
     const size_t subspace_size = params.dense_subspace_size;
     size_t guess_subspaces = std::max(a.index().size(), b.index().size());
-    auto builder = params.factory.create_transient_value_builder<OCT>(params.res_type, num_mapped, subspace_size, guess_subspaces);
+    auto &builder = params.factory.create_stashed_value_builder<OCT>(params.res_type, num_mapped, subspace_size, guess_subspaces, stash);
     SmallVector<string_id> address(num_mapped);
     SmallVector<const string_id *> addr_cref;
     SmallVector<string_id *> addr_ref;
@@ -44,7 +44,7 @@ generic_mixed_merge(const Value &a, const Value &b,
     auto outer = a.index().create_view({});
     outer->lookup({});
     while (outer->next_result(addr_ref, lhs_subspace)) {
-        OCT *dst = builder->add_subspace(address).data();
+        OCT *dst = builder.add_subspace(address).data();
         inner->lookup(addr_cref);
         if (inner->next_result({}, rhs_subspace)) {
             const LCT *lhs_src = &lhs_cells[lhs_subspace * subspace_size];
@@ -65,14 +65,14 @@ generic_mixed_merge(const Value &a, const Value &b,
     while (outer->next_result(addr_ref, rhs_subspace)) {
         inner->lookup(addr_cref);
         if (! inner->next_result({}, lhs_subspace)) {
-            OCT *dst = builder->add_subspace(address).data();
+            OCT *dst = builder.add_subspace(address).data();
             const RCT *src = &rhs_cells[rhs_subspace * subspace_size];
             for (size_t i = 0; i < subspace_size; ++i) {
                 *dst++ = *src++;
             }
         }
     }
-    return builder->build(std::move(builder));
+    return builder.build_stashed(stash);
 }
 
 
@@ -83,10 +83,7 @@ void my_mixed_merge_op(State &state, uint64_t param_in) {
     const auto &param = unwrap_param<MergeParam>(param_in);
     const Value &lhs = state.peek(1);
     const Value &rhs = state.peek(0);
-    auto up = generic_mixed_merge<LCT, RCT, OCT, Fun>(lhs, rhs, param);
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(up));
-    const Value &result_ref = *(result.get());
-    state.pop_pop_push(result_ref);
+    state.pop_pop_push(generic_mixed_merge<LCT, RCT, OCT, Fun>(lhs, rhs, param, state.stash));
 };
 
 struct SelectGenericMergeOp {
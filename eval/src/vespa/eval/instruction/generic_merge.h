@@ -35,10 +35,11 @@ struct MergeParam {
     ~MergeParam();
 };
 
+// the result is owned by the stash
 template <typename LCT, typename RCT, typename OCT, typename Fun>
-std::unique_ptr<Value>
+const Value &
 generic_mixed_merge(const Value &a, const Value &b,
-                    const MergeParam &params);
+                    const MergeParam &params, Stash &stash);
 
 struct GenericMerge {
     static InterpretedFunction::Instruction
@@ -291,20 +291,22 @@ struct PeekParam {
 };
 
 template <typename ICT, typename OCT, typename Getter>
-Value::UP
+const Value &
 generic_mixed_peek(const ValueType &res_type,
                    const Value &input_value,
                    const SparsePlan &sparse_plan,
                    const DensePlan &dense_plan,
                    const ValueBuilderFactory &factory,
-                   const Getter &get_child_value)
+                   const Getter &get_child_value,
+                   Stash &stash)
 {
     auto input_cells = input_value.cells().typify<ICT>();
     size_t bad_guess = 1;
-    auto builder = factory.create_transient_value_builder<OCT>(res_type,
-                                                               sparse_plan.out_mapped_dims,
-                                                               dense_plan.out_dense_size,
-                                                               bad_guess);
+    auto &builder = factory.create_stashed_value_builder<OCT>(res_type,
+                                                              sparse_plan.out_mapped_dims,
+                                                              dense_plan.out_dense_size,
+                                                              bad_guess,
+                                                              stash);
     size_t filled_subspaces = 0;
     size_t dense_offset = dense_plan.get_offset(get_child_value);
     if (dense_offset != npos) {
@@ -313,7 +315,7 @@ generic_mixed_peek(const ValueType &res_type,
         view->lookup(state.lookup_refs);
         size_t input_subspace;
         while (view->next_result(state.fetch_addr, input_subspace)) {
-            auto dst = builder->add_subspace(state.output_addr).begin();
+            auto dst = builder.add_subspace(state.output_addr).begin();
             auto input_offset = input_subspace * dense_plan.in_dense_size;
             dense_plan.execute(dense_offset + input_offset,
                                [&](size_t idx) { *dst++ = input_cells[idx]; });
@@ -321,11 +323,11 @@ generic_mixed_peek(const ValueType &res_type,
         }
     }
     if ((sparse_plan.out_mapped_dims == 0) && (filled_subspaces == 0)) {
-        for (auto & v : builder->add_subspace()) {
+        for (auto & v : builder.add_subspace()) {
             v = OCT{};
         }
     }
-    return builder->build(std::move(builder));
+    return builder.build_stashed(stash);
 }
 
 template <typename ICT, typename OCT>
@@ -338,10 +340,10 @@ void my_generic_peek_op(State &state, uint64_t param_in) {
         size_t stack_idx = last_valid_stack_idx - child_idx;
         return int64_t(state.peek(stack_idx).as_double());
     };
-    auto up = generic_mixed_peek<ICT,OCT>(param.res_type, input_value,
-                                          param.sparse_plan, param.dense_plan,
-                                          param.factory, get_child_value);
-    const Value &result = *state.stash.create<Value::UP>(std::move(up));
+    const Value &result = generic_mixed_peek<ICT,OCT>(param.res_type, input_value,
+                                                      param.sparse_plan, param.dense_plan,
+                                                      param.factory, get_child_value,
+                                                      state.stash);
     // num_children includes the "input" param
     state.pop_n_push(param.num_children, result);
 }
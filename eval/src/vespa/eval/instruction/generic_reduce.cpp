@@ -4,6 +4,7 @@
 #include <vespa/eval/eval/value_builder_factory.h>
 #include <vespa/eval/eval/wrap_param.h>
 #include <vespa/eval/eval/array_array_map.h>
+#include <vespa/eval/eval/parallel_loop.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/typify.h>
 #include <vespa/vespalib/util/overload.h>
@@ -68,8 +69,8 @@ struct SparseReduceState {
 SparseReduceState::~SparseReduceState() = default;
 
 template <typename ICT, typename OCT, typename AGGR>
-Value::UP
-generic_reduce(const Value &value, const ReduceParam &param) {
+const Value &
+generic_reduce(const Value &value, const ReduceParam &param, Stash &stash) {
     auto cells = value.cells().typify<ICT>();
     ArrayArrayMap<string_id,AGGR> map(param.sparse_plan.keep_dims.size(),
                                       param.dense_plan.out_size,
@@ -84,30 +85,26 @@ generic_reduce(const Value &value, const ReduceParam &param) {
         auto sample = [&](size_t src_idx, size_t dst_idx) { dst[dst_idx].sample(cells[src_idx]); };
         param.dense_plan.execute(sparse.subspace * param.dense_plan.in_size, sample);
     }
-    auto builder = param.factory.create_transient_value_builder<OCT>(param.res_type, param.sparse_plan.keep_dims.size(), param.dense_plan.out_size, map.size());
+    auto &builder = param.factory.create_stashed_value_builder<OCT>(param.res_type, param.sparse_plan.keep_dims.size(), param.dense_plan.out_size, map.size(), stash);
     map.each_entry([&](const auto &keys, const auto &values)
                    {
-                       OCT *dst = builder->add_subspace(keys).data();
+                       OCT *dst = builder.add_subspace(keys).data();
                        for (const AGGR &aggr: values) {
                            *dst++ = aggr.result();
                        }
                    });
     if ((map.size() == 0) && param.sparse_plan.keep_dims.empty()) {
-        auto zero = builder->add_subspace();
+        auto zero = builder.add_subspace();
         std::fill(zero.begin(), zero.end(), OCT{});
     }
-    auto & builder_ref = *builder;
-    return builder_ref.build(std::move(builder));
+    return builder.build_stashed(stash);
 }
 
 template <typename ICT, typename OCT, typename AGGR>
 void my_generic_reduce_op(State &state, uint64_t param_in) {
     const auto &param = unwrap_param<ReduceParam>(param_in);
     const Value &value = state.peek(0);
-    auto up = generic_reduce<ICT, OCT, AGGR>(value, param);
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(up));
-    const Value &result_ref = *(result.get());
-    state.pop_push(result_ref);
+    state.pop_push(generic_reduce<ICT, OCT, AGGR>(value, param, state.stash));
 }
 
 template <typename ICT, typename OCT, typename AGGR, bool forward_index>
@@ -119,25 +116,37 @@ void my_generic_dense_reduce_op(State &state, uint64_t param_in) {
     size_t num_subspaces = index.size();
     size_t out_cells_size = forward_index ? (param.dense_plan.out_size * num_subspaces) : param.dense_plan.out_size;
     auto out_cells = state.stash.create_uninitialized_array<OCT>(out_cells_size);
+    // a single dense subspace may be split over its outermost kept dimension
+    bool split_outer = (!forward_index && (num_subspaces == 1) && param.dense_plan.can_split_outer());
     if (num_subspaces > 0) {
         if constexpr (aggr::is_simple(AGGR::enum_value())) {
             OCT *dst = out_cells.data();
             std::fill(out_cells.begin(), out_cells.end(), AGGR::null_value());
             auto combine = [&](size_t src_idx, size_t dst_idx) { dst[dst_idx] = AGGR::combine(dst[dst_idx], cells[src_idx]); };
-            for (size_t i = 0; i < num_subspaces; ++i) {
-                param.dense_plan.execute(i * param.dense_plan.in_size, combine);
-                if (forward_index) {
-                    dst += param.dense_plan.out_size;
+            if (split_outer) {
+                run_parallel_loop(state.thread_bundle, param.dense_plan.loop_cnt[0], param.dense_plan.in_size,
+                                  [&](size_t begin, size_t end) { param.dense_plan.execute_outer_range(0, begin, end, combine); });
+            } else {
+                for (size_t i = 0; i < num_subspaces; ++i) {
+                    param.dense_plan.execute(i * param.dense_plan.in_size, combine);
+                    if (forward_index) {
+                        dst += param.dense_plan.out_size;
+                    }
                 }
             }
         } else {
             std::vector<AGGR> aggr_state(out_cells_size);
             AGGR *dst = &aggr_state[0];
             auto sample = [&](size_t src_idx, size_t dst_idx) { dst[dst_idx].sample(cells[src_idx]); };
-            for (size_t i = 0; i < num_subspaces; ++i) {
-                param.dense_plan.execute(i * param.dense_plan.in_size, sample);
-                if (forward_index) {
-                    dst += param.dense_plan.out_size;
+            if (split_outer) {
+                run_parallel_loop(state.thread_bundle, param.dense_plan.loop_cnt[0], param.dense_plan.in_size,
+                                  [&](size_t begin, size_t end) { param.dense_plan.execute_outer_range(0, begin, end, sample); });
+            } else {
+                for (size_t i = 0; i < num_subspaces; ++i) {
+                    param.dense_plan.execute(i * param.dense_plan.in_size, sample);
+                    if (forward_index) {
+                        dst += param.dense_plan.out_size;
+                    }
                 }
             }
             for (size_t i = 0; i < aggr_state.size(); ++i) {
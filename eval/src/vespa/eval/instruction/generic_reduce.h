@@ -26,6 +26,14 @@ struct DenseReducePlan {
     template <typename F> void execute(size_t in_idx, const F &f) const {
         run_nested_loop(in_idx, 0, loop_cnt, in_stride, out_stride, f);
     }
+    // true if the outermost loop writes to disjoint output cells
+    bool can_split_outer() const { return (!loop_cnt.empty() && (out_stride[0] != 0)); }
+    // only perform iterations [begin, end) of the outermost loop
+    template <typename F> void execute_outer_range(size_t in_idx, size_t begin, size_t end, const F &f) const {
+        SmallVector<size_t> range_cnt(loop_cnt);
+        range_cnt[0] = (end - begin);
+        run_nested_loop(in_idx + begin * in_stride[0], begin * out_stride[0], range_cnt, in_stride, out_stride, f);
+    }
 };
 
 struct SparseReducePlan {
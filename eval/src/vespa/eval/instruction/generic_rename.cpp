@@ -63,10 +63,11 @@ struct RenameParam {
 RenameParam::~RenameParam() = default;
 
 template <typename CT>
-std::unique_ptr<Value>
+const Value &
 generic_rename(const Value &a,
                const SparseRenamePlan &sparse_plan, const DenseRenamePlan &dense_plan,
-               const ValueType &res_type, const ValueBuilderFactory &factory)
+               const ValueType &res_type, const ValueBuilderFactory &factory,
+               Stash &stash)
 {
     auto cells = a.cells().typify<CT>();
     SmallVector<string_id> output_address(sparse_plan.mapped_dims);
@@ -74,31 +75,29 @@ generic_rename(const Value &a,
     for (size_t maps_to : sparse_plan.output_dimensions) {
         input_address.emplace_back(&output_address[maps_to]);
     }
-    auto builder = factory.create_transient_value_builder<CT>(res_type,
-                                                              sparse_plan.mapped_dims,
-                                                              dense_plan.subspace_size,
-                                                              a.index().size());
+    auto &builder = factory.create_stashed_value_builder<CT>(res_type,
+                                                             sparse_plan.mapped_dims,
+                                                             dense_plan.subspace_size,
+                                                             a.index().size(),
+                                                             stash);
     auto view = a.index().create_view({});
     view->lookup({});
     size_t subspace;
     while (view->next_result(input_address, subspace)) {
-        CT *dst = builder->add_subspace(output_address).data();
+        CT *dst = builder.add_subspace(output_address).data();
         size_t input_offset = dense_plan.subspace_size * subspace;
         auto copy_cells = [&](size_t input_idx) { *dst++ = cells[input_idx]; };
         dense_plan.execute(input_offset, copy_cells);
     }
-    return builder->build(std::move(builder));
+    return builder.build_stashed(stash);
 }
 
 template <typename CT>
 void my_generic_rename_op(State &state, uint64_t param_in) {
     const auto &param = unwrap_param<RenameParam>(param_in);
     const Value &a = state.peek(0);
-    auto res_value = generic_rename<CT>(a, param.sparse_plan, param.dense_plan,
-                                        param.res_type, param.factory);
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(res_value));
-    const Value &result_ref = *(result.get());
-    state.pop_push(result_ref);
+    state.pop_push(generic_rename<CT>(a, param.sparse_plan, param.dense_plan,
+                                      param.res_type, param.factory, state.stash));
 }
 
 template <typename CT>
@@ -45,6 +45,13 @@ double my_fast_sparse_dot_product(const FastAddrMap *small_map, const FastAddrMa
         std::swap(small_cells, big_cells);
     }
     if constexpr (single_dim) {
+        if (FastAddrMap::use_merge(*small_map, *big_map)) {
+            FastAddrMap::each_common_label(small_map->sorted_labels(), big_map->sorted_labels(),
+                                           [&](auto small_subspace, auto big_subspace) {
+                                               result += (small_cells[small_subspace] * big_cells[big_subspace]);
+                                           });
+            return result;
+        }
         const auto &labels = small_map->labels();
         for (size_t i = 0; i < labels.size(); ++i) {
             auto big_subspace = big_map->lookup_singledim(labels[i]);
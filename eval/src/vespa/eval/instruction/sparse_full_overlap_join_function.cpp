@@ -19,8 +19,19 @@ const Value &my_fast_sparse_full_overlap_join(const FastAddrMap &lhs_map, const
                                               const JoinParam &param, Stash &stash)
 {
     Fun fun(param.function);
-    auto &result = stash.create<FastValue<CT,true>>(param.res_type, lhs_map.addr_size(), 1, lhs_map.size());
+    auto &result = stash.create<FastValue<CT,true>>(param.res_type, lhs_map.addr_size(), 1, lhs_map.size(), stash);
     if constexpr (single_dim) {
+        if (FastAddrMap::use_merge(lhs_map, rhs_map)) {
+            // result labels are added in sorted order, keeping the result sorted
+            const auto &lhs_labels = lhs_map.labels();
+            FastAddrMap::each_common_label(lhs_map.sorted_labels(), rhs_map.sorted_labels(),
+                                           [&](auto lhs_subspace, auto rhs_subspace) {
+                                               result.add_singledim_mapping(lhs_labels[lhs_subspace]);
+                                               auto cell_value = fun(lhs_cells[lhs_subspace], rhs_cells[rhs_subspace]);
+                                               result.my_cells.push_back_fast(cell_value);
+                                           });
+            return result;
+        }
         const auto &labels = lhs_map.labels();
         for (size_t i = 0; i < labels.size(); ++i) {
             auto rhs_subspace = rhs_map.lookup_singledim(labels[i]);
@@ -66,8 +77,7 @@ void my_sparse_full_overlap_join_op(InterpretedFunction::State &state, uint64_t
                 lhs.cells().typify<CT>().data(), rhs.cells().typify<CT>().data(), param, state.stash);
         state.pop_pop_push(res);
     } else {
-        auto res = generic_mixed_join<CT,CT,CT,Fun>(lhs, rhs, param);
-        state.pop_pop_push(*state.stash.create<std::unique_ptr<Value>>(std::move(res)));
+        state.pop_pop_push(generic_mixed_join<CT,CT,CT,Fun>(lhs, rhs, param, state.stash));
     }
 }
 
@@ -21,7 +21,7 @@ const Value& my_fast_sparse_merge(const FastAddrMap &a_map, const FastAddrMap &b
 {
     Fun fun(params.function);
     size_t guess_size = a_map.size() + b_map.size();
-    auto &result = stash.create<FastValue<CT,true>>(params.res_type, params.num_mapped_dimensions, 1u, guess_size);
+    auto &result = stash.create<FastValue<CT,true>>(params.res_type, params.num_mapped_dimensions, 1u, guess_size, stash);
     if constexpr (single_dim) {
         string_id cur_label;
         std::span<const string_id> addr(&cur_label, 1);
@@ -81,8 +81,7 @@ void my_sparse_merge_op(InterpretedFunction::State &state, uint64_t param_in) {
                                                                  param, state.stash);
         state.pop_pop_push(v);
     } else {
-        auto up = generic_mixed_merge<CT,CT,CT,Fun>(a, b, param);
-        state.pop_pop_push(*state.stash.create<std::unique_ptr<Value>>(std::move(up)));
+        state.pop_pop_push(generic_mixed_merge<CT,CT,CT,Fun>(a, b, param, state.stash));
     }
 }
 
@@ -21,7 +21,7 @@ const Value &my_fast_no_overlap_sparse_join(const FastAddrMap &lhs_map, const Fa
     Fun fun(param.function);
     const auto &addr_sources = param.sparse_plan.sources;
     size_t num_mapped_dims = addr_sources.size();
-    auto &result = stash.create<FastValue<CT,true>>(param.res_type, num_mapped_dims, 1, lhs_map.size() * rhs_map.size());
+    auto &result = stash.create<FastValue<CT,true>>(param.res_type, num_mapped_dims, 1, lhs_map.size() * rhs_map.size(), stash);
     SmallVector<string_id> output_addr(num_mapped_dims);
     SmallVector<size_t> store_lhs_idx;
     SmallVector<size_t> store_rhs_idx;
@@ -72,8 +72,7 @@ void my_sparse_no_overlap_join_op(InterpretedFunction::State &state, uint64_t pa
                 lhs.cells().typify<CT>().data(), rhs.cells().typify<CT>().data(), param, state.stash);
         state.pop_pop_push(res);
     } else {
-        auto res = generic_mixed_join<CT,CT,CT,Fun>(lhs, rhs, param);
-        state.pop_pop_push(*state.stash.create<std::unique_ptr<Value>>(std::move(res)));
+        state.pop_pop_push(generic_mixed_join<CT,CT,CT,Fun>(lhs, rhs, param, state.stash));
     }
 }
 
@@ -3,6 +3,8 @@
 #include "sum_max_dot_product_function.h"
 #include <vespa/eval/eval/inline_operation.h>
 #include <vespa/eval/eval/value.h>
+#include <vespa/vespalib/hwaccelerated/iaccelerated.h>
+#include <algorithm>
 
 namespace vespalib::eval {
 
@@ -11,23 +13,78 @@ using namespace operation;
 
 namespace {
 
+static const auto &hw = hwaccelerated::IAccelerated::getAccelerator();
+
+// number of query vectors matched against each document vector while
+// it is hot in cache; the query block itself stays in cache while all
+// document vectors are streamed through
+constexpr size_t query_block_size = 8;
+
+std::span<const float> as_float_cells(std::span<const BFloat16> cells, Stash &stash) {
+    auto dst = stash.create_uninitialized_array<float>(cells.size());
+    hw.convert_bfloat16_to_float(reinterpret_cast<const uint16_t *>(cells.data()), dst.data(), cells.size());
+    return dst;
+}
+
+template <typename CT>
+double sum_max_dot_product(std::span<const CT> query_cells, std::span<const CT> document_cells, size_t dp_size) {
+    using dot_product = DotProduct<CT,CT>;
+    double result = 0.0;
+    float max_dp[query_block_size];
+    const CT *query_end = query_cells.data() + query_cells.size();
+    const CT *document_end = document_cells.data() + document_cells.size();
+    for (const CT *block = query_cells.data(); block < query_end; block += (query_block_size * dp_size)) {
+        size_t block_size = std::min(query_block_size, size_t(query_end - block) / dp_size);
+        std::fill_n(max_dp, block_size, aggr::Max<float>::null_value());
+        for (const CT *document = document_cells.data(); document < document_end; document += dp_size) {
+            const CT *query = block;
+            for (size_t i = 0; i < block_size; ++i, query += dp_size) {
+                max_dp[i] = aggr::Max<float>::combine(max_dp[i], dot_product::apply(query, document, dp_size));
+            }
+        }
+        for (size_t i = 0; i < block_size; ++i) {
+            result += max_dp[i];
+        }
+    }
+    return result;
+}
+
+template <typename CT>
 void my_sum_max_dot_product_op(InterpretedFunction::State &state, uint64_t dp_size) {
     double result = 0.0;
-    auto query_cells = state.peek(1).cells().typify<float>();
-    auto document_cells = state.peek(0).cells().typify<float>();
-    using dot_product = DotProduct<float,float>;
+    auto query_cells = state.peek(1).cells().typify<CT>();
+    auto document_cells = state.peek(0).cells().typify<CT>();
     if ((query_cells.size() > 0) && (document_cells.size() > 0)) {
-        for (const float *query = query_cells.data(); query < query_cells.data() + query_cells.size(); query += dp_size) {
-            float max_dp = aggr::Max<float>::null_value();
-            for (const float *document = document_cells.data(); document < document_cells.data() + document_cells.size(); document += dp_size) {
-                max_dp = aggr::Max<float>::combine(max_dp, dot_product::apply(query, document, dp_size));
-            }
-            result += max_dp;
+        if constexpr (std::is_same_v<CT, BFloat16>) {
+            result = sum_max_dot_product<float>(as_float_cells(query_cells, state.stash),
+                                                as_float_cells(document_cells, state.stash), dp_size);
+        } else {
+            result = sum_max_dot_product<CT>(query_cells, document_cells, dp_size);
         }
     }
     state.pop_pop_push(state.stash.create<DoubleValue>(result));
 }
 
+struct SelectOp {
+    template <typename CT>
+    static InterpretedFunction::op_function invoke() {
+        constexpr bool is_supported = (std::is_same_v<CT, float> ||
+                                       std::is_same_v<CT, BFloat16> ||
+                                       std::is_same_v<CT, Int8Float>);
+        if constexpr (is_supported) {
+            return my_sum_max_dot_product_op<CT>;
+        } else {
+            abort();
+        }
+    }
+};
+
+bool compatible_cell_types(CellType query, CellType document) {
+    return ((query == document) && ((query == CellType::FLOAT) ||
+                                    (query == CellType::BFLOAT16) ||
+                                    (query == CellType::INT8)));
+}
+
 const Reduce *check_reduce(const TensorFunction &expr, Aggr aggr) {
     if (auto reduce = as<Reduce>(expr)) {
         if ((reduce->aggr() == aggr) && (reduce->dimensions().size() == 1)) {
@@ -50,8 +107,8 @@ bool check_params(const ValueType &res_type, const ValueType &query, const Value
                   const std::string &sum_dim, const std::string &max_dim, const std::string &dp_dim)
 {
     if (res_type.is_double() &&
-        (query.dimensions().size() == 2) && (query.cell_type() == CellType::FLOAT) &&
-        (document.dimensions().size() == 2) && (document.cell_type() == CellType::FLOAT))
+        (query.dimensions().size() == 2) && (document.dimensions().size() == 2) &&
+        compatible_cell_types(query.cell_type(), document.cell_type()))
     {
         size_t npos = ValueType::Dimension::npos;
         size_t sum_idx = query.dimension_index(sum_dim);
@@ -93,7 +150,8 @@ SumMaxDotProductFunction::SumMaxDotProductFunction(const ValueType &res_type_in,
 InterpretedFunction::Instruction
 SumMaxDotProductFunction::compile_self(const ValueBuilderFactory &, Stash &) const
 {
-    return InterpretedFunction::Instruction(my_sum_max_dot_product_op, _dp_size);
+    auto op = typify_invoke<1,TypifyCellType,SelectOp>(lhs().result_type().cell_type());
+    return InterpretedFunction::Instruction(op, _dp_size);
 }
 
 const TensorFunction &
@@ -28,6 +28,12 @@ namespace vespalib::eval {
  * select the maximum result. Sum these partial results into the final
  * result value.
  *
+ * Query and document must have the same cell type; float, bfloat16
+ * and int8 are supported. int8 dot products are accumulated as
+ * integers, and bfloat16 cells are converted to float once per
+ * evaluation. Query vectors are processed in small blocks to reuse
+ * each document vector while it is in cache.
+ *
  * Note that not all equivalent forms are matched by this function
  * (initial matching will be very specific).
  **/
@@ -96,6 +96,30 @@ struct CreateVespaTensorRef {
     }
 };
 
+struct CreateVespaTensorSliceRef {
+    template <typename T> static Value::UP invoke(const ValueType &type_ref, Ort::Value &value, size_t entry) {
+        size_t num_cells = type_ref.dense_subspace_size();
+        std::span<const T> cells(value.GetTensorMutableData<T>() + (entry * num_cells), num_cells);
+        return std::make_unique<DenseValueView>(type_ref, TypedCells(cells));
+    }
+    Value::UP operator()(const ValueType &type_ref, Ort::Value &value, size_t entry) {
+        return typify_invoke<1,MyTypify,CreateVespaTensorSliceRef>(type_ref.cell_type(), type_ref, value, entry);
+    }
+};
+
+struct CreateOnnxTensorView {
+    template <typename T> static Ort::Value invoke(const OrtMemoryInfo *memory, Ort::Value &buffer, const std::vector<int64_t> &sizes) {
+        size_t num_cells = 1;
+        for (int64_t size: sizes) {
+            num_cells *= size;
+        }
+        return Ort::Value::CreateTensor<T>(memory, buffer.GetTensorMutableData<T>(), num_cells, sizes.data(), sizes.size());
+    }
+    Ort::Value operator()(Onnx::ElementType elements, const OrtMemoryInfo *memory, Ort::Value &buffer, const std::vector<int64_t> &sizes) {
+        return typify_invoke<1,MyTypify,CreateOnnxTensorView>(elements, memory, buffer, sizes);
+    }
+};
+
 struct CreateVespaTensor {
     template <typename T> static Value::UP invoke(const ValueType &type) {
         size_t num_cells = type.dense_subspace_size();
@@ -222,6 +246,14 @@ std::vector<int64_t> extract_sizes(const ValueType &type) {
     return sizes;
 }
 
+// sizes of a tensor holding a batch of tensors with the given sizes
+std::vector<int64_t> batch_sizes(const std::vector<int64_t> &sizes, size_t batch_size) {
+    std::vector<int64_t> result = sizes;
+    assert(!result.empty());
+    result[0] *= batch_size;
+    return result;
+}
+
 } // <unnamed>
 
 std::string
@@ -608,6 +640,157 @@ Onnx::EvalContext::get_result(size_t i) const
 
 //-----------------------------------------------------------------------------
 
+template <typename SRC, typename DST>
+void
+Onnx::BatchEvalContext::copy_param(BatchEvalContext &self, size_t entry, size_t idx, const Value &param)
+{
+    auto cells = param.cells().typify<SRC>();
+    size_t n = cells.size();
+    const SRC *src = cells.data();
+    DST *dst = self._param_buffers[idx].GetTensorMutableData<DST>() + (entry * n);
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = DST(src[i]);
+    }
+}
+
+template <typename SRC, typename DST>
+void
+Onnx::BatchEvalContext::convert_result(BatchEvalContext &self, size_t idx, size_t batch_size)
+{
+    const SRC *src = self._result_buffers[idx].GetTensorMutableData<SRC>();
+    for (size_t entry = 0; entry < batch_size; ++entry) {
+        const auto &cells_ref = (*self._results[idx][entry]).cells();
+        auto cells = unconstify(cells_ref.typify<DST>());
+        size_t n = cells.size();
+        DST *dst = cells.data();
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = DST(src[i]);
+        }
+        src += n;
+    }
+}
+
+struct Onnx::BatchEvalContext::SelectCopyParam {
+    template <typename ...Ts> static auto invoke() { return copy_param<Ts...>; }
+    auto operator()(CellType ct, Onnx::ElementType et) {
+        return typify_invoke<2,MyTypify,SelectCopyParam>(ct, et);
+    }
+};
+
+struct Onnx::BatchEvalContext::SelectConvertResult {
+    template <typename ...Ts> static auto invoke() { return convert_result<Ts...>; }
+    auto operator()(Onnx::ElementType et, CellType ct) {
+        return typify_invoke<2,MyTypify,SelectConvertResult>(et, ct);
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+Onnx::BatchEvalContext::BatchEvalContext(const Onnx &model, const WireInfo &wire_info, size_t max_batch_size)
+    : _model(model),
+      _wire_info(wire_info),
+      _max_batch_size(max_batch_size),
+      _batch_size(0),
+      _cpu_memory(Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault)),
+      _param_buffers(),
+      _result_buffers(),
+      _param_values(),
+      _result_values(),
+      _results(),
+      _param_binders(),
+      _result_converters()
+{
+    assert(_wire_info.vespa_inputs.size()  == _model.inputs().size());
+    assert(_wire_info.onnx_inputs.size()   == _model.inputs().size());
+    assert(_wire_info.onnx_outputs.size()  == _model.outputs().size());
+    assert(_wire_info.vespa_outputs.size() == _model.outputs().size());
+    assert(_model.has_free_batch_dimension());
+    assert(_max_batch_size > 0);
+    _param_buffers.reserve(_model.inputs().size());
+    _result_buffers.reserve(_model.outputs().size());
+    _results.reserve(_model.outputs().size());
+    for (size_t i = 0; i < _model.inputs().size(); ++i) {
+        const auto &vespa = _wire_info.vespa_inputs[i];
+        const auto &onnx = _wire_info.onnx_inputs[i];
+        TensorType buffer_type(onnx.elements, batch_sizes(onnx.dimensions, _max_batch_size));
+        _param_buffers.push_back(CreateOnnxTensor()(buffer_type, _alloc));
+        _param_binders.push_back(SelectCopyParam()(vespa.cell_type(), onnx.elements));
+    }
+    for (size_t i = 0; i < _model.outputs().size(); ++i) {
+        const auto &vespa = _wire_info.vespa_outputs[i];
+        const auto &onnx = _wire_info.onnx_outputs[i];
+        TensorType buffer_type(onnx.elements, batch_sizes(onnx.dimensions, _max_batch_size));
+        _result_buffers.push_back(CreateOnnxTensor()(buffer_type, _alloc));
+        auto &results = _results.emplace_back();
+        results.reserve(_max_batch_size);
+        bool same_type = is_same_type(vespa.cell_type(), onnx.elements);
+        for (size_t entry = 0; entry < _max_batch_size; ++entry) {
+            if (same_type) {
+                results.push_back(CreateVespaTensorSliceRef()(vespa, _result_buffers.back(), entry));
+            } else {
+                results.push_back(CreateVespaTensor()(vespa));
+            }
+        }
+        if (!same_type) {
+            _result_converters.emplace_back(i, SelectConvertResult()(onnx.elements, vespa.cell_type()));
+        }
+    }
+}
+
+Onnx::BatchEvalContext::~BatchEvalContext() = default;
+
+void
+Onnx::BatchEvalContext::prepare_batch(size_t batch_size)
+{
+    if (batch_size == _batch_size) {
+        return;
+    }
+    // tensors covering the first batch_size entries of each buffer
+    _param_values.clear();
+    for (size_t i = 0; i < _param_buffers.size(); ++i) {
+        const auto &onnx = _wire_info.onnx_inputs[i];
+        _param_values.push_back(CreateOnnxTensorView()(onnx.elements, _cpu_memory, _param_buffers[i],
+                                                       batch_sizes(onnx.dimensions, batch_size)));
+    }
+    _result_values.clear();
+    for (size_t i = 0; i < _result_buffers.size(); ++i) {
+        const auto &onnx = _wire_info.onnx_outputs[i];
+        _result_values.push_back(CreateOnnxTensorView()(onnx.elements, _cpu_memory, _result_buffers[i],
+                                                        batch_sizes(onnx.dimensions, batch_size)));
+    }
+    _batch_size = batch_size;
+}
+
+void
+Onnx::BatchEvalContext::bind_param(size_t entry, size_t i, const Value &param)
+{
+    assert(entry < _max_batch_size);
+    _param_binders[i](*this, entry, i, param);
+}
+
+void
+Onnx::BatchEvalContext::eval(size_t batch_size)
+{
+    assert((batch_size > 0) && (batch_size <= _max_batch_size));
+    prepare_batch(batch_size);
+    auto &session = const_cast<Ort::Session&>(_model._session);
+    Ort::RunOptions run_opts(nullptr);
+    session.Run(run_opts,
+                _model._input_name_refs.data(), _param_values.data(), _param_values.size(),
+                _model._output_name_refs.data(), _result_values.data(), _result_values.size());
+    for (const auto &entry: _result_converters) {
+        entry.second(*this, entry.first, batch_size);
+    }
+}
+
+const Value &
+Onnx::BatchEvalContext::get_result(size_t entry, size_t i) const
+{
+    return *_results[i][entry];
+}
+
+//-----------------------------------------------------------------------------
+
 Ort::AllocatorWithDefaultOptions Onnx::_alloc;
 
 Onnx::Shared::Shared()
@@ -668,4 +851,27 @@ Onnx::Onnx(const std::string &model_file, Optimize optimize)
 
 Onnx::~Onnx() = default;
 
+bool
+Onnx::has_free_batch_dimension() const
+{
+    if (_inputs.empty() || _inputs[0].dimensions.empty() || !_inputs[0].dimensions[0].is_symbolic()) {
+        return false;
+    }
+    const std::string &name = _inputs[0].dimensions[0].name;
+    auto check = [&name](const std::vector<TensorInfo> &list) {
+        for (const auto &info: list) {
+            if (info.dimensions.empty() || (info.dimensions[0].name != name)) {
+                return false;
+            }
+            for (size_t i = 1; i < info.dimensions.size(); ++i) {
+                if (info.dimensions[i].name == name) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    return check(_inputs) && check(_outputs);
+}
+
 }
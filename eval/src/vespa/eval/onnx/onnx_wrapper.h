@@ -137,6 +137,55 @@ public:
         const Value &get_result(size_t i) const;
     };
 
+    // evaluation context for models with a free batch dimension (see
+    // has_free_batch_dimension); use one per thread and keep
+    // model/wire_info alive. The wire info describes a single
+    // evaluation. Parameters for up to max_batch_size independent
+    // evaluations are bound (copied) into combined input tensors
+    // along the batch dimension, and the model is run once for the
+    // whole batch. Output values for each batch entry are
+    // pre-allocated and will not change.
+    class BatchEvalContext {
+    private:
+        using param_fun_t = void (*)(BatchEvalContext &, size_t entry, size_t i, const Value &);
+        using result_fun_t = void (*)(BatchEvalContext &, size_t i, size_t batch_size);
+
+        const Onnx                          &_model;
+        const WireInfo                      &_wire_info;
+        size_t                               _max_batch_size;
+        size_t                               _batch_size;
+        Ort::MemoryInfo                      _cpu_memory;
+        std::vector<Ort::Value>              _param_buffers;
+        std::vector<Ort::Value>              _result_buffers;
+        std::vector<Ort::Value>              _param_values;
+        std::vector<Ort::Value>              _result_values;
+        std::vector<std::vector<Value::UP>>  _results;
+        std::vector<param_fun_t>             _param_binders;
+        std::vector<std::pair<size_t,result_fun_t>> _result_converters;
+
+        void prepare_batch(size_t batch_size);
+
+        template <typename SRC, typename DST>
+        static void copy_param(BatchEvalContext &self, size_t entry, size_t idx, const Value &param);
+
+        template <typename SRC, typename DST>
+        static void convert_result(BatchEvalContext &self, size_t idx, size_t batch_size);
+
+    public:
+        struct SelectCopyParam;
+        struct SelectConvertResult;
+
+        BatchEvalContext(const Onnx &model, const WireInfo &wire_info, size_t max_batch_size);
+        ~BatchEvalContext();
+        size_t max_batch_size() const { return _max_batch_size; }
+        size_t num_params() const { return _param_buffers.size(); }
+        size_t num_results() const { return _result_buffers.size(); }
+        void bind_param(size_t entry, size_t i, const Value &param);
+        // evaluate the first batch_size entries
+        void eval(size_t batch_size);
+        const Value &get_result(size_t entry, size_t i) const;
+    };
+
 private:
     // common stuff shared between model sessions
     class Shared {
@@ -165,6 +214,9 @@ public:
     ~Onnx();
     const std::vector<TensorInfo> &inputs() const { return _inputs; }
     const std::vector<TensorInfo> &outputs() const { return _outputs; }
+    // all inputs and outputs start with the same symbolic dimension,
+    // which is not used anywhere else
+    bool has_free_batch_dimension() const;
 };
 
 }
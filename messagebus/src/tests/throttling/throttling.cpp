@@ -2,6 +2,7 @@
 
 #include <vespa/messagebus/destinationsession.h>
 #include <vespa/messagebus/dynamicthrottlepolicy.h>
+#include <vespa/messagebus/latencyawarethrottlepolicy.h>
 #include <vespa/messagebus/routablequeue.h>
 #include <vespa/messagebus/routing/routingspec.h>
 #include <vespa/messagebus/sourcesession.h>
@@ -12,10 +13,15 @@
 #include <vespa/messagebus/testlib/simplereply.h>
 #include <vespa/messagebus/testlib/testserver.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <cinttypes>
+#include <deque>
+#include <string>
 #include <thread>
 
 using namespace mbus;
 
+bool bench = false;
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // Utilities
@@ -91,6 +97,91 @@ getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPe
     return ret;
 }
 
+/**
+ * Discrete time simulation of a source session that always has more to send, feeding a destination that
+ * works on at most a given number of messages at a time, each taking a fixed service time. Messages that
+ * can not be serviced right away are queued at the destination. The destination capacity can be changed
+ * half way through the simulation. Statistics are gathered for the second half of the simulation only.
+ */
+struct SimulatedDestination {
+    struct Pending {
+        uint64_t      sent;
+        uint64_t      done;
+        mbus::Context context;
+    };
+    uint32_t            concurrency;
+    uint64_t            serviceTime;
+    std::deque<Pending> queued;
+    std::deque<Pending> inService;
+
+    SimulatedDestination(uint32_t concurrency_in, uint64_t serviceTime_in)
+        : concurrency(concurrency_in), serviceTime(serviceTime_in), queued(), inService() {}
+    ~SimulatedDestination();
+
+    void startService(uint64_t now) {
+        while (!queued.empty() && inService.size() < concurrency) {
+            Pending pending = queued.front();
+            queued.pop_front();
+            pending.done = now + serviceTime;
+            inService.push_back(pending);
+        }
+    }
+};
+
+SimulatedDestination::~SimulatedDestination() = default;
+
+struct SimulationResult {
+    double windowSize; // average window size
+    double rtt;        // average round-trip time, in milliseconds
+    double throughput; // replies per millisecond
+};
+
+template <typename Policy>
+SimulationResult
+simulate(Policy &policy, DynamicTimer &timer, SimulatedDestination &dst, uint64_t duration, uint32_t laterConcurrency = 0)
+{
+    SimulatedDestination::Pending done{};
+    SimpleMessage msg("foo");
+    double rttSum = 0;
+    double windowSum = 0;
+    uint64_t numReplies = 0;
+    uint64_t half = timer._millis + duration / 2;
+    for (uint64_t end = timer._millis + duration; timer._millis < end; ++timer._millis) {
+        uint64_t now = timer._millis;
+        if (laterConcurrency > 0 && now == half) {
+            dst.concurrency = laterConcurrency;
+        }
+        while (!dst.inService.empty() && dst.inService.front().done <= now) {
+            done = dst.inService.front();
+            dst.inService.pop_front();
+            SimpleReply reply("bar");
+            reply.setContext(done.context);
+            policy.processReply(reply);
+            if (now >= half) {
+                rttSum += (now - done.sent);
+                ++numReplies;
+            }
+        }
+        dst.startService(now);
+        while (policy.canSend(msg, static_cast<uint32_t>(dst.queued.size() + dst.inService.size()))) {
+            policy.processMessage(msg);
+            dst.queued.push_back({now, 0, msg.getContext()});
+        }
+        dst.startService(now);
+        if (now >= half) {
+            windowSum += policy.getMaxPendingCount();
+        }
+    }
+    return {windowSum / (duration - duration / 2), rttSum / numReplies, double(numReplies) / (duration - duration / 2)};
+}
+
+void
+print_result(const char *name, const SimulatedDestination &dst, const SimulationResult &result)
+{
+    fprintf(stderr, "%-13s: concurrency=%u, serviceTime=%" PRIu64 ", windowSize=%.1f, rtt=%.1f, throughput=%.2f\n",
+            name, dst.concurrency, dst.serviceTime, result.windowSize, result.rtt, result.throughput);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // Tests
@@ -315,4 +406,95 @@ TEST(ThrottlingTest, test_max_window_size)
 
 }
 
-GTEST_MAIN_RUN_ALL_TESTS()
+TEST(ThrottlingTest, test_latency_aware_policy_restores_pending_size)
+{
+    auto ptr = std::make_unique<DynamicTimer>();
+    auto* timer = ptr.get();
+    LatencyAwareThrottlePolicy policy(std::move(ptr));
+    timer->_millis = 0x1234567890;
+
+    SimpleMessage msg("1234567890");
+    policy.processMessage(msg);
+    EXPECT_EQ(10u, policy.getPendingSize());
+
+    timer->_millis += 7;
+    SimpleReply reply("bar");
+    reply.setContext(msg.getContext());
+    policy.processReply(reply);
+    EXPECT_EQ(0u, policy.getPendingSize());
+    EXPECT_EQ(10u, reply.getContext().value.UINT64);
+    EXPECT_EQ(7.0, policy.getBaseRtt());
+    EXPECT_EQ(7.0, policy.getSmoothedRtt());
+}
+
+TEST(ThrottlingTest, test_latency_aware_window_tracks_destination_capacity)
+{
+    auto ptr = std::make_unique<DynamicTimer>();
+    auto* timer = ptr.get();
+    LatencyAwareThrottlePolicy policy(std::move(ptr));
+    policy.setWindowSizeIncrement(2)
+          .setMinWindowSize(1);
+
+    SimulatedDestination dst(100, 5);
+    auto result = simulate(policy, *timer, dst, 20000);
+    EXPECT_GE(result.windowSize, 90.0);
+    EXPECT_LE(result.windowSize, 130.0);
+    EXPECT_LE(result.rtt, 7.5);
+    EXPECT_GE(result.throughput, 19.0);
+}
+
+TEST(ThrottlingTest, test_latency_aware_window_shrinks_when_destination_capacity_drops)
+{
+    auto ptr = std::make_unique<DynamicTimer>();
+    auto* timer = ptr.get();
+    LatencyAwareThrottlePolicy policy(std::move(ptr));
+    policy.setWindowSizeIncrement(2)
+          .setMinWindowSize(1);
+
+    SimulatedDestination dst(20, 10);
+    simulate(policy, *timer, dst, 20000);
+    EXPECT_GE(policy.getMaxPendingCount(), 18u);
+
+    auto result = simulate(policy, *timer, dst, 20000, 10);
+    EXPECT_LE(result.windowSize, 16.0);
+    EXPECT_LE(result.rtt, 15.0);
+    EXPECT_GE(result.throughput, 0.95);
+}
+
+TEST(ThrottlingTest, benchmark_latency_aware_and_dynamic_policies)
+{
+    // Not a pass/fail test, but runs both dynamic policies against the same simulated destinations for comparison.
+    if (!bench) {
+        fprintf(stderr, "benchmarking disabled, run with 'bench' parameter to enable\n");
+        return;
+    }
+    for (auto [concurrency, serviceTime] : std::vector<std::pair<uint32_t, uint64_t>>{{20, 10}, {100, 2}, {100, 5}, {200, 20}}) {
+        {
+            auto ptr = std::make_unique<DynamicTimer>();
+            auto* timer = ptr.get();
+            LatencyAwareThrottlePolicy policy(std::move(ptr));
+            policy.setWindowSizeIncrement(2).setMinWindowSize(1);
+            SimulatedDestination dst(concurrency, serviceTime);
+            print_result("latency aware", dst, simulate(policy, *timer, dst, 20000));
+        }
+        {
+            auto ptr = std::make_unique<DynamicTimer>();
+            auto* timer = ptr.get();
+            DynamicThrottlePolicy policy(std::move(ptr));
+            policy.setWindowSizeIncrement(2).setMinWindowSize(1);
+            SimulatedDestination dst(concurrency, serviceTime);
+            print_result("dynamic", dst, simulate(policy, *timer, dst, 20000));
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::string bench_option = "bench";
+    if ((argc > 1) && (bench_option == argv[1])) {
+        bench = true;
+        ++argv;
+        --argc;
+    }
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
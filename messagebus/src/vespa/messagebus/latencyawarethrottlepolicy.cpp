@@ -0,0 +1,210 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "latencyawarethrottlepolicy.h"
+#include "message.h"
+#include "steadytimer.h"
+#include <algorithm>
+#include <climits>
+#include <limits>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".latencyawarethrottlepolicy");
+
+namespace mbus {
+
+namespace {
+
+constexpr uint64_t SIZE_MASK = 0xffffffffULL;
+
+}
+
+LatencyAwareThrottlePolicy::LatencyAwareThrottlePolicy()
+    : LatencyAwareThrottlePolicy(std::make_unique<SteadyTimer>())
+{ }
+
+LatencyAwareThrottlePolicy::LatencyAwareThrottlePolicy(ITimer::UP timer) :
+    _timer(std::move(timer)),
+    _numSamples(0),
+    _numPeriods(0),
+    _baseRttResetPeriods(100),
+    _resizeRate(1.0),
+    _timeOfLastMessage(_timer->getMilliTime()),
+    _idleTimePeriod(60000),
+    _windowSizeIncrement(20),
+    _windowSize(_windowSizeIncrement),
+    _maxWindowSize(INT_MAX),
+    _minWindowSize(_windowSizeIncrement),
+    _windowSizeBackOff(0.9),
+    _lowQueueingThreshold(0.1),
+    _highQueueingThreshold(0.3),
+    _gradientTolerance(0.25),
+    _smoothingFactor(0.125),
+    _baseRtt(0),
+    _periodMinRtt(std::numeric_limits<double>::max()),
+    _smoothedRtt(0),
+    _lastPeriodRtt(0)
+{ }
+
+LatencyAwareThrottlePolicy::~LatencyAwareThrottlePolicy() = default;
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setWindowSizeIncrement(double windowSizeIncrement)
+{
+    _windowSizeIncrement = windowSizeIncrement;
+    _windowSize = std::max(_windowSize, _windowSizeIncrement);
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setWindowSizeBackOff(double windowSizeBackOff)
+{
+    _windowSizeBackOff = std::max(0.0, std::min(1.0, windowSizeBackOff));
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setResizeRate(double resizeRate)
+{
+    _resizeRate = std::max(1.0, resizeRate);
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setQueueingThresholds(double low, double high)
+{
+    _lowQueueingThreshold = std::max(0.0, std::min(1.0, low));
+    _highQueueingThreshold = std::max(_lowQueueingThreshold, std::min(1.0, high));
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setGradientTolerance(double tolerance)
+{
+    _gradientTolerance = std::max(0.0, tolerance);
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setSmoothingFactor(double factor)
+{
+    _smoothingFactor = std::max(std::numeric_limits<double>::min(), std::min(1.0, factor));
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setBaseRttResetPeriods(uint32_t periods)
+{
+    _baseRttResetPeriods = std::max(1u, periods);
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setIdleTimePeriod(uint64_t period)
+{
+    _idleTimePeriod = period;
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setMaxWindowSize(double max)
+{
+    _maxWindowSize = max;
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setMinWindowSize(double min)
+{
+    _minWindowSize = min;
+    _windowSize = std::max(_minWindowSize, _windowSizeIncrement);
+    return *this;
+}
+
+LatencyAwareThrottlePolicy &
+LatencyAwareThrottlePolicy::setMaxPendingCount(uint32_t maxCount)
+{
+    StaticThrottlePolicy::setMaxPendingCount(maxCount);
+    _maxWindowSize = maxCount;
+    return *this;
+}
+
+bool
+LatencyAwareThrottlePolicy::canSend(const Message &msg, uint32_t pendingCount)
+{
+    if (!StaticThrottlePolicy::canSend(msg, pendingCount)) {
+        return false;
+    }
+    uint64_t time = _timer->getMilliTime();
+    if (time - _timeOfLastMessage > _idleTimePeriod) {
+        _windowSize = std::max(_minWindowSize, std::min(_windowSize, pendingCount + _windowSizeIncrement));
+        LOG(debug, "Idle time exceeded; WindowSize = %.2f", _windowSize);
+    }
+    _timeOfLastMessage = time;
+    return pendingCount < std::max(1u, static_cast<uint32_t>(_windowSize));
+}
+
+void
+LatencyAwareThrottlePolicy::processMessage(Message &msg)
+{
+    StaticThrottlePolicy::processMessage(msg);
+    uint64_t size = msg.getContext().value.UINT64 & SIZE_MASK;
+    uint64_t sendTime = _timer->getMilliTime() & SIZE_MASK;
+    msg.setContext(Context((sendTime << 32) | size));
+}
+
+void
+LatencyAwareThrottlePolicy::processReply(Reply &reply)
+{
+    uint64_t context = reply.getContext().value.UINT64;
+    auto sendTime = static_cast<uint32_t>(context >> 32);
+    reply.setContext(Context(context & SIZE_MASK));
+    StaticThrottlePolicy::processReply(reply);
+    if (reply.hasErrors()) {
+        // Errors are often returned without the destination doing any work, and would skew the base RTT.
+        return;
+    }
+    auto rtt = static_cast<uint32_t>(_timer->getMilliTime()) - sendTime;
+    sampleRtt(rtt);
+    if (++_numSamples >= _windowSize * _resizeRate) {
+        _numSamples = 0;
+        resize();
+    }
+}
+
+void
+LatencyAwareThrottlePolicy::sampleRtt(double rtt)
+{
+    rtt = std::max(1.0, rtt);
+    _periodMinRtt = std::min(_periodMinRtt, rtt);
+    if (_baseRtt == 0 || rtt < _baseRtt) {
+        _baseRtt = rtt;
+    }
+    if (_smoothedRtt == 0) {
+        _smoothedRtt = rtt;
+    } else {
+        _smoothedRtt += _smoothingFactor * (rtt - _smoothedRtt);
+    }
+}
+
+void
+LatencyAwareThrottlePolicy::resize()
+{
+    double queueing = 1.0 - (_baseRtt / _smoothedRtt);
+    double gradient = (_lastPeriodRtt > 0) ? (_smoothedRtt / _lastPeriodRtt) - 1.0 : 0.0;
+    if (queueing > _highQueueingThreshold || gradient > _gradientTolerance) {
+        _windowSize *= _windowSizeBackOff;
+    } else if (queueing < _lowQueueingThreshold) {
+        _windowSize += _windowSizeIncrement;
+    }
+    _windowSize = std::max(_minWindowSize, _windowSize);
+    _windowSize = std::min(_maxWindowSize, _windowSize);
+    LOG(debug, "WindowSize = %.2f, BaseRtt = %.2f, SmoothedRtt = %.2f, Queueing = %.2f, Gradient = %.2f",
+        _windowSize, _baseRtt, _smoothedRtt, queueing, gradient);
+    _lastPeriodRtt = _smoothedRtt;
+    if (++_numPeriods >= _baseRttResetPeriods) {
+        _numPeriods = 0;
+        _baseRtt = _periodMinRtt;
+    }
+    _periodMinRtt = std::numeric_limits<double>::max();
+}
+
+} // namespace mbus
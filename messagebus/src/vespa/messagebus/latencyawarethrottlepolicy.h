@@ -0,0 +1,194 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "itimer.h"
+#include "staticthrottlepolicy.h"
+
+namespace mbus {
+
+/**
+ * This is an implementation of the {@link ThrottlePolicy} that sizes the window of pending messages a
+ * {@link SourceSession} is allowed to have from observed round-trip times rather than from throughput.
+ *
+ * The policy keeps track of the lowest round-trip time seen recently (the base RTT) and a smoothed
+ * round-trip time. Their ratio estimates how much of the window is spent queued at the destination. Once
+ * per window worth of replies the window is grown if little is queued, shrunk if too much is queued, and
+ * also shrunk if the smoothed round-trip time is rising faster than the configured gradient tolerance.
+ * This lets the window back off before queues build up on the destination, instead of waiting for
+ * throughput to drop as {@link DynamicThrottlePolicy} does.
+ *
+ * The send time of each message is stored in the upper 32 bits of the message context, next to the
+ * message size used by {@link StaticThrottlePolicy}. Round-trip times are measured with millisecond
+ * resolution, so destinations with sub-millisecond latency are treated as having a base RTT of 1 ms.
+ *
+ * <b>NOTE:</b> By context, "pending" is refering to the number of sent messages that have not been replied to
+ * yet.
+ */
+class LatencyAwareThrottlePolicy : public StaticThrottlePolicy {
+private:
+    ITimer::UP  _timer;
+    uint32_t    _numSamples;
+    uint32_t    _numPeriods;
+    uint32_t    _baseRttResetPeriods;
+    double      _resizeRate;
+    uint64_t    _timeOfLastMessage;
+    uint64_t    _idleTimePeriod;
+    double      _windowSizeIncrement;
+    double      _windowSize;
+    double      _maxWindowSize;
+    double      _minWindowSize;
+    double      _windowSizeBackOff;
+    double      _lowQueueingThreshold;
+    double      _highQueueingThreshold;
+    double      _gradientTolerance;
+    double      _smoothingFactor;
+    double      _baseRtt;
+    double      _periodMinRtt;
+    double      _smoothedRtt;
+    double      _lastPeriodRtt;
+
+    void sampleRtt(double rtt);
+    void resize();
+
+public:
+    /**
+     * Convenience typedefs.
+     */
+    using UP = std::unique_ptr<LatencyAwareThrottlePolicy>;
+    using SP = std::shared_ptr<LatencyAwareThrottlePolicy>;
+
+    /**
+     * Constructs a new instance of this policy and sets the appropriate default values of member data.
+     */
+    LatencyAwareThrottlePolicy();
+
+    /**
+     * Constructs a new instance of this class using the given clock to measure round-trip times.
+     *
+     * @param timer The timer to use.
+     */
+    explicit LatencyAwareThrottlePolicy(ITimer::UP timer);
+    ~LatencyAwareThrottlePolicy() override;
+
+    /**
+     * Sets the step size used when increasing window size.
+     *
+     * @param windowSizeIncrement The step size to set.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setWindowSizeIncrement(double windowSizeIncrement);
+
+    /**
+     * Sets the factor the window size is multiplied with when the policy decides to shrink it. This value
+     * is capped to the [0, 1] range.
+     *
+     * @param windowSizeBackOff The back off to set.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setWindowSizeBackOff(double windowSizeBackOff);
+
+    /**
+     * Sets the number of window sizes worth of replies to sample between each resize. The larger the value,
+     * the less responsive the resizing becomes, but the less noisy the measurements are.
+     *
+     * @param resizeRate The rate to set.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setResizeRate(double resizeRate);
+
+    /**
+     * Sets the bounds on the fraction of round-trip time that may be spent queueing. Below the low
+     * threshold the window grows, above the high threshold it shrinks, and in between it is kept.
+     *
+     * @param low  The fraction below which the window is grown.
+     * @param high The fraction above which the window is shrunk.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setQueueingThresholds(double low, double high);
+
+    /**
+     * Sets how much the smoothed round-trip time may grow from one resize period to the next, relative to
+     * its previous value, before the window is shrunk regardless of the estimated queueing.
+     *
+     * @param tolerance The relative growth to tolerate.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setGradientTolerance(double tolerance);
+
+    /**
+     * Sets the weight given to each new round-trip time sample in the smoothed round-trip time.
+     *
+     * @param factor The smoothing factor, capped to the (0, 1] range.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setSmoothingFactor(double factor);
+
+    /**
+     * Sets the number of resize periods after which the base round-trip time is forgotten and re-learned
+     * from the lowest round-trip time of the last period. This allows the policy to adapt to a destination
+     * that has become permanently slower.
+     *
+     * @param periods The number of periods.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setBaseRttResetPeriods(uint32_t periods);
+
+    /**
+     * Sets the idle time period for this client. If nothing is sent throughout
+     * this time period, the window will retract.
+     *
+     * @param period The time period to set.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setIdleTimePeriod(uint64_t period);
+
+    /**
+     * Sets the maximium number of pending operations allowed at any time.
+     *
+     * @param max The max to set.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setMaxWindowSize(double max);
+
+    /**
+     * Sets the minimium number of pending operations allowed at any time.
+     *
+     * @param min The min to set.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setMinWindowSize(double min);
+
+    /**
+     * Sets the maximum number of pending messages allowed.
+     *
+     * @param maxCount The max count.
+     * @return This, to allow chaining.
+     */
+    LatencyAwareThrottlePolicy &setMaxPendingCount(uint32_t maxCount);
+
+    double getMaxWindowSize() const { return _maxWindowSize; }
+    double getMinWindowSize() const { return _minWindowSize; }
+
+    /**
+     * Returns the lowest round-trip time currently known, in milliseconds, or 0 if none has been sampled.
+     */
+    double getBaseRtt() const { return _baseRtt; }
+
+    /**
+     * Returns the smoothed round-trip time, in milliseconds, or 0 if none has been sampled.
+     */
+    double getSmoothedRtt() const { return _smoothedRtt; }
+
+    /**
+     * Returns the maximum number of pending messages allowed.
+     *
+     * @return The max limit.
+     */
+    uint32_t getMaxPendingCount() const { return (uint32_t)_windowSize; }
+
+    bool canSend(const Message &msg, uint32_t pendingCount) override;
+    void processMessage(Message &msg) override;
+    void processReply(Reply &reply) override;
+};
+
+} // namespace mbus
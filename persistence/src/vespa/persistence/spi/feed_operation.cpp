@@ -0,0 +1,55 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "feed_operation.h"
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/update/documentupdate.h>
+
+namespace storage::spi {
+
+FeedOperation::FeedOperation(Type type, Timestamp timestamp, DocumentSP doc, DocumentUpdateSP upd,
+                             DocumentId id, OperationComplete::UP on_complete) noexcept
+    : _type(type),
+      _timestamp(timestamp),
+      _doc(std::move(doc)),
+      _upd(std::move(upd)),
+      _id(std::move(id)),
+      _on_complete(std::move(on_complete))
+{
+}
+
+FeedOperation::FeedOperation(FeedOperation&&) noexcept = default;
+FeedOperation& FeedOperation::operator=(FeedOperation&&) noexcept = default;
+FeedOperation::~FeedOperation() = default;
+
+FeedOperation
+FeedOperation::make_put(Timestamp timestamp, DocumentSP doc, OperationComplete::UP on_complete)
+{
+    return {Type::PUT, timestamp, std::move(doc), DocumentUpdateSP(), DocumentId(), std::move(on_complete)};
+}
+
+FeedOperation
+FeedOperation::make_update(Timestamp timestamp, DocumentUpdateSP upd, OperationComplete::UP on_complete)
+{
+    return {Type::UPDATE, timestamp, DocumentSP(), std::move(upd), DocumentId(), std::move(on_complete)};
+}
+
+FeedOperation
+FeedOperation::make_remove_if_found(Timestamp timestamp, const DocumentId& id, OperationComplete::UP on_complete)
+{
+    return {Type::REMOVE_IF_FOUND, timestamp, DocumentSP(), DocumentUpdateSP(), id, std::move(on_complete)};
+}
+
+const DocumentId&
+FeedOperation::document_id() const noexcept
+{
+    switch (_type) {
+    case Type::PUT:
+        return _doc->getId();
+    case Type::UPDATE:
+        return _upd->getId();
+    default:
+        return _id;
+    }
+}
+
+}
@@ -0,0 +1,59 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "operationcomplete.h"
+#include "types.h"
+#include <vespa/document/base/documentid.h>
+
+namespace storage::spi {
+
+/**
+ * A single put, update or remove operation that is part of a batch of feed
+ * operations towards the same bucket (see PersistenceProvider::feedBatchAsync).
+ *
+ * Each operation has its own completion callback, receiving the same result
+ * type as the corresponding single-operation function would have given.
+ */
+class FeedOperation {
+public:
+    enum class Type : uint8_t {
+        PUT,
+        UPDATE,
+        REMOVE_IF_FOUND
+    };
+private:
+    Type                _type;
+    Timestamp           _timestamp;
+    DocumentSP          _doc;
+    DocumentUpdateSP    _upd;
+    DocumentId          _id;
+    OperationComplete::UP _on_complete;
+
+    FeedOperation(Type type, Timestamp timestamp, DocumentSP doc, DocumentUpdateSP upd,
+                  DocumentId id, OperationComplete::UP on_complete) noexcept;
+public:
+    FeedOperation(FeedOperation&&) noexcept;
+    FeedOperation& operator=(FeedOperation&&) noexcept;
+    ~FeedOperation();
+
+    static FeedOperation make_put(Timestamp timestamp, DocumentSP doc, OperationComplete::UP on_complete);
+    static FeedOperation make_update(Timestamp timestamp, DocumentUpdateSP upd, OperationComplete::UP on_complete);
+    static FeedOperation make_remove_if_found(Timestamp timestamp, const DocumentId& id, OperationComplete::UP on_complete);
+
+    [[nodiscard]] Type type() const noexcept { return _type; }
+    [[nodiscard]] Timestamp timestamp() const noexcept { return _timestamp; }
+    [[nodiscard]] const DocumentSP& document() const noexcept { return _doc; }
+    [[nodiscard]] const DocumentUpdateSP& update() const noexcept { return _upd; }
+    // Only valid for REMOVE_IF_FOUND operations.
+    [[nodiscard]] const DocumentId& remove_id() const noexcept { return _id; }
+    // Id of the document this operation mutates, regardless of operation type.
+    [[nodiscard]] const DocumentId& document_id() const noexcept;
+
+    [[nodiscard]] OperationComplete& on_complete() noexcept { return *_on_complete; }
+
+    DocumentSP steal_document() noexcept { return std::move(_doc); }
+    DocumentUpdateSP steal_update() noexcept { return std::move(_upd); }
+    OperationComplete::UP steal_on_complete() noexcept { return std::move(_on_complete); }
+};
+
+}
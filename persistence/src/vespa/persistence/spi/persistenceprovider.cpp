@@ -66,4 +66,21 @@ PersistenceProvider::update(const Bucket& bucket, Timestamp timestamp, DocumentU
     return dynamic_cast<const UpdateResult &>(*future.get());
 }
 
+void
+PersistenceProvider::feedBatchAsync(const Bucket& bucket, std::vector<FeedOperation> ops) {
+    for (auto& op : ops) {
+        switch (op.type()) {
+        case FeedOperation::Type::PUT:
+            putAsync(bucket, op.timestamp(), op.steal_document(), op.steal_on_complete());
+            break;
+        case FeedOperation::Type::UPDATE:
+            updateAsync(bucket, op.timestamp(), op.steal_update(), op.steal_on_complete());
+            break;
+        case FeedOperation::Type::REMOVE_IF_FOUND:
+            removeIfFoundAsync(bucket, op.timestamp(), op.remove_id(), op.steal_on_complete());
+            break;
+        }
+    }
+}
+
 }
@@ -8,6 +8,7 @@
 #include "result.h"
 #include "selection.h"
 #include "clusterstate.h"
+#include "feed_operation.h"
 #include "operationcomplete.h"
 #include <vespa/document/base/documentid.h>
 
@@ -218,6 +219,18 @@ struct PersistenceProvider
      */
     virtual void updateAsync(const Bucket&, Timestamp timestamp, DocumentUpdateSP update, OperationComplete::UP) = 0;
 
+    /**
+     * Applies a batch of puts, updates and removes towards the same bucket, in order.
+     * Each operation is completed through its own callback, as if it had been
+     * sent through putAsync, updateAsync or removeIfFoundAsync. A batch never
+     * contains more than one operation for the same document.
+     *
+     * Providers that can write several operations as one unit of work (e.g.
+     * a single transaction log append and commit) should override this. The
+     * default implementation dispatches each operation separately.
+     */
+    virtual void feedBatchAsync(const Bucket&, std::vector<FeedOperation> ops);
+
     /**
      * Retrieves the latest version of the document specified by the
      * document id. If no versions were found, or the document was removed,
@@ -55,6 +55,7 @@
 #include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/hw_info.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
+#include <vespa/vespalib/util/sequencedtaskexecutor.h>
 #include <vespa/vespalib/util/sequencedtaskexecutorobserver.h>
 
 #include <vespa/log/log.h>
@@ -91,6 +92,7 @@ using search::test::DocBuilder;
 using std::string;
 using vespalib::ForegroundTaskExecutor;
 using vespalib::ForegroundThreadExecutor;
+using vespalib::SequencedTaskExecutor;
 using vespalib::SequencedTaskExecutorObserver;
 using vespalib::datastore::CompactionStrategy;
 using vespalib::eval::SimpleValue;
@@ -110,6 +112,8 @@ namespace {
 
 constexpr uint64_t createSerialNum = 42u;
 
+VESPA_THREAD_STACK_TAG(test_executor)
+
 }
 
 AVConfig
@@ -500,6 +504,36 @@ TEST_F(AttributeWriterTest, handles_update)
     }
 }
 
+TEST_F(AttributeWriterTest, updates_are_batched_until_write_thread_starts_applying_them)
+{
+    auto writer = SequencedTaskExecutor::create(test_executor, 1);
+    SequencedTaskExecutorObserver observer(*writer);
+    _mgr->set_writer(observer);
+    auto a1 = addAttribute("a1");
+    allocAttributeWriter();
+    fillAttribute(a1, 1, 10, 1);
+
+    DocBuilder db([](auto& header) { header.addField("a1", DataType::T_INT); });
+    DocumentUpdate upd(db.get_repo(), db.get_document_type(), DocumentId("id:ns:searchdocument::1"));
+    upd.addUpdate(FieldUpdate(upd.getType().getField("a1"))
+                  .addUpdate(std::make_unique<ArithmeticValueUpdate>(ArithmeticValueUpdate::Add, 5)));
+    vespalib::Gate blocked;
+    observer.execute(observer.getExecutorId(0), [&blocked]() { blocked.await(); });
+    DummyFieldUpdateCallback onUpdate;
+    for (SerialNum serial_num = 2; serial_num < 5; ++serial_num) {
+        _aw->update(serial_num, upd, 1, emptyCallback, onUpdate);
+    }
+    EXPECT_EQ(2u, observer.getExecuteCnt());
+    blocked.countDown();
+    EXPECT_EQ(4u, test_force_commit(*a1, 4));
+
+    attribute::IntegerContent ibuf;
+    ibuf.fill(*a1, 1);
+    EXPECT_EQ(1u, ibuf.size());
+    EXPECT_EQ(25u, ibuf[0]);
+    _aw.reset();
+}
+
 TEST_F(AttributeWriterTest, handles_predicate_update)
 {
     auto a1 = addAttribute({"a1", AVConfig(AVBasicType::PREDICATE)});
@@ -1,10 +1,16 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/repo/configbuilder.h>
+#include <vespa/document/update/arithmeticvalueupdate.h>
+#include <vespa/document/update/documentupdate.h>
 #include <vespa/fastos/file.h>
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
 #include <vespa/searchcore/proton/attribute/attributedisklayout.h>
 #include <vespa/searchcore/proton/attribute/attributemanager.h>
 #include <vespa/searchcore/proton/attribute/flushableattribute.h>
+#include <vespa/searchcore/proton/attribute/ifieldupdatecallback.h>
 #include <vespa/searchcore/proton/flushengine/shrink_lid_space_flush_target.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/attribute/integerbase.h>
@@ -13,14 +19,19 @@
 #include <vespa/searchlib/common/indexmetainfo.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/test/directory_handler.h>
+#include <vespa/searchlib/test/doc_builder.h>
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/foreground_thread_executor.h>
 #include <vespa/vespalib/util/foregroundtaskexecutor.h>
+#include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
+#include <vespa/vespalib/util/sequencedtaskexecutor.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <filesystem>
+#include <future>
 #include <thread>
 #include <cinttypes>
 
@@ -32,6 +43,7 @@ using namespace search;
 using namespace vespalib;
 
 using search::index::DummyFileHeaderContext;
+using search::test::DocBuilder;
 
 using AVConfig = search::attribute::Config;
 using AVBasicType = search::attribute::BasicType;
@@ -52,6 +64,8 @@ namespace {
 
 const uint64_t createSerialNum = 42u;
 
+VESPA_THREAD_STACK_TAG(test_executor)
+
 }
 
 class TaskWrapper : public Executor::Task
@@ -597,6 +611,62 @@ TEST(AttributeFlushTest, require_that_flush_failure_prevents_sync_token_update)
     EXPECT_EQ(0u, flush_target->getFlushedSerialNum());
 }
 
+TEST(AttributeFlushTest, require_that_updates_are_not_batched_across_flush)
+{
+    test::DirectoryHandler dir_handler(test_dir);
+    DummyFileHeaderContext file_header_context;
+    auto writer = SequencedTaskExecutor::create(test_executor, 1);
+    ForegroundThreadExecutor shared;
+    auto am = std::make_shared<AttributeManager>(test_dir, "test.subdb", TuneFileAttributes(), file_header_context,
+                                                 std::make_shared<search::attribute::Interlock>(),
+                                                 *writer, shared, HwInfo());
+    auto av = am->addAttribute({"a13", getInt32Config()}, createSerialNum);
+    av->addDocs(2);
+    static_cast<IntegerAttribute &>(*av).update(1, 10);
+    av->commit(CommitParam(createSerialNum));
+    IFlushTarget::SP ft = am->getFlushable("a13");
+    auto aw = std::make_unique<AttributeWriter>(am);
+
+    DocBuilder db([](auto& header) { header.addField("a13", DataType::T_INT); });
+    DocumentUpdate upd(db.get_repo(), db.get_document_type(), DocumentId("id:ns:searchdocument::1"));
+    upd.addUpdate(FieldUpdate(upd.getType().getField("a13"))
+                  .addUpdate(std::make_unique<ArithmeticValueUpdate>(ArithmeticValueUpdate::Add, 5)));
+    proton::DummyFieldUpdateCallback on_update;
+    auto id = writer->getExecutorIdFromName(av->getNamePrefix());
+    uint64_t scheduled_tasks = writer->get_num_scheduled_tasks(id);
+    Gate blocked;
+    writer->execute(id, [&blocked]() { blocked.await(); });
+    aw->update(50, upd, 1, {}, on_update);
+    aw->update(51, upd, 1, {}, on_update);
+    EXPECT_EQ(scheduled_tasks + 2, writer->get_num_scheduled_tasks(id));
+    // Flush is initiated by another thread, and waits for its task on the write thread
+    auto flush_task = std::async(std::launch::async, [&ft]() { return ft->initFlush(51, std::make_shared<search::FlushToken>()); });
+    while (writer->get_num_scheduled_tasks(id) < scheduled_tasks + 3) {
+        std::this_thread::sleep_for(1ms);
+    }
+    // Must not be added to the batch scheduled before the flush task
+    aw->update(52, upd, 1, {}, on_update);
+    EXPECT_EQ(scheduled_tasks + 4, writer->get_num_scheduled_tasks(id));
+    blocked.countDown();
+    auto task = flush_task.get();
+    ASSERT_TRUE(task);
+    task->run();
+    writer->sync_all();
+    EXPECT_EQ(51u, ft->getFlushedSerialNum());
+    EXPECT_EQ(20, av->getInt(1));
+    {
+        auto flushed = AttributeFactory::createAttribute("flush/a13/snapshot-51/a13", getInt32Config());
+        EXPECT_TRUE(flushed->load());
+        EXPECT_EQ(20, flushed->getInt(1));
+    }
+    Gate committed;
+    aw->forceCommit(52, std::make_shared<GateCallback>(committed));
+    committed.await();
+    EXPECT_EQ(25, av->getInt(1));
+    aw.reset();
+    writer->sync_all();
+}
+
 }
 
 int
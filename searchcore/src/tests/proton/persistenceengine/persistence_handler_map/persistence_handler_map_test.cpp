@@ -19,6 +19,7 @@ struct DummyPersistenceHandler : public IPersistenceHandler {
     void handleUpdate(FeedToken, const storage::spi::Bucket &, storage::spi::Timestamp, DocumentUpdateSP) override {}
     void handleRemove(FeedToken, const storage::spi::Bucket &, storage::spi::Timestamp, const document::DocumentId &) override {}
     void handleRemoveByGid(FeedToken, const storage::spi::Bucket&, storage::spi::Timestamp, std::string_view, const GlobalId&) override { }
+    void handleFeedBatch(const storage::spi::Bucket&, std::vector<FeedBatchEntry>) override { }
     void handleListBuckets(IBucketIdListResultHandler &) override {}
     void handleSetClusterState(const storage::spi::ClusterState &, IGenericResultHandler &) override {}
     void handleSetActiveState(const storage::spi::Bucket &, storage::spi::BucketInfo::ActiveState, std::shared_ptr<IGenericResultHandler>) override {}
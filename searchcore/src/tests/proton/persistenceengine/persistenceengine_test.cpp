@@ -9,6 +9,7 @@
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/persistence/spi/catchresult.h>
 #include <vespa/persistence/spi/documentselection.h>
 #include <vespa/persistence/spi/test.h>
 #include <vespa/searchcore/proton/persistenceengine/ipersistenceengineowner.h>
@@ -36,10 +37,12 @@ using storage::spi::BucketChecksum;
 using storage::spi::BucketIdListResult;
 using storage::spi::BucketInfo;
 using storage::spi::BucketInfoResult;
+using storage::spi::CatchResult;
 using storage::spi::ClusterState;
 using storage::spi::Context;
 using storage::spi::CreateIteratorResult;
 using storage::spi::DocumentSelection;
+using storage::spi::FeedOperation;
 using storage::spi::GetResult;
 using storage::spi::IterateResult;
 using storage::spi::IteratorId;
@@ -230,6 +233,23 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
         handle(token, bucket, timestamp, DocumentId());
     }
 
+    void handleFeedBatch(const Bucket& bucket, std::vector<FeedBatchEntry> entries) override {
+        using FeedOpType = storage::spi::FeedOperation::Type;
+        for (auto & entry : entries) {
+            switch (entry.op.type()) {
+            case FeedOpType::PUT:
+                handlePut(std::move(entry.token), bucket, entry.op.timestamp(), entry.op.steal_document());
+                break;
+            case FeedOpType::UPDATE:
+                handleUpdate(std::move(entry.token), bucket, entry.op.timestamp(), entry.op.steal_update());
+                break;
+            case FeedOpType::REMOVE_IF_FOUND:
+                handleRemove(std::move(entry.token), bucket, entry.op.timestamp(), entry.op.remove_id());
+                break;
+            }
+        }
+    }
+
     void handleListBuckets(IBucketIdListResultHandler &resultHandler) override {
         resultHandler.handle(BucketIdListResult(BucketId::List(bucketList.begin(), bucketList.end())));
     }
@@ -578,6 +598,30 @@ TEST_F("require that remove is NOT rejected if resource limit is reached", Simpl
 }
 
 
+TEST_F("require that batched feed operations are routed to handlers", SimpleFixture)
+{
+    f.hset.handler2.setExistingTimestamp(tstamp3);
+    auto put_done = std::make_unique<CatchResult>();
+    auto upd_done = std::make_unique<CatchResult>();
+    auto bad_done = std::make_unique<CatchResult>();
+    auto put_result = put_done->future_result();
+    auto upd_result = upd_done->future_result();
+    auto bad_result = bad_done->future_result();
+    std::vector<FeedOperation> ops;
+    ops.emplace_back(FeedOperation::make_put(tstamp1, doc1, std::move(put_done)));
+    ops.emplace_back(FeedOperation::make_update(tstamp2, upd2, std::move(upd_done)));
+    ops.emplace_back(FeedOperation::make_remove_if_found(tstamp1, docId3, std::move(bad_done)));
+    f.engine.feedBatchAsync(bucket1, std::move(ops));
+
+    TEST_DO(assertHandler(bucket1, tstamp1, docId1, f.hset.handler1));
+    TEST_DO(assertHandler(bucket1, tstamp2, docId2, f.hset.handler2));
+    EXPECT_FALSE(put_result.get()->hasError());
+    auto ur = upd_result.get();
+    EXPECT_EQUAL(tstamp3, dynamic_cast<const UpdateResult &>(*ur).getExistingTimestamp());
+    EXPECT_EQUAL(Result(Result::ErrorType::PERMANENT_ERROR, "No handler for document type 'type3'"), *bad_result.get());
+}
+
+
 TEST_F("require that listBuckets() is routed to handlers and merged", SimpleFixture)
 {
     f.hset.prepareListBuckets();
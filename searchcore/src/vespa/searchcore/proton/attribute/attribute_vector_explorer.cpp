@@ -108,6 +108,14 @@ convertPostingBaseToSlime(const IPostingListAttributeBase &postingBase, Cursor &
     convertMemoryUsageToSlime(memory_usage.bitvectors, cursor.setObject("bitvectors"));
 }
 
+void
+convert_load_phase_times_to_slime(const AttributeVector::LoadPhaseTimes& load_phase_times, Cursor& object)
+{
+    for (const auto& phase : load_phase_times) {
+        object.setDouble(phase.first, vespalib::to_s(phase.second) * 1000.0);
+    }
+}
+
 void
 convert_config_to_slime(const Config& cfg, bool full, Cursor& object)
 {
@@ -116,6 +124,14 @@ convert_config_to_slime(const Config& cfg, bool full, Cursor& object)
     object.setBool("filter", cfg.getIsFilter());
     object.setBool("paged", cfg.paged());
     if (full) {
+        const auto& memory_policy = cfg.memory_policy();
+        if (!memory_policy.is_default()) {
+            auto& memory = object.setObject("memory_policy");
+            memory.setString("huge_pages", to_string(memory_policy.huge_pages));
+            memory.setLong("page_size", memory_policy.page_size());
+            memory.setString("numa", to_string(memory_policy.numa));
+            memory.setLong("numa_node_mask", memory_policy.numa_node_mask);
+        }
         if (cfg.basicType().type() == BasicType::TENSOR) {
             object.setString("distance_metric", DistanceMetricUtils::to_string(cfg.distance_metric()));
         }
@@ -174,6 +190,9 @@ AttributeVectorExplorer::get_state_helper(const AttributeVector& attr, const ves
             ObjectInserter tensor_inserter(object, "tensor");
             tensor_attr->get_state(tensor_inserter);
         }
+        if (!attr.get_load_phase_times().empty()) {
+            convert_load_phase_times_to_slime(attr.get_load_phase_times(), object.setObject("loadPhasesMs"));
+        }
         convertChangeVectorToSlime(attr, object.setObject("changeVector"));
         object.setLong("committedDocIdLimit", attr.getCommittedDocIdLimit());
         object.setLong("createSerialNum", attr.getCreateSerialNum());
@@ -19,7 +19,9 @@
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
+#include <algorithm>
 #include <future>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.attribute.attribute_writer");
@@ -219,15 +221,6 @@ applyRemoveToAttribute(SerialNum serialNum, DocumentIdT lid,
     attr.clearDoc(lid);
 }
 
-void
-applyUpdateToAttribute(SerialNum serialNum, const FieldUpdate &fieldUpd,
-                       DocumentIdT lid, AttributeVector &attr)
-{
-    ensureLidSpace(serialNum, lid, attr);
-    AttributeUpdater::handleUpdate(attr, lid, fieldUpd);
-    attr.commitIfChangeVectorTooLarge();
-}
-
 void
 applyReplayDone(uint32_t docIdLimit, AttributeVector &attr)
 {
@@ -275,32 +268,128 @@ applyCompactLidSpace(uint32_t wantedLidLimit, SerialNum serialNum, AttributeVect
     }
 }
 
-using AttrUpdates = std::vector<std::pair<AttributeVector *, const FieldUpdate *>>;
+struct BatchedUpdate {
+    SerialNum          serial_num;
+    DocumentIdT        lid;
+    AttributeVector   *attr;
+    const FieldUpdate *update;
+};
 
-struct BatchUpdateTask : public vespalib::Executor::Task {
+}
 
-    BatchUpdateTask(SerialNum serialNum, DocumentIdT lid)
-        : vespalib::Executor::Task(),
-          _serialNum(serialNum),
-          _lid(lid),
-          _onWriteDone()
-    { }
-    ~BatchUpdateTask() override;
+class AttributeWriter::PendingUpdates {
+    std::mutex                   _lock;
+    bool                         _closed;
+    uint64_t                     _scheduled_tasks;
+    std::vector<BatchedUpdate>   _updates;
+    std::vector<OnWriteDoneType> _on_write_done;
+public:
+    // Upper limit of field updates applied by a single task.
+    static constexpr size_t max_updates = 1024;
+
+    PendingUpdates(const std::vector<BatchedUpdate>& updates, const OnWriteDoneType& on_write_done);
+    ~PendingUpdates();
+    void scheduled(uint64_t scheduled_tasks_before, uint64_t scheduled_tasks_after);
+    bool try_add(const std::vector<BatchedUpdate>& updates, const OnWriteDoneType& on_write_done,
+                 const ISequencedTaskExecutor& writer, ExecutorId id);
+    void start(std::vector<BatchedUpdate>& updates, std::vector<OnWriteDoneType>& on_write_done);
+};
 
-    void run() override {
-        for (const auto & update : _updates) {
-            applyUpdateToAttribute(_serialNum, *update.second, _lid, *update.first);
-        }
+AttributeWriter::PendingUpdates::PendingUpdates(const std::vector<BatchedUpdate>& updates, const OnWriteDoneType& on_write_done)
+    : _lock(),
+      _closed(false),
+      _scheduled_tasks(0),
+      _updates(updates),
+      _on_write_done()
+{
+    _on_write_done.emplace_back(on_write_done);
+}
+
+AttributeWriter::PendingUpdates::~PendingUpdates() = default;
+
+void
+AttributeWriter::PendingUpdates::scheduled(uint64_t scheduled_tasks_before, uint64_t scheduled_tasks_after)
+{
+    std::lock_guard guard(_lock);
+    // If another task was scheduled concurrently, its order relative to this task is unknown.
+    if (scheduled_tasks_after != scheduled_tasks_before + 1) {
+        _closed = true;
     }
+    _scheduled_tasks = scheduled_tasks_after;
+}
 
-    SerialNum                        _serialNum;
-    DocumentIdT                      _lid;
-    AttrUpdates                      _updates;
-    vespalib::IDestructorCallback::SP  _onWriteDone;
+bool
+AttributeWriter::PendingUpdates::try_add(const std::vector<BatchedUpdate>& updates, const OnWriteDoneType& on_write_done,
+                                         const ISequencedTaskExecutor& writer, ExecutorId id)
+{
+    std::lock_guard guard(_lock);
+    if (_closed || (_updates.size() + updates.size() > max_updates)) {
+        return false;
+    }
+    size_t old_size = _updates.size();
+    _updates.insert(_updates.end(), updates.begin(), updates.end());
+    _on_write_done.emplace_back(on_write_done);
+    /*
+     * The updates must not pass any task scheduled after this task, e.g. by a flush.
+     * When the count is unchanged after adding, any such task is queued after the
+     * updates were added.
+     */
+    if (writer.get_num_scheduled_tasks(id) != _scheduled_tasks) {
+        _updates.resize(old_size);
+        _on_write_done.pop_back();
+        _closed = true;
+        return false;
+    }
+    return true;
+}
+
+void
+AttributeWriter::PendingUpdates::start(std::vector<BatchedUpdate>& updates, std::vector<OnWriteDoneType>& on_write_done)
+{
+    std::lock_guard guard(_lock);
+    _closed = true;
+    updates.swap(_updates);
+    on_write_done.swap(_on_write_done);
+}
+
+namespace {
+
+/*
+ * Applies field updates gathered across document updates. The updates are
+ * grouped per attribute, keeping their order for each attribute, and the
+ * change vector size of each attribute is checked once per batch.
+ */
+class BatchUpdateTask : public vespalib::Executor::Task {
+    std::shared_ptr<AttributeWriter::PendingUpdates> _pending;
+public:
+    explicit BatchUpdateTask(std::shared_ptr<AttributeWriter::PendingUpdates> pending)
+        : vespalib::Executor::Task(),
+          _pending(std::move(pending))
+    { }
+    ~BatchUpdateTask() override;
+    void run() override;
 };
 
 BatchUpdateTask::~BatchUpdateTask() = default;
 
+void
+BatchUpdateTask::run()
+{
+    std::vector<BatchedUpdate> updates;
+    std::vector<AttributeWriter::OnWriteDoneType> on_write_done;
+    _pending->start(updates, on_write_done);
+    std::stable_sort(updates.begin(), updates.end(),
+                     [](const BatchedUpdate& lhs, const BatchedUpdate& rhs) noexcept { return lhs.attr < rhs.attr; });
+    for (size_t i = 0; i < updates.size(); ++i) {
+        const auto& update = updates[i];
+        ensureLidSpace(update.serial_num, update.lid, *update.attr);
+        AttributeUpdater::handleUpdate(*update.attr, update.lid, *update.update);
+        if ((i + 1 == updates.size()) || (updates[i + 1].attr != update.attr)) {
+            update.attr->commitIfChangeVectorTooLarge();
+        }
+    }
+}
+
 class FieldContext
 {
     std::string   _name;
@@ -658,7 +747,8 @@ AttributeWriter::AttributeWriter(proton::IAttributeManager::SP mgr)
       _shared_executor(_mgr->get_shared_executor()),
       _writeContexts(),
       _hasStructFieldAttribute(false),
-      _attrMap()
+      _attrMap(),
+      _pendingUpdates(_attributeFieldWriter.getNumExecutors())
 {
     setupWriteContexts();
     setupAttributeMapping();
@@ -753,13 +843,8 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
                         const OnWriteDoneType& onWriteDone, IFieldUpdateCallback & onUpdate)
 {
     LOG(debug, "Inspecting update for document %d.", lid);
-    std::vector<std::unique_ptr<BatchUpdateTask>> args;
     uint32_t numExecutors = _attributeFieldWriter.getNumExecutors();
-    args.reserve(numExecutors);
-    for (uint32_t i(0); i < numExecutors; i++) {
-        args.emplace_back(std::make_unique<BatchUpdateTask>(serialNum, lid));
-        args.back()->_updates.reserve((2*upd.getUpdates().size())/numExecutors);
-    }
+    std::vector<std::vector<BatchedUpdate>> args(numExecutors);
 
     for (const auto &fupd : upd.getUpdates()) {
         LOG(debug, "Retrieving guard for attribute vector '%s'.", fupd.getField().getName().c_str());
@@ -783,19 +868,27 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
             _shared_executor.execute(CpuUsage::wrap(std::move(prepare_task), CpuUsage::Category::WRITE));
             _attributeFieldWriter.executeTask(found->second.executor_id, std::move(complete_task));
         } else {
-            args[found->second.executor_id.getId()]->_updates.emplace_back(attrp, &fupd);
+            args[found->second.executor_id.getId()].push_back({serialNum, lid, attrp, &fupd});
             LOG(debug, "About to apply update for docId %u in attribute vector '%s'.", lid, attrp->getName().c_str());
         }
     }
     // NOTE: The lifetime of the field update will be ensured by keeping the document update alive
     // in a operation done context object.
+    // Updates are added to the pending updates for the write thread if the task applying them
+    // has not started yet and no other task has been scheduled on the write thread since,
+    // otherwise a new task is scheduled.
     for (uint32_t id(0); id < args.size(); id++) {
-        if ( ! args[id]->_updates.empty()) {
-            args[id]->_onWriteDone = onWriteDone;
-            _attributeFieldWriter.executeTask(ExecutorId(id), std::move(args[id]));
+        if (args[id].empty()) {
+            continue;
+        }
+        auto& pending = _pendingUpdates[id];
+        if (!pending || !pending->try_add(args[id], onWriteDone, _attributeFieldWriter, ExecutorId(id))) {
+            pending = std::make_shared<PendingUpdates>(args[id], onWriteDone);
+            uint64_t scheduled_tasks_before = _attributeFieldWriter.get_num_scheduled_tasks(ExecutorId(id));
+            _attributeFieldWriter.executeTask(ExecutorId(id), std::make_unique<BatchUpdateTask>(pending));
+            pending->scheduled(scheduled_tasks_before, _attributeFieldWriter.get_num_scheduled_tasks(ExecutorId(id)));
         }
     }
-
 }
 
 void
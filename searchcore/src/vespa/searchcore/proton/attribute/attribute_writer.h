@@ -80,11 +80,18 @@ public:
         AttributeWithInfo(search::AttributeVector* attribute_in,
                           ExecutorId executor_id_in);
     };
+    /**
+     * Field updates to attributes handled by the same write thread, gathered across
+     * document updates until the task applying them starts or another task is
+     * scheduled on the write thread.
+     */
+    class PendingUpdates;
 private:
     using AttrMap = vespalib::hash_map<std::string, AttributeWithInfo>;
     std::vector<WriteContext> _writeContexts;
     bool                      _hasStructFieldAttribute;
     AttrMap                   _attrMap;
+    std::vector<std::shared_ptr<PendingUpdates>> _pendingUpdates;
 
     void setupWriteContexts();
     void setupAttributeMapping();
@@ -27,11 +27,23 @@ extractScoreFeature(const RankProgram &rankProgram)
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
-    : _searchItr(searchItr),
+    : _rankProgram(rankProgram),
+      _searchItr(searchItr),
       _scoreFeature(extractScoreFeature(rankProgram))
 {
 }
 
+void
+DocumentScorer::run_batch(const TaggedHit *begin, const TaggedHit *end)
+{
+    _searchItr.initRange(begin->first.first, end[-1].first.first + 1);
+    for (auto pos = begin; pos != end; ++pos) {
+        _searchItr.unpack(pos->first.first);
+        _rankProgram.add_to_batch(pos->first.first);
+    }
+    _rankProgram.run_batch();
+}
+
 void
 DocumentScorer::score(TaggedHits &hits)
 {
@@ -40,9 +52,22 @@ DocumentScorer::score(TaggedHits &hits)
     }
     auto sort_on_docid = [](const TaggedHit &a, const TaggedHit &b){ return (a.first.first < b.first.first); };
     std::sort(hits.begin(), hits.end(), sort_on_docid);
-    _searchItr.initRange(hits.front().first.first, hits.back().first.first + 1);
-    for (auto &hit: hits) {
-        hit.first.second = doScore(hit.first.first);
+    size_t batch_size = _rankProgram.max_batch_size();
+    if (batch_size < 2) {
+        _searchItr.initRange(hits.front().first.first, hits.back().first.first + 1);
+        for (auto &hit: hits) {
+            hit.first.second = doScore(hit.first.first);
+        }
+        return;
+    }
+    for (size_t begin = 0; begin < hits.size(); begin += batch_size) {
+        size_t end = std::min(begin + batch_size, hits.size());
+        run_batch(hits.data() + begin, hits.data() + end);
+        // rewind to unpack the batched documents again while scoring them
+        _searchItr.initRange(hits[begin].first.first, hits[end - 1].first.first + 1);
+        for (size_t i = begin; i < end; ++i) {
+            hits[i].first.second = doScore(hits[i].first.first);
+        }
     }
 }
 
@@ -16,18 +16,23 @@ namespace proton::matching {
  * Class used to calculate the rank score for a set of documents using
  * a rank program for calculation and a search iterator for unpacking
  * match data. The doScore function must be called with increasing
- * docid.
+ * docid. If the rank program supports batching, the score function
+ * will run batches of documents through it before scoring them.
  */
 class DocumentScorer
 {
+public:
+    using TaggedHit = IMatchLoopCommunicator::TaggedHit;
+    using TaggedHits = IMatchLoopCommunicator::TaggedHits;
+
 private:
+    search::fef::RankProgram &_rankProgram;
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
 
-public:
-    using TaggedHit = IMatchLoopCommunicator::TaggedHit;
-    using TaggedHits = IMatchLoopCommunicator::TaggedHits;
+    void run_batch(const TaggedHit *begin, const TaggedHit *end);
 
+public:
     DocumentScorer(search::fef::RankProgram &rankProgram,
                    search::queryeval::SearchIterator &searchItr);
 
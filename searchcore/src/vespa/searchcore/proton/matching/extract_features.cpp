@@ -40,11 +40,11 @@ struct MyChunk : Runnable {
             const std::pair<uint32_t,uint32_t> *end_in,
             FeatureValues &result_in, const Doom &doom_in)
       : begin(begin_in), end(end_in), result(result_in), doom(doom_in) {}
-    void calculate_features(SearchIterator &search, const FeatureResolver &resolver) {
-        assert(end > begin);
-        assert(resolver.num_features() == result.names.size());
-        search.initRange(begin[0].first, end[-1].first + 1);
-        for (auto pos = begin; pos != end; ++pos) {
+    void calculate_features(SearchIterator &search, const FeatureResolver &resolver,
+                            const std::pair<uint32_t,uint32_t> *first, const std::pair<uint32_t,uint32_t> *last)
+    {
+        search.initRange(first[0].first, last[-1].first + 1);
+        for (auto pos = first; pos != last; ++pos) {
             if (doom.hard_doom()) {
                 return;
             }
@@ -53,21 +53,47 @@ struct MyChunk : Runnable {
             FefUtils::extract_feature_values(resolver, pos->first, dst);
         }
     }
+    void calculate_features(SearchIterator &search, RankProgram &rank_program, const FeatureResolver &resolver) {
+        assert(end > begin);
+        assert(resolver.num_features() == result.names.size());
+        size_t batch_size = rank_program.max_batch_size();
+        if (batch_size < 2) {
+            calculate_features(search, resolver, begin, end);
+            return;
+        }
+        for (auto first = begin; first != end; ) {
+            auto last = first + std::min(batch_size, size_t(end - first));
+            search.initRange(first[0].first, last[-1].first + 1);
+            for (auto pos = first; pos != last; ++pos) {
+                if (doom.hard_doom()) {
+                    return;
+                }
+                search.unpack(pos->first);
+                rank_program.add_to_batch(pos->first);
+            }
+            rank_program.run_batch();
+            calculate_features(search, resolver, first, last);
+            first = last;
+        }
+    }
 };
 
 struct FirstChunk : MyChunk {
     SearchIterator &search;
+    RankProgram &rank_program;
     const FeatureResolver &resolver;
     FirstChunk(const std::pair<uint32_t,uint32_t> *begin_in,
                const std::pair<uint32_t,uint32_t> *end_in,
                FeatureValues &result_in,
                const Doom &doom_in,
                SearchIterator &search_in,
+               RankProgram &rank_program_in,
                const FeatureResolver &resolver_in)
       : MyChunk(begin_in, end_in, result_in, doom_in),
         search(search_in),
+        rank_program(rank_program_in),
         resolver(resolver_in) {}
-    void run() override { calculate_features(search, resolver); }
+    void run() override { calculate_features(search, rank_program, resolver); }
 };
 
 struct LaterChunk : MyChunk {
@@ -81,9 +107,9 @@ struct LaterChunk : MyChunk {
         mtf(mtf_in) {}
     void run() override {
         auto tools = mtf.createMatchTools();
-        tools->setup_match_features();
+        tools->setup_match_features(nullptr);
         FeatureResolver resolver(tools->rank_program().get_seeds(false));
-        calculate_features(tools->search(), resolver);
+        calculate_features(tools->search(), tools->rank_program(), resolver);
     }
 };
 
@@ -115,7 +141,8 @@ ExtractFeatures::get_match_features(const MatchToolsFactory &mtf, const OrderedD
     FeatureValues result;
     mtf.query().set_matching_phase(MatchingPhase::MATCH_FEATURES);
     auto tools = mtf.createMatchTools();
-    tools->setup_match_features();
+    // The thread bundle is idle until the chunks are run below
+    tools->setup_match_features(&thread_bundle);
     FeatureResolver resolver(tools->rank_program().get_seeds(false));
     result.names = FefUtils::extract_feature_names(resolver, mtf.get_feature_rename_map());
     result.values.resize(result.names.size() * docs.size());
@@ -131,7 +158,7 @@ ExtractFeatures::get_match_features(const MatchToolsFactory &mtf, const OrderedD
             break;
         }
         if (i == 0) {
-            chunks.push_back(std::make_unique<FirstChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), tools->search(), resolver));
+            chunks.push_back(std::make_unique<FirstChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), tools->search(), tools->rank_program(), resolver));
         } else {
             chunks.push_back(std::make_unique<LaterChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), mtf));
         }
@@ -78,7 +78,8 @@ extractDiversityParams(const RankSetup &rankSetup, const Properties &rankPropert
 } // namespace proton::matching::<unnamed>
 
 void
-MatchTools::setup(std::unique_ptr<RankProgram> rank_program, ExecutionProfiler *profiler, double termwise_limit)
+MatchTools::setup(std::unique_ptr<RankProgram> rank_program, ExecutionProfiler *profiler, double termwise_limit,
+                  vespalib::ThreadBundle *thread_bundle)
 {
     if (_search) {
         _match_data->soft_reset();
@@ -87,7 +88,7 @@ MatchTools::setup(std::unique_ptr<RankProgram> rank_program, ExecutionProfiler *
     HandleRecorder recorder;
     {
         HandleRecorder::Binder bind(recorder);
-        _rank_program->setup(*_match_data, _queryEnv, _featureOverrides, profiler);
+        _rank_program->setup(*_match_data, _queryEnv, _featureOverrides, profiler, thread_bundle);
     }
     bool can_reuse_search = (allow_reuse_search() &&
                              _search && !_search_has_changed &&
@@ -145,9 +146,9 @@ MatchTools::setup_second_phase(ExecutionProfiler *profiler)
 }
 
 void
-MatchTools::setup_match_features()
+MatchTools::setup_match_features(vespalib::ThreadBundle *thread_bundle)
 {
-    setup(_rankSetup.create_match_program(), nullptr);
+    setup(_rankSetup.create_match_program(), nullptr, 1.0, thread_bundle);
 }
 
 void
@@ -54,7 +54,8 @@ private:
     std::unique_ptr<SearchIterator>  _search;
     HandleRecorder::HandleMap        _used_handles;
     bool                             _search_has_changed;
-    void setup(std::unique_ptr<RankProgram>, ExecutionProfiler *profiler, double termwise_limit = 1.0);
+    void setup(std::unique_ptr<RankProgram>, ExecutionProfiler *profiler, double termwise_limit = 1.0,
+               vespalib::ThreadBundle *thread_bundle = nullptr);
 public:
     using UP = std::unique_ptr<MatchTools>;
     MatchTools(const MatchTools &) = delete;
@@ -80,7 +81,8 @@ public:
     void tag_search_as_changed() { _search_has_changed = true; }
     void setup_first_phase(ExecutionProfiler *profiler);
     void setup_second_phase(ExecutionProfiler *profiler);
-    void setup_match_features();
+    // The thread bundle (if any) must be idle; it is used to calculate query-level features
+    void setup_match_features(vespalib::ThreadBundle *thread_bundle);
     void setup_summary();
     void setup_dump();
 
@@ -4,6 +4,7 @@
 #include "i_document_retriever.h"
 #include "resulthandler.h"
 #include <vespa/searchcore/proton/common/feedtoken.h>
+#include <vespa/persistence/spi/feed_operation.h>
 
 namespace document {
     class Document;
@@ -30,6 +31,17 @@ public:
     using SP = std::shared_ptr<IPersistenceHandler>;
     // Note that you can not move away the handlers in the vector.
     using RetrieversSP = std::shared_ptr<std::vector<IDocumentRetriever::SP> >;
+
+    /**
+     * A validated feed operation together with the token used to signal its completion.
+     */
+    struct FeedBatchEntry {
+        FeedToken                    token;
+        storage::spi::FeedOperation  op;
+        FeedBatchEntry(FeedToken token_in, storage::spi::FeedOperation op_in) noexcept
+            : token(std::move(token_in)), op(std::move(op_in))
+        {}
+    };
     IPersistenceHandler(const IPersistenceHandler &) = delete;
     IPersistenceHandler & operator = (const IPersistenceHandler &) = delete;
 
@@ -52,6 +64,11 @@ public:
     virtual void handleRemoveByGid(FeedToken token, const storage::spi::Bucket &bucket,
                                    storage::spi::Timestamp timestamp,
                                    std::string_view doc_type, const document::GlobalId& gid) = 0;
+    /**
+     * Handles a batch of put, update and remove operations against the same bucket.
+     * Operations are applied in the given order.
+     */
+    virtual void handleFeedBatch(const storage::spi::Bucket &bucket, std::vector<FeedBatchEntry> entries) = 0;
 
     virtual void handleListBuckets(IBucketIdListResultHandler &resultHandler) = 0;
     virtual void handleSetClusterState(const storage::spi::ClusterState &calc, IGenericResultHandler &resultHandler) = 0;
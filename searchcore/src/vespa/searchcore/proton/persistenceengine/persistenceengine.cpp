@@ -347,29 +347,41 @@ PersistenceEngine::getBucketInfo(const Bucket& b) const
 }
 
 
-void
-PersistenceEngine::putAsync(const Bucket &bucket, Timestamp ts, storage::spi::DocumentSP doc, OperationComplete::UP onComplete)
+IPersistenceHandler *
+PersistenceEngine::handler_for_put(const ReadGuard & guard, const Bucket &bucket, Timestamp ts, const Document &doc, OperationComplete &onComplete) const
 {
     if (!_writeFilter.acceptWriteOperation()) {
         IResourceWriteFilter::State state = _writeFilter.getAcceptState();
         if (!state.acceptWriteOperation()) {
-            return onComplete->onComplete(std::make_unique<Result>(Result::ErrorType::RESOURCE_EXHAUSTED,
-                    fmt("Put operation rejected for document '%s': '%s'", doc->getId().toString().c_str(), state.message().c_str())));
+            onComplete.onComplete(std::make_unique<Result>(Result::ErrorType::RESOURCE_EXHAUSTED,
+                    fmt("Put operation rejected for document '%s': '%s'", doc.getId().toString().c_str(), state.message().c_str())));
+            return nullptr;
         }
     }
-    ReadGuard rguard(_rwMutex);
-    DocTypeName docType(doc->getType());
+    DocTypeName docType(doc.getType());
     LOG(spam, "putAsync(%s, %" PRIu64 ", (\"%s\", \"%s\"))", bucket.toString().c_str(), static_cast<uint64_t>(ts.getValue()),
-        docType.toString().c_str(), doc->getId().toString().c_str());
-    if (!doc->getId().hasDocType()) {
-        return onComplete->onComplete(std::make_unique<Result>(Result::ErrorType::PERMANENT_ERROR,
-                    fmt("Old id scheme not supported in elastic mode (%s)", doc->getId().toString().c_str())));
+        docType.toString().c_str(), doc.getId().toString().c_str());
+    if (!doc.getId().hasDocType()) {
+        onComplete.onComplete(std::make_unique<Result>(Result::ErrorType::PERMANENT_ERROR,
+                    fmt("Old id scheme not supported in elastic mode (%s)", doc.getId().toString().c_str())));
+        return nullptr;
     }
-    IPersistenceHandler * handler = getHandler(rguard, bucket.getBucketSpace(), docType);
+    IPersistenceHandler * handler = getHandler(guard, bucket.getBucketSpace(), docType);
     if (!handler) {
-        return onComplete->onComplete(std::make_unique<Result>(Result::ErrorType::PERMANENT_ERROR,
+        onComplete.onComplete(std::make_unique<Result>(Result::ErrorType::PERMANENT_ERROR,
                     fmt("No handler for document type '%s'", docType.toString().c_str())));
     }
+    return handler;
+}
+
+void
+PersistenceEngine::putAsync(const Bucket &bucket, Timestamp ts, storage::spi::DocumentSP doc, OperationComplete::UP onComplete)
+{
+    ReadGuard rguard(_rwMutex);
+    IPersistenceHandler * handler = handler_for_put(rguard, bucket, ts, *doc, *onComplete);
+    if (!handler) {
+        return;
+    }
     auto transportContext = std::make_shared<AsyncTransportContext>(1, std::move(onComplete));
     handler->handlePut(feedtoken::make(std::move(transportContext)), bucket, ts, std::move(doc));
 }
@@ -412,22 +424,33 @@ PersistenceEngine::removeAsyncMulti(const Bucket& b, std::vector<storage::spi::I
     }
 }
 
-void
-PersistenceEngine::removeAsyncSingle(const Bucket& b, Timestamp t, const DocumentId& id, OperationComplete::UP onComplete)
+IPersistenceHandler *
+PersistenceEngine::handler_for_remove(const ReadGuard & guard, const Bucket &b, Timestamp t, const DocumentId &id, OperationComplete &onComplete) const
 {
-    ReadGuard rguard(_rwMutex);
     LOG(spam, "remove(%s, %" PRIu64 ", \"%s\")", b.toString().c_str(),
         static_cast<uint64_t>(t.getValue()), id.toString().c_str());
     if (!id.hasDocType()) {
-        return onComplete->onComplete(std::make_unique<RemoveResult>(Result::ErrorType::PERMANENT_ERROR,
+        onComplete.onComplete(std::make_unique<RemoveResult>(Result::ErrorType::PERMANENT_ERROR,
                     fmt("Old id scheme not supported in elastic mode (%s)", id.toString().c_str())));
+        return nullptr;
     }
     DocTypeName docType(id.getDocType());
-    IPersistenceHandler * handler = getHandler(rguard, b.getBucketSpace(), docType);
+    IPersistenceHandler * handler = getHandler(guard, b.getBucketSpace(), docType);
     if (!handler) {
-        return onComplete->onComplete(std::make_unique<RemoveResult>(Result::ErrorType::PERMANENT_ERROR,
+        onComplete.onComplete(std::make_unique<RemoveResult>(Result::ErrorType::PERMANENT_ERROR,
                     fmt("No handler for document type '%s'", docType.toString().c_str())));
     }
+    return handler;
+}
+
+void
+PersistenceEngine::removeAsyncSingle(const Bucket& b, Timestamp t, const DocumentId& id, OperationComplete::UP onComplete)
+{
+    ReadGuard rguard(_rwMutex);
+    IPersistenceHandler * handler = handler_for_remove(rguard, b, t, id, *onComplete);
+    if (!handler) {
+        return;
+    }
     auto transportContext = std::make_shared<AsyncTransportContext>(1, std::move(onComplete));
     handler->handleRemove(feedtoken::make(std::move(transportContext)), b, t, id);
 }
@@ -453,55 +476,105 @@ PersistenceEngine::removeByGidAsync(const Bucket& b, std::vector<storage::spi::D
     }
 }
 
-void
-PersistenceEngine::updateAsync(const Bucket& b, Timestamp t, DocumentUpdate::SP upd, OperationComplete::UP onComplete)
+IPersistenceHandler *
+PersistenceEngine::handler_for_update(const ReadGuard & guard, const Bucket &b, Timestamp t, DocumentUpdate &upd, OperationComplete &onComplete) const
 {
     if (!_writeFilter.acceptWriteOperation()) {
         IResourceWriteFilter::State state = _writeFilter.getAcceptState();
-        if (!state.acceptWriteOperation() && document::FeedRejectHelper::mustReject(*upd)) {
-            return onComplete->onComplete(std::make_unique<UpdateResult>(Result::ErrorType::RESOURCE_EXHAUSTED,
-                    fmt("Update operation rejected for document '%s': '%s'", upd->getId().toString().c_str(), state.message().c_str())));
+        if (!state.acceptWriteOperation() && document::FeedRejectHelper::mustReject(upd)) {
+            onComplete.onComplete(std::make_unique<UpdateResult>(Result::ErrorType::RESOURCE_EXHAUSTED,
+                    fmt("Update operation rejected for document '%s': '%s'", upd.getId().toString().c_str(), state.message().c_str())));
+            return nullptr;
         }
     }
     try {
-        upd->eagerDeserialize();
+        upd.eagerDeserialize();
     } catch (document::FieldNotFoundException & e) {
-        return onComplete->onComplete(std::make_unique<UpdateResult>(Result::ErrorType::TRANSIENT_ERROR,
+        onComplete.onComplete(std::make_unique<UpdateResult>(Result::ErrorType::TRANSIENT_ERROR,
                     fmt("Update operation rejected for document '%s' of type '%s': 'Field not found'",
-                        upd->getId().toString().c_str(), upd->getType().getName().c_str())));
+                        upd.getId().toString().c_str(), upd.getType().getName().c_str())));
+        return nullptr;
     } catch (document::DocumentTypeNotFoundException & e) {
-        return onComplete->onComplete(std::make_unique<UpdateResult>(Result::ErrorType::TRANSIENT_ERROR,
+        onComplete.onComplete(std::make_unique<UpdateResult>(Result::ErrorType::TRANSIENT_ERROR,
                     fmt("Update operation rejected for document '%s' of type '%s'.",
-                        upd->getId().toString().c_str(), e.getDocumentTypeName().c_str())));
-
+                        upd.getId().toString().c_str(), e.getDocumentTypeName().c_str())));
+        return nullptr;
     } catch (document::WrongTensorTypeException &e) {
-        return onComplete->onComplete(std::make_unique<UpdateResult>(Result::ErrorType::TRANSIENT_ERROR,
+        onComplete.onComplete(std::make_unique<UpdateResult>(Result::ErrorType::TRANSIENT_ERROR,
                     fmt("Update operation rejected for document '%s' of type '%s': 'Wrong tensor type: %s'",
-                        upd->getId().toString().c_str(), upd->getType().getName().c_str(), e.getMessage().c_str())));
+                        upd.getId().toString().c_str(), upd.getType().getName().c_str(), e.getMessage().c_str())));
+        return nullptr;
     }
-    ReadGuard rguard(_rwMutex);
-    DocTypeName docType(upd->getType());
+    DocTypeName docType(upd.getType());
     LOG(spam, "update(%s, %" PRIu64 ", (\"%s\", \"%s\"), createIfNonExistent='%s')",
         b.toString().c_str(), static_cast<uint64_t>(t.getValue()), docType.toString().c_str(),
-        upd->getId().toString().c_str(), (upd->getCreateIfNonExistent() ? "true" : "false"));
-    if (!upd->getId().hasDocType()) {
-        return onComplete->onComplete(std::make_unique<UpdateResult>(Result::ErrorType::PERMANENT_ERROR,
-                    fmt("Old id scheme not supported in elastic mode (%s)", upd->getId().toString().c_str())));
-    }
-    if (upd->getId().getDocType() != docType.getName()) {
-        return onComplete->onComplete(std::make_unique<UpdateResult>(Result::ErrorType::PERMANENT_ERROR,
-                    fmt("Update operation rejected due to bad id (%s, %s)", upd->getId().toString().c_str(), docType.getName().c_str())));
+        upd.getId().toString().c_str(), (upd.getCreateIfNonExistent() ? "true" : "false"));
+    if (!upd.getId().hasDocType()) {
+        onComplete.onComplete(std::make_unique<UpdateResult>(Result::ErrorType::PERMANENT_ERROR,
+                    fmt("Old id scheme not supported in elastic mode (%s)", upd.getId().toString().c_str())));
+        return nullptr;
+    }
+    if (upd.getId().getDocType() != docType.getName()) {
+        onComplete.onComplete(std::make_unique<UpdateResult>(Result::ErrorType::PERMANENT_ERROR,
+                    fmt("Update operation rejected due to bad id (%s, %s)", upd.getId().toString().c_str(), docType.getName().c_str())));
+        return nullptr;
+    }
+    IPersistenceHandler * handler = getHandler(guard, b.getBucketSpace(), docType);
+    if (handler == nullptr) {
+        onComplete.onComplete(std::make_unique<UpdateResult>(Result::ErrorType::PERMANENT_ERROR,
+                    fmt("No handler for document type '%s'", docType.toString().c_str())));
     }
-    IPersistenceHandler * handler = getHandler(rguard, b.getBucketSpace(), docType);
+    return handler;
+}
 
+void
+PersistenceEngine::updateAsync(const Bucket& b, Timestamp t, DocumentUpdate::SP upd, OperationComplete::UP onComplete)
+{
+    ReadGuard rguard(_rwMutex);
+    IPersistenceHandler * handler = handler_for_update(rguard, b, t, *upd, *onComplete);
     if (handler == nullptr) {
-        return onComplete->onComplete(std::make_unique<UpdateResult>(Result::ErrorType::PERMANENT_ERROR,
-                    fmt("No handler for document type '%s'", docType.toString().c_str())));
+        return;
     }
     auto transportContext = std::make_shared<AsyncTransportContext>(1, std::move(onComplete));
     handler->handleUpdate(feedtoken::make(std::move(transportContext)), b, t, std::move(upd));
 }
 
+void
+PersistenceEngine::feedBatchAsync(const Bucket& b, std::vector<storage::spi::FeedOperation> ops)
+{
+    using FeedOpType = storage::spi::FeedOperation::Type;
+    ReadGuard rguard(_rwMutex);
+    // Operations are grouped per document type, keeping their relative order within each group.
+    std::vector<std::pair<IPersistenceHandler *, std::vector<IPersistenceHandler::FeedBatchEntry>>> batches;
+    for (auto & op : ops) {
+        IPersistenceHandler * handler = nullptr;
+        switch (op.type()) {
+        case FeedOpType::PUT:
+            handler = handler_for_put(rguard, b, op.timestamp(), *op.document(), op.on_complete());
+            break;
+        case FeedOpType::UPDATE:
+            handler = handler_for_update(rguard, b, op.timestamp(), *op.update(), op.on_complete());
+            break;
+        case FeedOpType::REMOVE_IF_FOUND:
+            handler = handler_for_remove(rguard, b, op.timestamp(), op.remove_id(), op.on_complete());
+            break;
+        }
+        if (handler == nullptr) {
+            continue; // Already completed with an error
+        }
+        auto batch = std::find_if(batches.begin(), batches.end(), [handler](const auto & entry) { return entry.first == handler; });
+        if (batch == batches.end()) {
+            batch = batches.emplace(batches.end(), handler, std::vector<IPersistenceHandler::FeedBatchEntry>());
+            batch->second.reserve(ops.size());
+        }
+        auto transportContext = std::make_shared<AsyncTransportContext>(1, op.steal_on_complete());
+        batch->second.emplace_back(feedtoken::make(std::move(transportContext)), std::move(op));
+    }
+    for (auto & [handler, entries] : batches) {
+        handler->handleFeedBatch(b, std::move(entries));
+    }
+}
+
 
 PersistenceEngine::GetResult
 PersistenceEngine::get(const Bucket& b, const document::FieldSet& fields, const DocumentId& did, Context& context) const
@@ -89,6 +89,17 @@ private:
     void saveClusterState(BucketSpace bucketSpace, const ClusterState &calc);
     ClusterState::SP savedClusterState(BucketSpace bucketSpace) const;
     std::shared_ptr<BucketExecutor> get_bucket_executor() noexcept { return _bucket_executor.lock(); }
+    // The handler_for_* functions return the handler to feed an operation to, or nullptr after
+    // having completed the operation with an error.
+    IPersistenceHandler * handler_for_put(const ReadGuard & guard, const Bucket &bucket, Timestamp ts,
+                                          const document::Document &doc,
+                                          OperationComplete &onComplete) const;
+    IPersistenceHandler * handler_for_update(const ReadGuard & guard, const Bucket &bucket, Timestamp ts,
+                                             document::DocumentUpdate &upd,
+                                             OperationComplete &onComplete) const;
+    IPersistenceHandler * handler_for_remove(const ReadGuard & guard, const Bucket &bucket, Timestamp ts,
+                                             const document::DocumentId &id,
+                                             OperationComplete &onComplete) const;
     void removeAsyncSingle(const Bucket&, Timestamp, const document::DocumentId &id, OperationComplete::UP);
     void removeAsyncMulti(const Bucket&, std::vector<storage::spi::IdAndTimestamp> ids, OperationComplete::UP);
 public:
@@ -111,6 +122,7 @@ public:
     void removeAsync(const Bucket&, std::vector<storage::spi::IdAndTimestamp> ids, OperationComplete::UP) override;
     void removeByGidAsync(const Bucket&, std::vector<storage::spi::DocTypeGidAndTimestamp> ids, std::unique_ptr<OperationComplete>) override;
     void updateAsync(const Bucket&, Timestamp, storage::spi::DocumentUpdateSP, OperationComplete::UP) override;
+    void feedBatchAsync(const Bucket&, std::vector<storage::spi::FeedOperation> ops) override;
     GetResult get(const Bucket&, const document::FieldSet&, const document::DocumentId&, Context&) const override;
     CreateIteratorResult
     createIterator(const Bucket &bucket, FieldSetSP, const Selection &, IncludedVersions, Context &context) override;
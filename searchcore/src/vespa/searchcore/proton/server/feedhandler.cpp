@@ -756,6 +756,17 @@ FeedHandler::handleOperation(FeedToken token, FeedOperation::UP op)
     }));
 }
 
+void
+FeedHandler::handleOperations(std::vector<std::pair<FeedToken, FeedOperation::UP>> ops)
+{
+    // See handleOperation() regarding use of blocking_master_execute().
+    _writeService.blocking_master_execute(makeLambdaTask([this, ops = std::move(ops)]() mutable {
+        for (auto & [token, op] : ops) {
+            doHandleOperation(std::move(token), std::move(op));
+        }
+    }));
+}
+
 IDocumentMoveHandler::MoveResult
 FeedHandler::handleMove(MoveOperation &op, vespalib::IDestructorCallback::SP moveDoneCtx)
 {
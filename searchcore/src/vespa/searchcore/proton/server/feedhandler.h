@@ -238,6 +238,11 @@ public:
 
     void performOperation(FeedToken token, FeedOperationUP op);
     void handleOperation(FeedToken token, FeedOperationUP op);
+    /**
+     * Handles a batch of external feed operations in a single master thread task, so that the
+     * operations are appended to the transaction log and committed together.
+     */
+    void handleOperations(std::vector<std::pair<FeedToken, FeedOperationUP>> ops);
 
     MoveResult handleMove(MoveOperation &op, std::shared_ptr<vespalib::IDestructorCallback> moveDoneCtx) override;
     void heartBeat() override;
@@ -61,6 +61,31 @@ PersistenceHandlerProxy::handleRemoveByGid(FeedToken token, const storage::spi::
     _feedHandler.handleOperation(std::move(token), std::move(op));
 }
 
+void
+PersistenceHandlerProxy::handleFeedBatch(const Bucket &bucket, std::vector<FeedBatchEntry> entries)
+{
+    using FeedOpType = storage::spi::FeedOperation::Type;
+    document::BucketId bucketId = bucket.getBucketId().stripUnused();
+    std::vector<std::pair<FeedToken, FeedOperation::UP>> ops;
+    ops.reserve(entries.size());
+    for (auto & entry : entries) {
+        FeedOperation::UP op;
+        switch (entry.op.type()) {
+        case FeedOpType::PUT:
+            op = std::make_unique<PutOperation>(bucketId, entry.op.timestamp(), entry.op.steal_document());
+            break;
+        case FeedOpType::UPDATE:
+            op = std::make_unique<UpdateOperation>(bucketId, entry.op.timestamp(), entry.op.steal_update());
+            break;
+        case FeedOpType::REMOVE_IF_FOUND:
+            op = std::make_unique<RemoveOperationWithDocId>(bucketId, entry.op.timestamp(), entry.op.remove_id());
+            break;
+        }
+        ops.emplace_back(std::move(entry.token), std::move(op));
+    }
+    _feedHandler.handleOperations(std::move(ops));
+}
+
 void
 PersistenceHandlerProxy::handleListBuckets(IBucketIdListResultHandler &resultHandler)
 {
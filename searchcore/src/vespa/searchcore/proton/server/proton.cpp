@@ -357,7 +357,8 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     }
     _protonDiskLayout = std::make_unique<ProtonDiskLayout>(_transport, protonConfig.basedir, protonConfig.tlsspec);
     std::filesystem::current_path(std::filesystem::path(protonConfig.basedir));
-    vespalib::alloc::MmapFileAllocatorFactory::instance().setup(protonConfig.basedir + "/swapdirs");
+    vespalib::alloc::MmapFileAllocatorFactory::instance().setup(protonConfig.basedir + "/swapdirs",
+                                                                protonConfig.attribute.paged.hotlimit);
     _tls->start(_transport, hwInfo.cpu().cores());
     _flushEngine = std::make_unique<FlushEngine>(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
                                                  strategy, flush.maxconcurrent, vespalib::from_s(flush.idleinterval));
@@ -409,6 +410,11 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _sessionPruneHandle = _scheduler->scheduleAtFixedRate(makeLambdaTask([&]() {
         _sessionManager->pruneTimedOutSessions(vespalib::steady_clock::now(), _shared_service->shared());
     }), pruneSessionsInterval, pruneSessionsInterval);
+    if (vespalib::alloc::MmapFileAllocatorFactory::instance().has_tiers()) {
+        _pagedMemoryTierHandle = _scheduler->scheduleAtFixedRate(makeLambdaTask([]() {
+            vespalib::alloc::MmapFileAllocatorFactory::instance().update_tiers();
+        }), 5s, 5s);
+    }
     _isInitializing = false;
     _protonConfigurer.setAllowReconfig(true);
     _initComplete = true;
@@ -498,6 +504,7 @@ Proton::~Proton()
         _diskMemUsageSampler->notifier().removeDiskMemUsageListener(_memoryFlushConfigUpdater.get());
     }
     _sessionPruneHandle.reset();
+    _pagedMemoryTierHandle.reset();
     if (_diskMemUsageSampler) {
         _diskMemUsageSampler->close();
     }
@@ -117,6 +117,7 @@ private:
     std::unique_ptr<SharedThreadingService>   _shared_service;
     std::unique_ptr<matching::SessionManager> _sessionManager;
     IScheduledExecutor::Handle                _sessionPruneHandle;
+    IScheduledExecutor::Handle                _pagedMemoryTierHandle;
     std::unique_ptr<ScheduledForwardExecutor> _scheduler;
     vespalib::eval::CompileCache::ExecutorBinding::UP _compile_cache_executor_binding;
     matching::QueryLimiter          _queryLimiter;
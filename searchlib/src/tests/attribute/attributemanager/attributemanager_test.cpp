@@ -252,6 +252,16 @@ TEST("require that config can be converted")
         a.paged = true;
         EXPECT_TRUE(CC::convert(a).paged());
     }
+    { // memory policy
+        using MemoryPolicy = vespalib::alloc::MemoryPolicy;
+        CACA a;
+        EXPECT_TRUE(CC::convert(a).memory_policy().is_default());
+        a.memory.hugepages = AttributesConfig::Attribute::Memory::Hugepages::EXPLICIT_2M;
+        a.memory.numa = AttributesConfig::Attribute::Memory::Numa::INTERLEAVE;
+        a.memory.numanodes = 3;
+        EXPECT_TRUE(MemoryPolicy(MemoryPolicy::HugePages::EXPLICIT_2M, MemoryPolicy::Numa::INTERLEAVE, 3) ==
+                    CC::convert(a).memory_policy());
+    }
     { // tensor
         CACA a;
         a.datatype = CACAD::TENSOR;
@@ -2,6 +2,9 @@
 
 #include <vespa/searchlib/attribute/enumstore.hpp>
 #include <vespa/searchlib/attribute/enum_store_loaders.h>
+#include <vespa/searchlib/attribute/loadedenumvalue.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/test/memory_allocator_observer.h>
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -1006,6 +1009,41 @@ TYPED_TEST(EnumStoreDictionaryTest, compact_worst_works)
     EXPECT_EQ(exp_values, values);
 }
 
+
+using search::attribute::LoadedEnumAttributeVector;
+
+void
+expect_parallel_sort_by_enum(uint32_t num_enums, uint32_t skewed_percent)
+{
+    SCOPED_TRACE("num_enums=" + std::to_string(num_enums) + ", skewed_percent=" + std::to_string(skewed_percent));
+    vespalib::ThreadStackExecutor executor(4);
+    vespalib::Rand48 rnd;
+    rnd.srand48(42);
+    LoadedEnumAttributeVector loaded;
+    for (uint32_t docid = 0; docid < 2000000; ++docid) {
+        uint32_t e = (static_cast<uint32_t>(rnd.lrand48() % 100) < skewed_percent) ? 0 : rnd.lrand48() % num_enums;
+        loaded.emplace_back(e, docid, 1 + docid % 7);
+    }
+    auto expected = loaded;
+    search::attribute::sortLoadedByEnum(expected);
+    search::attribute::sortLoadedByEnum(loaded, &executor);
+    ASSERT_EQ(expected.size(), loaded.size());
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        ASSERT_EQ(expected[i].getEnum(), loaded[i].getEnum());
+        ASSERT_EQ(expected[i].getDocId(), loaded[i].getDocId());
+        ASSERT_EQ(expected[i].getWeight(), loaded[i].getWeight());
+    }
+}
+
+TEST(LoadedEnumSortTest, parallel_sort_by_enum_gives_same_result_as_serial_sort)
+{
+    expect_parallel_sort_by_enum(1000, 0);
+    expect_parallel_sort_by_enum(1000, 50);
+    expect_parallel_sort_by_enum(3, 0);
+    expect_parallel_sort_by_enum(1, 0);
+    expect_parallel_sort_by_enum(1000, 95);
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,74 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/frame_of_reference_estimate.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+using search::attribute::estimate_frame_of_reference_bytes;
+using search::attribute::frame_of_reference_block_size;
+
+template <typename T>
+class FrameOfReferenceEstimateTest : public ::testing::Test {
+protected:
+    static constexpr size_t block_header_bytes = sizeof(T) + 1;
+
+    static size_t estimate(const std::vector<T>& values) {
+        return estimate_frame_of_reference_bytes<T>(values);
+    }
+};
+
+using IntegerTypes = ::testing::Types<int8_t, int16_t, int32_t, int64_t>;
+TYPED_TEST_SUITE(FrameOfReferenceEstimateTest, IntegerTypes);
+
+TYPED_TEST(FrameOfReferenceEstimateTest, empty_vector)
+{
+    EXPECT_EQ(0u, this->estimate({}));
+}
+
+TYPED_TEST(FrameOfReferenceEstimateTest, constant_blocks_use_no_words)
+{
+    std::vector<TypeParam> values(1000, 42);
+    // 7 full blocks and one partial block
+    EXPECT_EQ(8 * this->block_header_bytes, this->estimate(values));
+}
+
+TYPED_TEST(FrameOfReferenceEstimateTest, offsets_are_packed_with_bits_needed_by_block)
+{
+    std::vector<TypeParam> values;
+    for (size_t i = 0; i < frame_of_reference_block_size; ++i) {
+        values.push_back(static_cast<TypeParam>(-5 + int(i % 16))); // 4 bits
+    }
+    for (size_t i = 0; i < 10; ++i) {
+        values.push_back(static_cast<TypeParam>(i % 2)); // 1 bit
+    }
+    EXPECT_EQ(2 * this->block_header_bytes + (8 + 1) * sizeof(uint64_t), this->estimate(values));
+}
+
+TYPED_TEST(FrameOfReferenceEstimateTest, full_value_range_uses_full_width)
+{
+    using Limits = std::numeric_limits<TypeParam>;
+    std::mt19937_64 gen(17);
+    std::vector<TypeParam> values;
+    for (size_t i = 0; i < frame_of_reference_block_size - 2; ++i) {
+        values.push_back(static_cast<TypeParam>(gen()));
+    }
+    values.push_back(Limits::min());
+    values.push_back(Limits::max());
+    EXPECT_EQ(this->block_header_bytes + values.size() * sizeof(TypeParam), this->estimate(values));
+}
+
+TEST(FrameOfReferenceEstimateTest, timestamps_within_a_month_are_compressed)
+{
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int64_t> dist(0, 30 * 24 * 3600);
+    std::vector<int64_t> values;
+    for (size_t i = 0; i < 10000; ++i) {
+        values.push_back(1700000000 + dist(gen));
+    }
+    size_t uncompressed_bytes = values.size() * sizeof(int64_t);
+    EXPECT_GT(double(uncompressed_bytes) / estimate_frame_of_reference_bytes<int64_t>(values), 2.0);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -158,6 +158,14 @@ public:
         _attr->commit();
         _attr->incGeneration();
     }
+
+    bool considerCompact() {
+        CompactionStrategy compaction_strategy;
+        bool result = _mvMapping->consider_compact(compaction_strategy);
+        _attr->commit();
+        _attr->incGeneration();
+        return result;
+    }
 };
 
 using IntMappingTest = MappingTestBase<int>;
@@ -372,4 +380,29 @@ TEST_F(CompactionIntMappingTest, test_that_compaction_works)
     EXPECT_LT(bufferCountAfter, bufferCountBefore);
 }
 
+TEST_F(CompactionIntMappingTest, test_that_compaction_is_spread_across_multiple_steps)
+{
+    using MvMapping = search::attribute::MultiValueMapping<int>;
+    setup(3, 64, 512, 129);
+    uint32_t num_docs = 3 * MvMapping::min_compaction_step_docs - 100;
+    addRandomDocs(num_docs);
+    for (uint32_t docId = 0; docId < num_docs; docId += 2) {
+        clearDoc(docId);
+    }
+    _mvMapping->set_compaction_spec(CompactionSpec(true, false));
+    uint32_t steps = 0;
+    while (considerCompact()) {
+        ++steps;
+        if (!_mvMapping->compaction_in_progress()) {
+            break;
+        }
+        // Documents changed while compaction is in progress are not lost
+        clearDoc(num_docs - steps);
+        checkRefMapping();
+    }
+    EXPECT_EQ(3u, steps);
+    EXPECT_FALSE(_mvMapping->compaction_in_progress());
+    checkRefMapping();
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -287,6 +287,173 @@ TEST_P(PostingStoreTest, require_that_compaction_is_suppressed)
     EXPECT_TRUE(suppressed_compaction);
 }
 
+class FrozenPostingListTest : public ::testing::Test
+{
+protected:
+    using MyNoWeightPostingStore = PostingStore<vespalib::btree::BTreeNoLeafData>;
+    GenerationHandler      _gen_handler;
+    Config                 _config;
+    Status                 _status;
+    MyValueStore           _value_store;
+    MyNoWeightPostingStore _store;
+
+    FrozenPostingListTest();
+    ~FrozenPostingListTest() override;
+
+    void inc_generation()
+    {
+        _value_store.freeze_dictionary();
+        _store.freeze();
+        _value_store.assign_generation(_gen_handler.getCurrentGeneration());
+        _store.assign_generation(_gen_handler.getCurrentGeneration());
+        _gen_handler.incGeneration();
+        _value_store.reclaim_memory(_gen_handler.get_oldest_used_generation());
+        _store.reclaim_memory(_gen_handler.get_oldest_used_generation());
+    }
+
+    void add_docs(int key, uint32_t start_doc, uint32_t end_doc)
+    {
+        std::vector<MyNoWeightPostingStore::KeyDataType> additions;
+        std::vector<MyNoWeightPostingStore::KeyType> removals;
+        for (uint32_t doc = start_doc; doc < end_doc; ++doc) {
+            additions.emplace_back(doc, vespalib::btree::BTreeNoLeafData());
+        }
+        _value_store.get_dictionary().update_posting_list(_value_store.insert(key), _value_store.get_comparator(),
+                                                          [&](EntryRef ref) {
+                                                              _store.apply(ref,
+                                                                           additions.data(), additions.data() + additions.size(),
+                                                                           removals.data(), removals.data() + removals.size());
+                                                              return ref;
+                                                          });
+        inc_generation();
+    }
+
+    EntryRef get_posting_ref(int key)
+    {
+        auto &dictionary = _value_store.get_dictionary();
+        return dictionary.find_posting_list(_value_store.make_comparator(key), dictionary.get_frozen_root()).second;
+    }
+
+    std::vector<uint32_t> get_docs(EntryRef ref) const {
+        std::vector<uint32_t> docs;
+        _store.foreach_frozen_key(ref, [&docs](uint32_t doc) { docs.emplace_back(doc); });
+        return docs;
+    }
+
+    bool drop_btrees()
+    {
+        bool dropped = _store.drop_btrees_of_frozen_bitvectors();
+        inc_generation();
+        return dropped;
+    }
+};
+
+FrozenPostingListTest::FrozenPostingListTest()
+    : _gen_handler(),
+      _config(),
+      _status(),
+      _value_store(true, _config.get_dictionary_config()),
+      _store(_value_store.get_dictionary(), _status, _config)
+{
+    _store.resizeBitVectors(lid_limit, lid_limit);
+}
+
+FrozenPostingListTest::~FrozenPostingListTest()
+{
+    _value_store.get_dictionary().clear_all_posting_lists([this](EntryRef posting_idx) { _store.clear(posting_idx); });
+    _store.clearBuilder();
+    inc_generation();
+}
+
+namespace {
+
+std::vector<uint32_t> make_docs(uint32_t start_doc, uint32_t end_doc)
+{
+    std::vector<uint32_t> docs;
+    for (uint32_t doc = start_doc; doc < end_doc; ++doc) {
+        docs.emplace_back(doc);
+    }
+    return docs;
+}
+
+}
+
+TEST_F(FrozenPostingListTest, btree_is_dropped_for_unchanged_bitvector_and_recreated_on_change)
+{
+    add_docs(1, 100, 100 + huge_sequence_length);
+    auto ref = get_posting_ref(1);
+    EXPECT_TRUE(_store.has_bitvector(ref));
+    EXPECT_TRUE(_store.has_btree(ref));
+    auto btrees_before = _store.getMemoryUsage().btrees.usedBytes();
+    EXPECT_FALSE(drop_btrees()); // bitvector changed since last check
+    EXPECT_EQ(ref, get_posting_ref(1));
+    EXPECT_TRUE(drop_btrees());
+    ref = get_posting_ref(1);
+    EXPECT_TRUE(_store.has_bitvector(ref));
+    EXPECT_FALSE(_store.has_btree(ref));
+    EXPECT_GT(btrees_before, _store.getMemoryUsage().btrees.usedBytes());
+    EXPECT_EQ(huge_sequence_length, _store.frozenSize(ref));
+    EXPECT_EQ(make_docs(100, 100 + huge_sequence_length), get_docs(ref));
+    add_docs(1, 10000, 10001);
+    ref = get_posting_ref(1);
+    EXPECT_TRUE(_store.has_btree(ref));
+    EXPECT_EQ(huge_sequence_length + 1, _store.frozenSize(ref));
+    auto exp_docs = make_docs(100, 100 + huge_sequence_length);
+    exp_docs.emplace_back(10000);
+    EXPECT_EQ(exp_docs, get_docs(ref));
+    EXPECT_FALSE(drop_btrees());
+    EXPECT_TRUE(drop_btrees());
+    EXPECT_FALSE(_store.has_btree(get_posting_ref(1)));
+    EXPECT_EQ(exp_docs, get_docs(get_posting_ref(1)));
+}
+
+TEST_F(FrozenPostingListTest, btree_is_recreated_in_copy_of_bitvector_entry_used_by_readers)
+{
+    add_docs(1, 100, 100 + huge_sequence_length);
+    drop_btrees();
+    EXPECT_TRUE(drop_btrees());
+    auto old_ref = get_posting_ref(1);
+    EXPECT_FALSE(_store.has_btree(old_ref));
+    {
+        auto guard = _gen_handler.takeGuard();
+        add_docs(1, 10000, 10001);
+        auto ref = get_posting_ref(1);
+        EXPECT_NE(old_ref, ref);
+        EXPECT_TRUE(_store.has_btree(ref));
+        EXPECT_FALSE(_store.has_btree(old_ref));
+    }
+    inc_generation();
+    EXPECT_EQ(huge_sequence_length + 1, _store.frozenSize(get_posting_ref(1)));
+}
+
+TEST_F(FrozenPostingListTest, dropped_btree_is_intact_for_readers_of_old_bitvector_entry)
+{
+    add_docs(1, 100, 100 + huge_sequence_length);
+    EXPECT_FALSE(drop_btrees());
+    auto old_ref = get_posting_ref(1);
+    auto guard = _gen_handler.takeGuard();
+    EXPECT_TRUE(drop_btrees());
+    inc_generation();
+    EXPECT_NE(old_ref, get_posting_ref(1));
+    EXPECT_TRUE(_store.has_btree(old_ref));
+    std::vector<uint32_t> docs;
+    for (auto itr = _store.beginFrozen(old_ref); itr.valid(); ++itr) {
+        docs.emplace_back(itr.getKey());
+    }
+    EXPECT_EQ(make_docs(100, 100 + huge_sequence_length), docs);
+}
+
+TEST_F(FrozenPostingListTest, btree_is_kept_for_small_posting_lists)
+{
+    add_docs(1, 100, 200);
+    EXPECT_FALSE(drop_btrees());
+    EXPECT_FALSE(drop_btrees());
+    auto ref = get_posting_ref(1);
+    EXPECT_FALSE(_store.has_bitvector(ref));
+    EXPECT_TRUE(_store.has_btree(ref));
+    EXPECT_EQ(make_docs(100, 200), get_docs(ref));
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
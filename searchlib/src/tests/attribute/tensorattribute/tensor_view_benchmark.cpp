@@ -0,0 +1,112 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributeguard.h>
+#include <vespa/searchlib/tensor/fast_value_view.h>
+#include <vespa/searchlib/tensor/tensor_attribute.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/value_codec.h>
+#include <vespa/eval/eval/test/gen_spec.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+
+using search::AttributeFactory;
+using search::AttributeGuard;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::tensor::FastValueView;
+using search::tensor::TensorAttribute;
+using vespalib::eval::FastValueBuilderFactory;
+using vespalib::eval::Value;
+using vespalib::eval::test::GenSpec;
+
+double sum_cells(const Value& value) __attribute__((noinline));
+double read_copied(const TensorAttribute& attr, uint32_t num_docs) __attribute__((noinline));
+double read_viewed(const TensorAttribute& attr, uint32_t num_docs) __attribute__((noinline));
+
+double
+sum_cells(const Value& value)
+{
+    double sum = 0.0;
+    for (float cell : value.cells().typify<float>()) {
+        sum += cell;
+    }
+    return sum + value.index().size();
+}
+
+double
+read_copied(const TensorAttribute& attr, uint32_t num_docs)
+{
+    double sum = 0.0;
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        auto tensor = attr.getTensor(docid);
+        sum += sum_cells(*tensor);
+    }
+    return sum;
+}
+
+double
+read_viewed(const TensorAttribute& attr, uint32_t num_docs)
+{
+    double sum = 0.0;
+    FastValueView view(attr.getTensorType());
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        const Value* tensor = attr.get_tensor_view(docid, view);
+        sum += sum_cells(*tensor);
+    }
+    return sum;
+}
+
+template <typename ReadFunc>
+double
+run_reads(const std::string& label, const TensorAttribute& attr, uint32_t num_docs, ReadFunc read_func)
+{
+    vespalib::BenchmarkTimer timer(1.0);
+    double result = 0.0;
+    while (timer.has_budget()) {
+        timer.before();
+        result = read_func(attr, num_docs);
+        timer.after();
+    }
+    double ns_per_doc = timer.min_time() * 1000.0 * 1000.0 * 1000.0 / (num_docs - 1);
+    printf("  %-6s: %8.1f ns/doc (checksum=%g)\n", label.c_str(), ns_per_doc, result);
+    return ns_per_doc;
+}
+
+void
+benchmark(const std::string& name, const GenSpec& spec, bool fast_search, uint32_t num_docs)
+{
+    Config cfg(BasicType::TENSOR, CollectionType::SINGLE);
+    cfg.setTensorType(spec.type());
+    cfg.setFastSearch(fast_search);
+    auto attr = AttributeFactory::createAttribute("tensor", cfg);
+    auto& tensor_attr = dynamic_cast<TensorAttribute&>(*attr);
+    attr->addReservedDoc();
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        uint32_t added_docid = 0;
+        attr->addDoc(added_docid);
+        auto tensor = value_from_spec(GenSpec(spec).seq(vespalib::eval::test::N(docid)), FastValueBuilderFactory::get());
+        tensor_attr.setTensor(added_docid, *tensor);
+    }
+    attr->commit();
+    AttributeGuard guard(attr);
+    printf("%s (%s):\n", name.c_str(), spec.type().to_spec().c_str());
+    double copied = run_reads("copied", tensor_attr, num_docs, read_copied);
+    double viewed = run_reads("viewed", tensor_attr, num_docs, read_viewed);
+    printf("  speedup: %6.3f\n", copied / viewed);
+}
+
+int
+main(int argc, char *argv[]) {
+    uint32_t num_docs = 10000;
+    if (argc > 1) { num_docs = atol(argv[1]); }
+    printf("Benchmarking tensor attribute reads over %u documents\n", num_docs);
+    auto f = vespalib::eval::CellType::FLOAT;
+    benchmark("mapped (serialized)", GenSpec().map("x", 16, 1).cells(f), false, num_docs);
+    benchmark("mapped (direct)", GenSpec().map("x", 16, 1).cells(f), true, num_docs);
+    benchmark("mixed (serialized)", GenSpec().map("x", 8, 1).idx("y", 64).cells(f), false, num_docs);
+    benchmark("mixed (direct)", GenSpec().map("x", 8, 1).idx("y", 64).cells(f), true, num_docs);
+    benchmark("dense", GenSpec().idx("x", 256).cells(f), false, num_docs);
+    return 0;
+}
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/direct_tensor_attribute.h>
 #include <vespa/searchlib/tensor/doc_vector_access.h>
+#include <vespa/searchlib/tensor/fast_value_view.h>
 #include <vespa/searchlib/tensor/hnsw_index.h>
 #include <vespa/searchlib/tensor/mips_distance_transform.h>
 #include <vespa/searchlib/tensor/nearest_neighbor_index.h>
@@ -646,6 +647,7 @@ struct Fixture {
     void testTensorTypeFileHeaderTag();
     void testEmptyTensor();
     void testSerializedTensorRef();
+    void testTensorView();
     void testOnHoldAccounting();
     void test_populate_address_space_usage();
     void test_mmap_file_allocator();
@@ -899,6 +901,37 @@ Fixture::testSerializedTensorRef()
     clearTensor(3);
 }
 
+void
+Fixture::testTensorView()
+{
+    SCOPED_TRACE("testTensorView");
+    const TensorAttribute &tensorAttr = *_tensorAttr;
+    ensureSpace(4);
+    if (_denseTensors) {
+        set_tensor(3, expDenseTensor3());
+    } else {
+        set_tensor(3, TensorSpec(sparseSpec)
+                   .add({{"x", "one"}, {"y", "two"}}, 11)
+                   .add({{"x", "three"}, {"y", "four"}}, 17));
+    }
+    set_empty_tensor(4);
+    AttributeGuard guard(_attr);
+    search::tensor::FastValueView view(tensorAttr.getTensorType());
+    for (uint32_t docid = 1; docid < 5; ++docid) {
+        SCOPED_TRACE(docid);
+        auto expected = tensorAttr.getTensor(docid);
+        const Value* actual = tensorAttr.get_tensor_view(docid, view);
+        if (expected) {
+            ASSERT_NE(nullptr, actual);
+            EXPECT_EQ(TensorSpec::from_value(*expected), TensorSpec::from_value(*actual));
+        } else {
+            EXPECT_EQ(nullptr, actual);
+        }
+    }
+    EXPECT_EQ(nullptr, tensorAttr.get_tensor_view(_attr->getCommittedDocIdLimit(), view));
+    clearTensor(3);
+}
+
 void
 Fixture::testOnHoldAccounting()
 {
@@ -957,6 +990,7 @@ void testAll(MakeFixture &&f)
     f()->testTensorTypeFileHeaderTag();
     f()->testEmptyTensor();
     f()->testSerializedTensorRef();
+    f()->testTensorView();
     f()->testOnHoldAccounting();
     f()->test_populate_address_space_usage();
     f()->test_mmap_file_allocator();
@@ -29,6 +29,7 @@ std::string source_dir = get_source_dir();
 std::string vespa_dir = source_dir + "/" + "../../../../..";
 std::string simple_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/simple.onnx";
 std::string dynamic_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/dynamic.onnx";
+std::string batched_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/batched.onnx";
 std::string strange_names_model = source_dir + "/" + "strange_names.onnx";
 std::string fragile_model = source_dir + "/" + "fragile.onnx";
 
@@ -175,6 +176,55 @@ TEST_F(OnnxFeatureTest, fragile_model_can_be_evaluated) {
     EXPECT_EQ(get(3), TensorSpec::from_expr("tensor<float>(d0[2]):[6,15]"));
 }
 
+TEST_F(OnnxFeatureTest, batched_onnx_model_gives_same_results_inside_and_outside_batches) {
+    indexEnv.getProperties().add(indexproperties::eval::OnnxBatchSize::NAME, "4");
+    add_expr("in1", "tensor<float>(a[1],b[3]):[[docid,2,3]]");
+    add_expr("in2", "tensor<float>(a[1],b[3]):[[1,docid,2]]");
+    add_onnx(std::move(OnnxModel("batched", batched_model).dry_run_on_setup(true)));
+    compile(onnx_feature("batched"));
+    EXPECT_EQ(program.max_batch_size(), 4u);
+    auto expect_prod = [](uint32_t docid) {
+        return TensorSpec::from_expr(fmt("tensor<float>(d0[1],d1[3]):[[%u,%u,6]]", docid, 2 * docid));
+    };
+    auto expect_out = [](uint32_t docid) {
+        return TensorSpec::from_expr(fmt("tensor<float>(d0[1],d1[3]):[[%u,%u,9]]", 2 * docid, 2 * docid + 2));
+    };
+    for (uint32_t docid: {2, 3, 5}) {
+        program.add_to_batch(docid);
+    }
+    program.run_batch();
+    for (uint32_t docid: {2, 3, 4, 5, 7}) {
+        EXPECT_EQ(get(docid), expect_prod(docid));
+        EXPECT_EQ(get("onnx(batched).out", docid), expect_out(docid));
+    }
+    // a new batch replaces the previous one
+    program.add_to_batch(7);
+    program.run_batch();
+    for (uint32_t docid: {2, 7}) {
+        EXPECT_EQ(get(docid), expect_prod(docid));
+        EXPECT_EQ(get("onnx(batched).out", docid), expect_out(docid));
+    }
+}
+
+TEST_F(OnnxFeatureTest, batching_is_disabled_for_models_without_free_batch_dimension) {
+    indexEnv.getProperties().add(indexproperties::eval::OnnxBatchSize::NAME, "4");
+    add_expr("query_tensor", "tensor<float>(a[1],b[4]):[[docid,2,3,4]]");
+    add_expr("attribute_tensor", "tensor<float>(a[4],b[1]):[[5],[6],[7],[8]]");
+    add_expr("bias_tensor", "tensor<float>(a[1],b[2]):[[4,5]]");
+    add_onnx(OnnxModel("dynamic", dynamic_model));
+    compile(onnx_feature("dynamic"));
+    EXPECT_EQ(program.max_batch_size(), 0u);
+    EXPECT_EQ(get(1), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 79.0));
+}
+
+TEST_F(OnnxFeatureTest, batching_is_disabled_by_default) {
+    add_expr("in1", "tensor<float>(a[1],b[3]):[[docid,2,3]]");
+    add_expr("in2", "tensor<float>(a[1],b[3]):[[1,docid,2]]");
+    add_onnx(OnnxModel("batched", batched_model));
+    compile(onnx_feature("batched"));
+    EXPECT_EQ(program.max_batch_size(), 0u);
+}
+
 struct MyIssues : Issue::Handler {
     std::vector<std::string> list;
     Issue::Binding capture;
@@ -243,6 +243,14 @@ TEST(PropertiesTest, test_stuff)
             p.add("vespa.eval.use_fast_forest", "true");
             EXPECT_EQ(eval::UseFastForest::check(p), true);
         }
+        { // vespa.eval.onnx_batch_size
+            EXPECT_EQ(eval::OnnxBatchSize::NAME, std::string("vespa.eval.onnx_batch_size"));
+            EXPECT_EQ(eval::OnnxBatchSize::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQ(eval::OnnxBatchSize::lookup(p), 0u);
+            p.add("vespa.eval.onnx_batch_size", "32");
+            EXPECT_EQ(eval::OnnxBatchSize::lookup(p), 32u);
+        }
         { // vespa.rank.firstphase
             EXPECT_EQ(rank::FirstPhase::NAME, std::string("vespa.rank.firstphase"));
             EXPECT_EQ(rank::FirstPhase::DEFAULT_VALUE, std::string("nativeRank"));
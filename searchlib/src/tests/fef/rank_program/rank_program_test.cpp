@@ -13,6 +13,7 @@
 #include <vespa/searchlib/test/test_features.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/execution_profiler.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <string>
 
@@ -20,7 +21,9 @@ using namespace search::fef;
 using namespace search::fef::test;
 using namespace search::features;
 using vespalib::ExecutionProfiler;
+using vespalib::SimpleThreadBundle;
 using vespalib::Slime;
+using vespalib::ThreadBundle;
 
 uint32_t default_docid = 1;
 
@@ -114,12 +117,12 @@ struct Fixture {
         overrides.add(feature, vespalib::make_string("%g", value));
         return *this;
     }
-    void compile(ExecutionProfiler *profiler = nullptr) {
+    void compile(ExecutionProfiler *profiler = nullptr, ThreadBundle *thread_bundle = nullptr) {
         ASSERT_TRUE(resolver->compile());
         MatchDataLayout mdl;
         QueryEnvironment queryEnv(&indexEnv);
         match_data = mdl.createMatchData();
-        program.setup(*match_data, queryEnv, overrides, profiler);
+        program.setup(*match_data, queryEnv, overrides, profiler, thread_bundle);
     }
     std::string final_executor_name() const {
         size_t n = program.num_executors();
@@ -477,4 +480,18 @@ TEST(RankProgramTest, rank_program_can_be_profiled)
     EXPECT_EQ((*b)["count"].asLong(), 1);
 }
 
+const std::string large_tensor_expr = "reduce(reduce(tensor(x[256],y[512])(x+y)*tensor(y[512],z[8])(y-z),sum,y),max)";
+
+TEST(RankProgramTest, const_tensor_expressions_can_be_calculated_with_thread_bundle)
+{
+    SimpleThreadBundle thread_bundle(4);
+    Fixture f1;
+    Fixture f2;
+    f1.add_expr("rank", large_tensor_expr).compile();
+    f2.add_expr("rank", large_tensor_expr).compile(nullptr, &thread_bundle);
+    EXPECT_EQ(count_features(f2.program), count_const_features(f2.program));
+    EXPECT_EQ(f1.get(), f2.get());
+    EXPECT_GT(f2.get(), 0.0);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
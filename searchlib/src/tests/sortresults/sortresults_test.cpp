@@ -2,9 +2,27 @@
 
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/common/sortresults.h>
+#include <vespa/searchlib/attribute/attributecontext.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributemanager.h>
+#include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/searchlib/uca/ucaconverter.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
 
 using search::RankedHit;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+
+bool bench = false;
 
 unsigned int
 myrandom()
@@ -64,12 +82,130 @@ test_sort(unsigned int caseNum, unsigned int n, unsigned int ntop)
     return ok;
 }
 
+void
+add_string_attribute(search::AttributeManager & mgr, const std::string & name, unsigned int n,
+                     const std::vector<std::string> & values)
+{
+    auto attr = search::AttributeFactory::createAttribute(name, Config(BasicType::STRING, CollectionType::SINGLE));
+    auto & sattr = dynamic_cast<search::StringAttribute &>(*attr);
+    sattr.addDocs(n);
+    for (unsigned int i = 0; i < n; i++) {
+        sattr.update(i, values[myrandom() % values.size()].c_str());
+    }
+    attr->commit();
+    mgr.add(attr);
+}
+
+/**
+ * Sorts hits on string attributes with many duplicate values, and
+ * checks the sort data against the sort data written per hit without
+ * sorting. With at least minHitsForOrdinalSort hits the sort is done
+ * on ordinals of the distinct values.
+ **/
+bool
+test_string_sort(unsigned int caseNum, const std::string & sortSpec, unsigned int n, unsigned int ntop,
+                 uint32_t minHitsForOrdinalSort = FastS_SortSpec::DEFAULT_MIN_HITS_FOR_ORDINAL_SORT)
+{
+    bool ok = true;
+    std::vector<std::string> values = {"", "aa", "alpha", "Alpha", "ALPHA", "beta", "Beta", "gamma",
+                                       "\xc3\xa5", "\xc3\xb8re", "\xc3\x98re", "zeta"};
+    search::AttributeManager mgr;
+    add_string_attribute(mgr, "s1", n, values);
+    add_string_attribute(mgr, "s2", n, values);
+    search::AttributeContext ac(mgr);
+    search::uca::UcaConverterFactory ucaFactory;
+
+    std::vector<RankedHit> hits;
+    for (unsigned int i = 0; i < n; i++) {
+        hits.emplace_back(i, myrandom() % 4);
+    }
+    std::shuffle(hits.begin(), hits.end(), std::mt19937(caseNum));
+
+    FastS_SortSpec blobSpec("no-metastore", 7, vespalib::Doom::never(), ucaFactory);
+    ok &= blobSpec.Init(sortSpec, ac);
+    blobSpec.initWithoutSorting(hits.data(), n);
+    std::map<uint32_t, std::string> expected;
+    std::vector<std::string> expectedOrder;
+    for (unsigned int i = 0; i < n; i++) {
+        auto ref = blobSpec.getSortRef(i);
+        expected[hits[i].getDocId()] = std::string(ref.first, ref.second);
+        expectedOrder.emplace_back(ref.first, ref.second);
+    }
+    std::sort(expectedOrder.begin(), expectedOrder.end());
+
+    FastS_SortSpec spec("no-metastore", 7, vespalib::Doom::never(), ucaFactory);
+    ok &= spec.Init(sortSpec, ac);
+    spec.setMinHitsForOrdinalSort(minHitsForOrdinalSort);
+    spec.sortResults(hits.data(), n, ntop);
+    for (unsigned int i = 0; ok && i < n; i++) {
+        auto ref = spec.getSortRef(i);
+        std::string actual(ref.first, ref.second);
+        if (actual != expected[hits[i].getDocId()]) {
+            printf("ERROR: sort data of hit %d (doc %d) differs from unsorted sort data\n", i, hits[i].getDocId());
+            ok = false;
+        } else if (i < ntop && actual != expectedOrder[i]) {
+            printf("ERROR: hit %d (doc %d) is out of order\n", i, hits[i].getDocId());
+            ok = false;
+        }
+    }
+    printf("CASE %03d: [%d/%d] '%s' %s\n", caseNum, ntop, n, sortSpec.c_str(),
+           (ok)? "PASS" : "FAIL");
+    return ok;
+}
+
+/**
+ * Measures sorting on a string attribute with and without ordinals
+ * for a range of hit counts, to find the number of hits where sorting
+ * on ordinals starts to pay off (FastS_SortSpec::DEFAULT_MIN_HITS_FOR_ORDINAL_SORT).
+ **/
+void
+benchmark_ordinal_sort(const std::string & sortSpec)
+{
+    constexpr unsigned int docs = 1 << 20;
+    std::vector<std::string> values;
+    for (unsigned int i = 0; i < 1024; i++) {
+        values.emplace_back("value " + std::to_string(myrandom()));
+    }
+    search::AttributeManager mgr;
+    add_string_attribute(mgr, "s1", docs, values);
+    search::AttributeContext ac(mgr);
+    search::uca::UcaConverterFactory ucaFactory;
+    for (unsigned int n = 16; n <= 65536; n *= 2) {
+        std::vector<RankedHit> hits;
+        for (unsigned int i = 0; i < n; i++) {
+            hits.emplace_back(myrandom() % docs, 0.0);
+        }
+        double elapsed[2];
+        for (uint32_t useOrdinals = 0; useOrdinals < 2; useOrdinals++) {
+            unsigned int loops = std::max(16u, (1u << 22) / n);
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned int loop = 0; loop < loops; loop++) {
+                std::vector<RankedHit> sorted(hits);
+                FastS_SortSpec spec("no-metastore", 7, vespalib::Doom::never(), ucaFactory);
+                spec.Init(sortSpec, ac);
+                spec.setMinHitsForOrdinalSort(useOrdinals ? 0 : std::numeric_limits<uint32_t>::max());
+                spec.sortResults(sorted.data(), n, n);
+            }
+            std::chrono::duration<double, std::micro> used = std::chrono::steady_clock::now() - start;
+            elapsed[useOrdinals] = used.count() / loops;
+        }
+        printf("'%s' %6d hits: %10.1f us plain, %10.1f us ordinals (%.2fx)\n",
+               sortSpec.c_str(), n, elapsed[0], elapsed[1], elapsed[0] / elapsed[1]);
+    }
+}
 
 int
 main(int argc, char **argv)
 {
-    (void) argc;
-    (void) argv;
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        bench = true;
+    }
+    if (bench) {
+        benchmark_ordinal_sort("+s1");
+        benchmark_ordinal_sort("+uca(s1,nn_no)");
+        return 0;
+    }
+    printf("[ SKIPPING ] run with 'bench' parameter to activate ordinal sort benchmark\n");
 
     bool ok = true;
     unsigned int caseNum = 0;
@@ -91,6 +227,14 @@ main(int argc, char **argv)
         ok &= test_sort(++caseNum,  50000,  10000);
         ok &= test_sort(++caseNum,  50000,  50000);
     }
+    for (const char * sortSpec : {"+s1", "-s1", "+uca(s1,nn_no)", "-uca(s1,nn_no,PRIMARY)", "+lowercase(s1)",
+                                   "+s1 -s2", "-uca(s2,nn_no) +s1 -[rank]", "+[rank] -s1 +uca(s2,nn_no,PRIMARY)"})
+    {
+        ok &= test_string_sort(++caseNum, sortSpec, 100, 100);
+        ok &= test_string_sort(++caseNum, sortSpec, 1000, 1000);
+        ok &= test_string_sort(++caseNum, sortSpec, 1000, 10);
+        ok &= test_string_sort(++caseNum, sortSpec, 100, 10, 0);
+    }
     printf("CONCLUSION: TEST %s\n", (ok)? "PASSED" : "FAILED");
     return (ok)? 0 : 1;
 }
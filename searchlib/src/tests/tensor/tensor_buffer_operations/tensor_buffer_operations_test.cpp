@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/tensor/tensor_buffer_operations.h>
+#include <vespa/eval/eval/fast_value_index.h>
 #include <vespa/eval/eval/simple_value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/value.h>
@@ -10,6 +11,7 @@
 #include <vespa/vespalib/gtest/gtest.h>
 
 using search::tensor::TensorBufferOperations;
+using vespalib::eval::FastValueIndex;
 using vespalib::eval::SimpleValue;
 using vespalib::eval::StreamedValueBuilderFactory;
 using vespalib::eval::TensorSpec;
@@ -188,4 +190,21 @@ TEST_P(TensorBufferOperationsTest, tensor_buffer_can_be_encoded)
     assert_store_encode_decode(GetParam()._tensor_spec);
 }
 
+TEST(TensorBufferOperationsSortTest, sparse_tensor_with_single_dimension_is_stored_in_label_order)
+{
+    auto tensor_type = ValueType::from_spec(tensor_type_spec);
+    TensorBufferOperations ops(tensor_type);
+    auto spec = TensorSpec(tensor_type_spec).add({{"x", "c"}}, 1.0).add({{"x", "a"}}, 2.0)
+            .add({{"x", "d"}}, 3.0).add({{"x", "b"}}, 4.0);
+    auto tensor = SimpleValue::from_spec(spec);
+    std::vector<char> buf(ops.get_buffer_size(tensor->index().size()));
+    ops.store_tensor(buf, *tensor);
+    auto view = ops.make_fast_view(buf, tensor_type);
+    const auto& map = static_cast<const FastValueIndex&>(view->index()).map;
+    EXPECT_TRUE(map.has_sorted_labels());
+    EXPECT_EQ(nullptr, map.sorted_labels().subspaces);
+    EXPECT_EQ(spec, TensorSpec::from_value(*view));
+    ops.reclaim_labels(buf);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -26,6 +26,7 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_) noexcept
       _distance_metric(DistanceMetric::Euclidean),
       _match(Match::UNCASED),
       _dictionary(),
+      _memory_policy(),
       _maxUnCommittedMemory(MAX_UNCOMMITTED_MEMORY),
       _growStrategy(),
       _compactionStrategy(),
@@ -54,6 +55,7 @@ Config::operator==(const Config &b) const noexcept
            _maxUnCommittedMemory == b._maxUnCommittedMemory &&
            _match == b._match &&
            _dictionary == b._dictionary &&
+           _memory_policy == b._memory_policy &&
            _growStrategy == b._growStrategy &&
            _compactionStrategy == b._compactionStrategy &&
            _predicateParams == b._predicateParams &&
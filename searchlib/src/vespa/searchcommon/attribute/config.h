@@ -10,6 +10,7 @@
 #include <vespa/searchcommon/common/dictionary_config.h>
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/vespalib/datastore/compaction_strategy.h>
+#include <vespa/vespalib/util/memory_policy.h>
 #include <optional>
 
 namespace search::attribute {
@@ -23,6 +24,7 @@ class Config {
 public:
     enum class Match : uint8_t { CASED, UNCASED };
     using CompactionStrategy = vespalib::datastore::CompactionStrategy;
+    using MemoryPolicy = vespalib::alloc::MemoryPolicy;
     Config() noexcept;
     Config(BasicType bt) noexcept : Config(bt, CollectionType::SINGLE) { }
     Config(BasicType bt, CollectionType ct) noexcept : Config(bt, ct, false) { }
@@ -59,6 +61,7 @@ public:
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     const DictionaryConfig & get_dictionary_config() const { return _dictionary; }
     Match get_match() const { return _match; }
+    const MemoryPolicy& memory_policy() const noexcept { return _memory_policy; }
     Config & setFastSearch(bool v)                   { _fastSearch = v; return *this; }
     Config & setPredicateParams(const PredicateParams &v) { _predicateParams = v; return *this; }
     Config & setTensorType(const vespalib::eval::ValueType &tensorType_in) {
@@ -92,6 +95,7 @@ public:
     }
     Config & set_dictionary_config(const DictionaryConfig & cfg) { _dictionary = cfg; return *this; }
     Config & set_match(Match match) { _match = match; return *this; }
+    Config & set_memory_policy(const MemoryPolicy& policy) { _memory_policy = policy; return *this; }
     bool operator!=(const Config &b) const noexcept { return !(operator==(b)); }
     bool operator==(const Config &b) const noexcept ;
 
@@ -110,6 +114,7 @@ private:
     DistanceMetric                 _distance_metric;
     Match                          _match;
     DictionaryConfig               _dictionary;
+    MemoryPolicy                   _memory_policy;
     uint64_t                       _maxUnCommittedMemory;
     GrowStrategy                   _growStrategy;
     CompactionStrategy             _compactionStrategy;
@@ -20,7 +20,19 @@ Status::Status()
       _lastSyncToken        (0),
       _updates              (0),
       _nonIdempotentUpdates (0),
-      _bitVectors(0)
+      _bitVectors(0),
+      _compaction_time_ns(0),
+      _max_compaction_stall_ns(0),
+      _paged_hot_bytes(0),
+      _paged_cold_bytes(0),
+      _paged_cold_resident_bytes(0),
+      _paged_cold_page_ins(0),
+      _estimate_plain_bytes(0),
+      _estimate_compressed_bytes(0),
+      _policy_mapped_bytes(0),
+      _policy_huge_page_bytes(0),
+      _policy_huge_page_fallbacks(0),
+      _policy_numa_failures(0)
 {
 }
 
@@ -37,7 +49,19 @@ Status::Status(const Status& rhs)
       _lastSyncToken(rhs.getLastSyncToken()),
       _updates(rhs._updates),
       _nonIdempotentUpdates(rhs._nonIdempotentUpdates),
-      _bitVectors(load_relaxed(rhs._bitVectors))
+      _bitVectors(load_relaxed(rhs._bitVectors)),
+      _compaction_time_ns(load_relaxed(rhs._compaction_time_ns)),
+      _max_compaction_stall_ns(load_relaxed(rhs._max_compaction_stall_ns)),
+      _paged_hot_bytes(load_relaxed(rhs._paged_hot_bytes)),
+      _paged_cold_bytes(load_relaxed(rhs._paged_cold_bytes)),
+      _paged_cold_resident_bytes(load_relaxed(rhs._paged_cold_resident_bytes)),
+      _paged_cold_page_ins(load_relaxed(rhs._paged_cold_page_ins)),
+      _estimate_plain_bytes(load_relaxed(rhs._estimate_plain_bytes)),
+      _estimate_compressed_bytes(load_relaxed(rhs._estimate_compressed_bytes)),
+      _policy_mapped_bytes(load_relaxed(rhs._policy_mapped_bytes)),
+      _policy_huge_page_bytes(load_relaxed(rhs._policy_huge_page_bytes)),
+      _policy_huge_page_fallbacks(load_relaxed(rhs._policy_huge_page_fallbacks)),
+      _policy_numa_failures(load_relaxed(rhs._policy_numa_failures))
 {
 }
 
@@ -57,6 +81,18 @@ Status::operator=(const Status& rhs)
     _updates = rhs._updates;
     _nonIdempotentUpdates = rhs._nonIdempotentUpdates;
     store_relaxed(_bitVectors, load_relaxed(rhs._bitVectors));
+    store_relaxed(_compaction_time_ns, load_relaxed(rhs._compaction_time_ns));
+    store_relaxed(_max_compaction_stall_ns, load_relaxed(rhs._max_compaction_stall_ns));
+    store_relaxed(_paged_hot_bytes, load_relaxed(rhs._paged_hot_bytes));
+    store_relaxed(_paged_cold_bytes, load_relaxed(rhs._paged_cold_bytes));
+    store_relaxed(_paged_cold_resident_bytes, load_relaxed(rhs._paged_cold_resident_bytes));
+    store_relaxed(_paged_cold_page_ins, load_relaxed(rhs._paged_cold_page_ins));
+    store_relaxed(_estimate_plain_bytes, load_relaxed(rhs._estimate_plain_bytes));
+    store_relaxed(_estimate_compressed_bytes, load_relaxed(rhs._estimate_compressed_bytes));
+    store_relaxed(_policy_mapped_bytes, load_relaxed(rhs._policy_mapped_bytes));
+    store_relaxed(_policy_huge_page_bytes, load_relaxed(rhs._policy_huge_page_bytes));
+    store_relaxed(_policy_huge_page_fallbacks, load_relaxed(rhs._policy_huge_page_fallbacks));
+    store_relaxed(_policy_numa_failures, load_relaxed(rhs._policy_numa_failures));
     return *this;
 }
 
@@ -83,4 +119,39 @@ Status::updateStatistics(uint64_t numValues, uint64_t numUniqueValue, uint64_t a
     store_relaxed(_onHoldMax,       std::max(load_relaxed(_onHoldMax), onHold));
 }
 
+void
+Status::add_compaction_time(std::chrono::nanoseconds elapsed)
+{
+    uint64_t elapsed_ns = elapsed.count();
+    store_relaxed(_compaction_time_ns, load_relaxed(_compaction_time_ns) + elapsed_ns);
+    if (elapsed_ns > load_relaxed(_max_compaction_stall_ns)) {
+        store_relaxed(_max_compaction_stall_ns, elapsed_ns);
+    }
+}
+
+void
+Status::update_paged_memory(uint64_t hot_bytes, uint64_t cold_bytes, uint64_t cold_resident_bytes, uint64_t cold_page_ins)
+{
+    store_relaxed(_paged_hot_bytes, hot_bytes);
+    store_relaxed(_paged_cold_bytes, cold_bytes);
+    store_relaxed(_paged_cold_resident_bytes, cold_resident_bytes);
+    store_relaxed(_paged_cold_page_ins, cold_page_ins);
+}
+
+void
+Status::update_compression_estimate(uint64_t plain_bytes, uint64_t compressed_bytes)
+{
+    store_relaxed(_estimate_plain_bytes, plain_bytes);
+    store_relaxed(_estimate_compressed_bytes, compressed_bytes);
+}
+
+void
+Status::update_policy_memory(uint64_t mapped_bytes, uint64_t huge_page_bytes, uint64_t huge_page_fallbacks, uint64_t numa_failures)
+{
+    store_relaxed(_policy_mapped_bytes, mapped_bytes);
+    store_relaxed(_policy_huge_page_bytes, huge_page_bytes);
+    store_relaxed(_policy_huge_page_fallbacks, huge_page_fallbacks);
+    store_relaxed(_policy_numa_failures, numa_failures);
+}
+
 }
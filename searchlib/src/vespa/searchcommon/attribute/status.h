@@ -3,6 +3,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <string>
 
 namespace search::attribute {
@@ -30,6 +31,25 @@ public:
     uint64_t getUpdateCount()              const { return _updates; }
     uint64_t getNonIdempotentUpdateCount() const { return _nonIdempotentUpdates; }
     uint32_t getBitVectors() const { return _bitVectors.load(std::memory_order_relaxed); }
+    // Time the writer thread has spent compacting, and the longest time spent compacting in a single commit.
+    uint64_t get_compaction_time_ns()      const { return _compaction_time_ns.load(std::memory_order_relaxed); }
+    uint64_t get_max_compaction_stall_ns() const { return _max_compaction_stall_ns.load(std::memory_order_relaxed); }
+    // Tiering of memory for paged attributes: bytes pinned in memory (hot), bytes left to the
+    // page cache (cold), the resident part of the cold bytes, and pages of cold memory paged in.
+    uint64_t get_paged_hot_bytes()           const { return _paged_hot_bytes.load(std::memory_order_relaxed); }
+    uint64_t get_paged_cold_bytes()          const { return _paged_cold_bytes.load(std::memory_order_relaxed); }
+    uint64_t get_paged_cold_resident_bytes() const { return _paged_cold_resident_bytes.load(std::memory_order_relaxed); }
+    uint64_t get_paged_cold_page_ins()       const { return _paged_cold_page_ins.load(std::memory_order_relaxed); }
+    // Size of the values with full width, and an estimate of their size with frame of reference
+    // compression, measured at load and flush. The values are not stored compressed.
+    uint64_t get_estimate_plain_bytes()      const { return _estimate_plain_bytes.load(std::memory_order_relaxed); }
+    uint64_t get_estimate_compressed_bytes() const { return _estimate_compressed_bytes.load(std::memory_order_relaxed); }
+    // Memory allocated with a huge page or NUMA policy: bytes in memory mappings, the part of them backed by
+    // explicit huge pages, mappings falling back to normal pages and mappings where NUMA policy failed.
+    uint64_t get_policy_mapped_bytes()       const { return _policy_mapped_bytes.load(std::memory_order_relaxed); }
+    uint64_t get_policy_huge_page_bytes()    const { return _policy_huge_page_bytes.load(std::memory_order_relaxed); }
+    uint64_t get_policy_huge_page_fallbacks() const { return _policy_huge_page_fallbacks.load(std::memory_order_relaxed); }
+    uint64_t get_policy_numa_failures()      const { return _policy_numa_failures.load(std::memory_order_relaxed); }
 
     void setNumDocs(uint64_t v)                  { _numDocs.store(v, std::memory_order_relaxed); }
     void incNumDocs()                            { _numDocs.store(_numDocs.load(std::memory_order_relaxed) + 1u,
@@ -39,6 +59,10 @@ public:
     void incNonIdempotentUpdates(uint64_t v = 1) { _nonIdempotentUpdates += v; }
     void incBitVectors() { _bitVectors.store(getBitVectors() + 1, std::memory_order_relaxed); }
     void decBitVectors() { _bitVectors.store(getBitVectors() - 1, std::memory_order_relaxed); }
+    void add_compaction_time(std::chrono::nanoseconds elapsed);
+    void update_paged_memory(uint64_t hot_bytes, uint64_t cold_bytes, uint64_t cold_resident_bytes, uint64_t cold_page_ins);
+    void update_compression_estimate(uint64_t plain_bytes, uint64_t compressed_bytes);
+    void update_policy_memory(uint64_t mapped_bytes, uint64_t huge_page_bytes, uint64_t huge_page_fallbacks, uint64_t numa_failures);
 
     static std::string
     createName(std::string_view index, std::string_view attr);
@@ -56,6 +80,18 @@ private:
     uint64_t _updates;
     uint64_t _nonIdempotentUpdates;
     std::atomic<uint32_t> _bitVectors;
+    std::atomic<uint64_t> _compaction_time_ns;
+    std::atomic<uint64_t> _max_compaction_stall_ns;
+    std::atomic<uint64_t> _paged_hot_bytes;
+    std::atomic<uint64_t> _paged_cold_bytes;
+    std::atomic<uint64_t> _paged_cold_resident_bytes;
+    std::atomic<uint64_t> _paged_cold_page_ins;
+    std::atomic<uint64_t> _estimate_plain_bytes;
+    std::atomic<uint64_t> _estimate_compressed_bytes;
+    std::atomic<uint64_t> _policy_mapped_bytes;
+    std::atomic<uint64_t> _policy_huge_page_bytes;
+    std::atomic<uint64_t> _policy_huge_page_fallbacks;
+    std::atomic<uint64_t> _policy_numa_failures;
 };
 
 }
@@ -22,7 +22,9 @@
 #include <vespa/searchlib/util/file_settings.h>
 #include <vespa/vespalib/util/jsonwriter.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <vespa/vespalib/util/mmap_policy_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <thread>
 #include <filesystem>
@@ -73,6 +75,9 @@ make_memory_allocator(const std::string& name, const search::attribute::Config&
     if (allow_paged(config)) {
         return vespalib::alloc::MmapFileAllocatorFactory::instance().make_memory_allocator(name);
     }
+    if (!config.memory_policy().is_default()) {
+        return std::make_unique<vespalib::alloc::MmapPolicyAllocator>(config.memory_policy());
+    }
     return {};
 }
 
@@ -88,7 +93,7 @@ AttributeVector::AttributeVector(std::string_view baseFileName, const Config &c)
       _config(std::make_unique<Config>(c)),
       _interlock(std::make_shared<attribute::Interlock>()),
       _enumLock(),
-      _genHandler(),
+      _genHandler(GenerationHandler::default_num_reader_shards()),
       _genHolder(),
       _status(),
       _highestValueCount(1),
@@ -102,7 +107,10 @@ AttributeVector::AttributeVector(std::string_view baseFileName, const Config &c)
       _isUpdateableInMemoryOnly(attribute::isUpdateableInMemoryOnly(getName(), getConfig())),
       _nextStatUpdateTime(),
       _memory_allocator(make_memory_allocator(_baseFileName.getAttributeName(), c)),
-      _size_on_disk(0)
+      _size_on_disk(0),
+      _scan_prefetch_generation(0),
+      _load_phase_start(),
+      _load_phase_times()
 {
 }
 
@@ -114,10 +122,42 @@ AttributeVector::updateStat(bool force) {
         onUpdateStat();
     } else if (_nextStatUpdateTime < vespalib::steady_clock::now()) {
         onUpdateStat();
+        update_paged_memory_stats();
+        update_policy_memory_stats();
         _nextStatUpdateTime = vespalib::steady_clock::now() + 5s;
     }
 }
 
+void
+AttributeVector::update_paged_memory_stats()
+{
+    auto allocator = dynamic_cast<const vespalib::alloc::MmapFileAllocator*>(_memory_allocator.get());
+    if (allocator == nullptr || !allocator->has_tiers()) {
+        return;
+    }
+    auto stats = allocator->get_tier_stats();
+    _status.update_paged_memory(stats.hot_bytes, stats.cold_bytes, stats.cold_resident_bytes, stats.cold_page_ins);
+}
+
+void
+AttributeVector::update_policy_memory_stats()
+{
+    auto allocator = dynamic_cast<const vespalib::alloc::MmapPolicyAllocator*>(_memory_allocator.get());
+    if (allocator == nullptr) {
+        return;
+    }
+    auto stats = allocator->get_stats();
+    _status.update_policy_memory(stats.mapped_bytes, stats.huge_page_bytes, stats.fallbacks, stats.numa_failures);
+}
+
+bool
+AttributeVector::claim_scan_prefetch() const noexcept
+{
+    generation_t next = getCurrentGeneration() + 1;
+    generation_t prev = _scan_prefetch_generation.load(std::memory_order_relaxed);
+    return (prev != next) && _scan_prefetch_generation.compare_exchange_strong(prev, next, std::memory_order_relaxed);
+}
+
 bool AttributeVector::hasEnum() const { return _hasEnum; }
 uint32_t AttributeVector::getMaxValueCount() const { return _highestValueCount.load(std::memory_order_relaxed); }
 bool AttributeVector::hasMultiValue() const { return _config->collectionType().isMultiValue(); }
@@ -354,11 +394,14 @@ AttributeVector::load() {
 bool
 AttributeVector::load(vespalib::Executor * executor) {
     assert(!_loaded);
+    _load_phase_times.clear();
+    _load_phase_start = vespalib::steady_clock::now();
     bool loaded = onLoad(executor);
     if (loaded) {
         commit();
         incGeneration();
         updateStat(true);
+        end_load_phase("other");
     }
     _loaded = loaded;
     return _loaded;
@@ -738,6 +781,14 @@ AttributeVector::get_initial_alloc()
     return (_memory_allocator ? vespalib::alloc::Alloc::alloc_with_allocator(_memory_allocator.get()) : vespalib::alloc::Alloc::alloc());
 }
 
+void
+AttributeVector::end_load_phase(const char* phase)
+{
+    auto now = vespalib::steady_clock::now();
+    _load_phase_times.emplace_back(phase, now - _load_phase_start);
+    _load_phase_start = now;
+}
+
 void
 AttributeVector::set_size_on_disk(const IAttributeSaveTarget& target)
 {
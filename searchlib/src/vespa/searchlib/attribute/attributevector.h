@@ -112,6 +112,8 @@ public:
     using GenerationHandler = vespalib::GenerationHandler;
     using GenerationHolder = vespalib::GenerationHolder;
     using generation_t = GenerationHandler::generation_t;
+    // Time spent in each phase of loading the attribute, in the order the phases were performed
+    using LoadPhaseTimes = std::vector<std::pair<std::string, vespalib::duration>>;
 
     ~AttributeVector() override;
 protected:
@@ -296,6 +298,11 @@ public:
     // Implements IAttributeVector
     uint32_t getNumDocs() const override final { return _status.getNumDocs(); }
     const std::atomic<uint32_t>& getCommittedDocIdLimitRef() noexcept { return _committedDocIdLimit; }
+    /**
+     * Returns true for the first caller in each generation. Used to advise only once per
+     * generation that the memory of a paged attribute will be scanned.
+     */
+    bool claim_scan_prefetch() const noexcept;
     void setCommittedDocIdLimit(uint32_t committedDocIdLimit) {
         _committedDocIdLimit.store(committedDocIdLimit, std::memory_order_release);
     }
@@ -431,11 +438,18 @@ private:
     vespalib::steady_time                 _nextStatUpdateTime;
     std::shared_ptr<vespalib::alloc::MemoryAllocator> _memory_allocator;
     std::atomic<uint64_t>                 _size_on_disk;
+    mutable std::atomic<generation_t>     _scan_prefetch_generation; // one past generation of last scan prefetch
+    vespalib::steady_time                 _load_phase_start;
+    LoadPhaseTimes                        _load_phase_times;
 
     /// Clean up [0, firstUsed>
     virtual void reclaim_memory(generation_t oldest_used_gen);
     virtual void before_inc_generation(generation_t current_gen);
     virtual void onUpdateStat() = 0;
+    // Report tiering of memory areas for paged attributes, see MmapFileAllocatorTiers
+    void update_paged_memory_stats();
+    // Sample stats for memory allocated with a huge page or NUMA policy, see MmapPolicyAllocator
+    void update_policy_memory_stats();
     friend class AttributeTest;
 
 public:
@@ -503,6 +517,13 @@ public:
     void set_size_on_disk(uint64_t value) noexcept {_size_on_disk.store(value, std::memory_order_release); }
     void set_size_on_disk(const IAttributeSaveTarget& target);
     uint64_t size_on_disk() const noexcept { return _size_on_disk.load(std::memory_order_acquire); }
+
+    /*
+     * Record the time spent in a phase of loading this attribute, i.e. the
+     * time since the previous phase ended (or since load() was called).
+     */
+    void end_load_phase(const char* phase);
+    const LoadPhaseTimes& get_load_phase_times() const noexcept { return _load_phase_times; }
 };
 
 }
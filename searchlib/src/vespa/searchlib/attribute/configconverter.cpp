@@ -81,6 +81,44 @@ convert_dictionary(const AttributesConfig::Attribute::Dictionary & dictionary) {
     return {convert(dictionary.type), convert(dictionary.match)};
 }
 
+vespalib::alloc::MemoryPolicy
+convert_memory_policy(const AttributesConfig::Attribute::Memory & memory) {
+    using MemoryPolicy = vespalib::alloc::MemoryPolicy;
+    using CfgHugePages = AttributesConfig::Attribute::Memory::Hugepages;
+    using CfgNuma = AttributesConfig::Attribute::Memory::Numa;
+    MemoryPolicy::HugePages huge_pages = MemoryPolicy::HugePages::DEFAULT;
+    switch (memory.hugepages) {
+    case CfgHugePages::DEFAULT:
+        huge_pages = MemoryPolicy::HugePages::DEFAULT;
+        break;
+    case CfgHugePages::NONE:
+        huge_pages = MemoryPolicy::HugePages::NONE;
+        break;
+    case CfgHugePages::TRANSPARENT:
+        huge_pages = MemoryPolicy::HugePages::TRANSPARENT;
+        break;
+    case CfgHugePages::EXPLICIT_2M:
+        huge_pages = MemoryPolicy::HugePages::EXPLICIT_2M;
+        break;
+    case CfgHugePages::EXPLICIT_1G:
+        huge_pages = MemoryPolicy::HugePages::EXPLICIT_1G;
+        break;
+    }
+    MemoryPolicy::Numa numa = MemoryPolicy::Numa::DEFAULT;
+    switch (memory.numa) {
+    case CfgNuma::DEFAULT:
+        numa = MemoryPolicy::Numa::DEFAULT;
+        break;
+    case CfgNuma::INTERLEAVE:
+        numa = MemoryPolicy::Numa::INTERLEAVE;
+        break;
+    case CfgNuma::BIND:
+        numa = MemoryPolicy::Numa::BIND;
+        break;
+    }
+    return {huge_pages, numa, static_cast<uint64_t>(memory.numanodes)};
+}
+
 Config::Match
 convertMatch(AttributesConfig::Attribute::Match match_cfg) {
     switch (match_cfg) {
@@ -108,6 +146,7 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setFastAccess(cfg.fastaccess);
     retval.setMutable(cfg.ismutable);
     retval.setPaged(cfg.paged);
+    retval.set_memory_policy(convert_memory_policy(cfg.memory));
     retval.setMaxUnCommittedMemory(cfg.maxuncommittedmemory);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
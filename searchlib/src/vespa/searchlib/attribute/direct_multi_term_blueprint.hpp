@@ -88,7 +88,10 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::create_iterators(std::ve
     std::vector<int32_t> result_weights;
     for (size_t i = 0; i < _terms.size(); ++i) {
         const auto& r = _terms[i];
-        if (use_bitvector_when_available && _attr.has_bitvector(r.posting_idx)) {
+        // Frozen bitvector posting lists might have dropped their btree
+        if ((use_bitvector_when_available || !_attr.has_btree_iterator(r.posting_idx)) &&
+            _attr.has_bitvector(r.posting_idx))
+        {
             if (bitvectors.empty()) {
                 // With a combination of weight iterators and bitvectors,
                 // ensure that the resulting weight vector matches the weight iterators.
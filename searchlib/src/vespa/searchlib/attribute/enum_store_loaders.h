@@ -6,6 +6,7 @@
 #include "loadedenumvalue.h"
 
 namespace search { class IEnumStore; }
+namespace vespalib { class Executor; }
 
 namespace search::enumstore {
 
@@ -78,8 +79,8 @@ public:
     void reserve_loaded_enums(size_t num_values) {
         _loaded_enums.reserve(num_values);
     }
-    void sort_loaded_enums() {
-        attribute::sortLoadedByEnum(_loaded_enums);
+    void sort_loaded_enums(vespalib::Executor* executor) {
+        attribute::sortLoadedByEnum(_loaded_enums, executor);
     }
     bool is_folded_change(Index lhs, Index rhs) const;
     void set_ref_count(Index idx, uint32_t ref_count);
@@ -0,0 +1,34 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "frame_of_reference_estimate.h"
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+
+namespace search::attribute {
+
+template <typename T>
+size_t
+estimate_frame_of_reference_bytes(std::span<const T> values) noexcept
+{
+    static_assert(std::is_integral_v<T>, "Only integer values can be compressed");
+    using UT = std::make_unsigned_t<T>;
+    size_t num_words = 0;
+    size_t num_blocks = 0;
+    for (size_t start = 0; start < values.size(); start += frame_of_reference_block_size, ++num_blocks) {
+        auto block_values = values.subspan(start, std::min(size_t(frame_of_reference_block_size), values.size() - start));
+        auto [min_it, max_it] = std::minmax_element(block_values.begin(), block_values.end());
+        UT max_delta = static_cast<UT>(*max_it) - static_cast<UT>(*min_it);
+        size_t bits = std::bit_width(static_cast<uint64_t>(max_delta));
+        num_words += (block_values.size() * bits + 63) / 64;
+    }
+    // Each block stores its minimum value and the bit width of its offsets.
+    return num_blocks * (sizeof(T) + 1) + num_words * sizeof(uint64_t);
+}
+
+template size_t estimate_frame_of_reference_bytes<int8_t>(std::span<const int8_t>) noexcept;
+template size_t estimate_frame_of_reference_bytes<int16_t>(std::span<const int16_t>) noexcept;
+template size_t estimate_frame_of_reference_bytes<int32_t>(std::span<const int32_t>) noexcept;
+template size_t estimate_frame_of_reference_bytes<int64_t>(std::span<const int64_t>) noexcept;
+
+}
@@ -0,0 +1,26 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace search::attribute {
+
+constexpr uint32_t frame_of_reference_block_size = 128;
+
+/**
+ * Estimates how many bytes the given integer values would use with frame
+ * of reference compression, without compressing them.
+ *
+ * The values are split into blocks of frame_of_reference_block_size
+ * values. Each block stores its minimum value (the frame of reference) and
+ * the bit width of its offsets, followed by the offsets from that minimum
+ * bit-packed into 64-bit words. A block where all values are equal uses no
+ * words at all.
+ */
+template <typename T>
+size_t estimate_frame_of_reference_bytes(std::span<const T> values) noexcept;
+
+}
@@ -63,6 +63,8 @@ public:
      * Returns true when btree posting list iterators are present for all terms.
      *
      * This means btree posting lists exist in addition to eventual bitvector posting lists.
+     * Bitvector posting lists that have been frozen might still lack a btree posting list,
+     * see has_btree_iterator().
      */
     virtual bool has_always_btree_iterator() const noexcept = 0;
     virtual ~IDirectPostingStore() = default;
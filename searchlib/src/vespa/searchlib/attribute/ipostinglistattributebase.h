@@ -21,6 +21,7 @@ public:
     virtual PostingStoreMemoryUsage getMemoryUsage() const = 0;
     virtual bool consider_compact_worst_btree_nodes(const CompactionStrategy& compaction_strategy) = 0;
     virtual bool consider_compact_worst_buffers(const CompactionStrategy& compaction_strategy) = 0;
+    virtual bool consider_drop_btrees_of_frozen_bitvectors() = 0;
 };
 
 }
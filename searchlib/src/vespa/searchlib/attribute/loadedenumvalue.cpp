@@ -2,19 +2,134 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <algorithm>
+
+using vespalib::CpuUsage;
 
 namespace search::attribute {
 
+namespace {
+
+// Minimal number of loaded values for each part when sorting in parallel
+constexpr size_t min_values_per_part = 256_Ki;
+constexpr uint32_t max_parts = 16;
+// Number of sampled values for each part when selecting the range splitters
+constexpr uint32_t samples_per_part = 64;
+
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+sort_range(LoadedEnumAttribute* begin, size_t size)
 {
     ShiftBasedRadixSorter<LoadedEnumAttribute,
         LoadedEnumAttribute::EnumRadix,
         LoadedEnumAttribute::EnumCompare, 56>::
         radix_sort(LoadedEnumAttribute::EnumRadix(),
                    LoadedEnumAttribute::EnumCompare(),
-                   loaded.data(), loaded.size(), 16);
+                   begin, size, 16);
+}
+
+/*
+ * Run func(part) for all parts using the executor, and wait for all
+ * parts to complete. Parts rejected by the executor are run in the
+ * calling thread.
+ */
+template <typename Func>
+void
+run_parts(vespalib::Executor& executor, uint32_t num_parts, const Func& func)
+{
+    vespalib::CountDownLatch latch(num_parts);
+    for (uint32_t part = 0; part < num_parts; ++part) {
+        auto task = vespalib::makeLambdaTask([&func, &latch, part]() {
+            func(part);
+            latch.countDown();
+        });
+        auto rejected = executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+}
+
 }
 
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+{
+    sort_range(loaded.data(), loaded.size());
 }
 
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor* executor)
+{
+    size_t num_values = loaded.size();
+    uint32_t num_parts = std::min(static_cast<size_t>(max_parts), num_values / min_values_per_part);
+    if (executor == nullptr || num_parts < 2) {
+        sortLoadedByEnum(loaded);
+        return;
+    }
+    /*
+     * Values are partitioned on (enum, docid) range, one range per part.
+     * The range splitters are picked from a sorted sample of the values,
+     * giving ranges with about the same number of values, also when a few
+     * enum values are used by most documents. The values are counted per
+     * range in parallel, moved to their ranges in place, and the ranges
+     * are then sorted in parallel. Since the ranges are ordered, the
+     * concatenation of the sorted ranges is the result.
+     */
+    LoadedEnumAttribute::EnumCompare compare;
+    std::vector<LoadedEnumAttribute> samples;
+    uint32_t num_samples = num_parts * samples_per_part;
+    samples.reserve(num_samples);
+    for (uint32_t i = 0; i < num_samples; ++i) {
+        samples.push_back(loaded[(i * num_values) / num_samples]);
+    }
+    std::sort(samples.begin(), samples.end(), compare);
+    std::vector<LoadedEnumAttribute> splitters;
+    splitters.reserve(num_parts - 1);
+    for (uint32_t range = 1; range < num_parts; ++range) {
+        splitters.push_back(samples[range * samples_per_part]);
+    }
+    auto range_of = [&splitters, compare](const LoadedEnumAttribute& value) noexcept {
+        return static_cast<uint32_t>(std::upper_bound(splitters.begin(), splitters.end(), value, compare) - splitters.begin());
+    };
+    auto input_begin = [num_values, num_parts](uint32_t part) noexcept {
+        return (part * num_values) / num_parts;
+    };
+    // counts[part * num_parts + range] is the number of values in the range for the part of the input
+    std::vector<size_t> counts(num_parts * num_parts, 0);
+    run_parts(*executor, num_parts, [&](uint32_t part) {
+        size_t* part_counts = &counts[part * num_parts];
+        for (size_t i = input_begin(part), end = input_begin(part + 1); i < end; ++i) {
+            ++part_counts[range_of(loaded[i])];
+        }
+    });
+    std::vector<size_t> range_begin(num_parts + 1, 0);
+    for (uint32_t range = 0; range < num_parts; ++range) {
+        size_t count = 0;
+        for (uint32_t part = 0; part < num_parts; ++part) {
+            count += counts[part * num_parts + range];
+        }
+        range_begin[range + 1] = range_begin[range] + count;
+    }
+    // Move each value to its range by following permutation cycles, without a copy of the values.
+    std::vector<size_t> next(range_begin.begin(), range_begin.end() - 1);
+    for (uint32_t range = 0; range < num_parts; ++range) {
+        while (next[range] < range_begin[range + 1]) {
+            LoadedEnumAttribute value = loaded[next[range]];
+            for (uint32_t dest = range_of(value); dest != range; dest = range_of(value)) {
+                std::swap(value, loaded[next[dest]++]);
+            }
+            loaded[next[range]++] = value;
+        }
+    }
+    run_parts(*executor, num_parts, [&](uint32_t range) {
+        sort_range(loaded.data() + range_begin[range], range_begin[range + 1] - range_begin[range]);
+    });
+}
+
+}
@@ -7,6 +7,8 @@
 #include <limits>
 #include <span>
 
+namespace vespalib { class Executor; }
+
 namespace search::attribute {
 
 /**
@@ -139,4 +141,11 @@ public:
 
 void sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
 
+/*
+ * Sort loaded values by enum and docid. When an executor is given, large
+ * vectors are partitioned in place on (enum, docid) range and the
+ * partitions are sorted in parallel.
+ */
+void sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor* executor);
+
 }
@@ -32,7 +32,16 @@ private:
     using ConstArrayRef = std::span<const ElemT>;
 
     ArrayStore _store;
+    // Compaction in progress, spread across multiple calls to consider_compact()
+    vespalib::datastore::ICompactionContext::UP _compaction_context;
+    uint32_t _compaction_next_docid;
+
+    void compact_step(uint32_t step_docs);
 public:
+    // A compaction is performed in at most this number of steps, limiting the time spent in each step.
+    static constexpr uint32_t max_compaction_steps = 64;
+    static constexpr uint32_t min_compaction_step_docs = 16384;
+
     MultiValueMapping(const MultiValueMapping &) = delete;
     MultiValueMapping & operator = (const MultiValueMapping &) = delete;
     MultiValueMapping(const vespalib::datastore::ArrayStoreConfig &storeCfg,
@@ -64,13 +73,14 @@ public:
     vespalib::AddressSpace getAddressSpaceUsage() const override;
     vespalib::MemoryUsage getArrayStoreMemoryUsage() const override;
     vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy);
-    bool consider_compact(const CompactionStrategy &compactionStrategy) {
-        if (_store.consider_compact()) {
-            compact_worst(compactionStrategy);
-            return true;
-        }
-        return false;
-    }
+    /*
+     * Start a new compaction or continue the one in progress. Each call
+     * moves the arrays for a limited range of documents, and the buffers
+     * being compacted are put on hold when all documents have been visited.
+     * Returns true if anything was done, and a new generation is then needed.
+     */
+    bool consider_compact(const CompactionStrategy &compactionStrategy);
+    bool compaction_in_progress() const noexcept { return static_cast<bool>(_compaction_context); }
     void compact_worst(const CompactionStrategy& compaction_strategy);
     bool has_free_lists_enabled() const { return _store.has_free_lists_enabled(); }
     // Set compaction spec. Only used by unit tests.
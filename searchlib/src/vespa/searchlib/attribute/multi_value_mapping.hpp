@@ -4,6 +4,8 @@
 
 #include "multi_value_mapping.h"
 #include <vespa/vespalib/datastore/array_store.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace search::attribute {
 
@@ -13,7 +15,9 @@ MultiValueMapping<ElemT,RefT>::MultiValueMapping(const vespalib::datastore::Arra
                                                   const vespalib::GrowStrategy &gs,
                                                   std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator)
   : MultiValueMappingBase(gs, ArrayStore::getGenerationHolderLocation(_store), memory_allocator),
-    _store(storeCfg, std::move(memory_allocator), ArrayStoreTypeMapper(storeCfg.max_type_id(), array_store_grow_factor, max_buffer_size))
+    _store(storeCfg, std::move(memory_allocator), ArrayStoreTypeMapper(storeCfg.max_type_id(), array_store_grow_factor, max_buffer_size)),
+    _compaction_context(),
+    _compaction_next_docid(0)
 {
 }
 
@@ -41,14 +45,50 @@ MultiValueMapping<ElemT,RefT>::update_stat(const CompactionStrategy& compaction_
     return retval;
 }
 
+template <typename ElemT, typename RefT>
+void
+MultiValueMapping<ElemT,RefT>::compact_step(uint32_t step_docs)
+{
+    uint32_t size = _indices.size();
+    uint32_t end_docid = std::min(size, _compaction_next_docid + std::min(step_docs, size));
+    if (_compaction_next_docid < end_docid) {
+        _compaction_context->compact(std::span<AtomicEntryRef>(&_indices[_compaction_next_docid],
+                                                               end_docid - _compaction_next_docid));
+    }
+    _compaction_next_docid = end_docid;
+    if (_compaction_next_docid >= size) {
+        // All documents visited, buffers being compacted are put on hold
+        _compaction_context.reset();
+        _compaction_next_docid = 0;
+    }
+}
+
+template <typename ElemT, typename RefT>
+bool
+MultiValueMapping<ElemT,RefT>::consider_compact(const CompactionStrategy& compaction_strategy)
+{
+    if (!_compaction_context) {
+        if (!_store.consider_compact()) {
+            return false;
+        }
+        _compaction_context = _store.compact_worst(compaction_strategy);
+        _compaction_next_docid = 0;
+    }
+    compact_step(std::max(min_compaction_step_docs, static_cast<uint32_t>(_indices.size() / max_compaction_steps)));
+    return true;
+}
+
 template <typename ElemT, typename RefT>
 void
 MultiValueMapping<ElemT,RefT>::compact_worst(const CompactionStrategy& compaction_strategy)
 {
-    vespalib::datastore::ICompactionContext::UP compactionContext(_store.compact_worst(compaction_strategy));
-    if (compactionContext) {
-        compactionContext->compact(std::span<AtomicEntryRef>(&_indices[0], _indices.size()));
+    if (_compaction_context) {
+        // Complete compaction in progress before starting a new one
+        compact_step(std::numeric_limits<uint32_t>::max());
     }
+    _compaction_context = _store.compact_worst(compaction_strategy);
+    _compaction_next_docid = 0;
+    compact_step(std::numeric_limits<uint32_t>::max());
 }
 
 template <typename ElemT, typename RefT>
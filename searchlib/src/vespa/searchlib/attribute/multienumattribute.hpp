@@ -11,6 +11,7 @@
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/vespalib/stllike/hashtable.hpp>
 #include <vespa/vespalib/datastore/unique_store_remapper.h>
+#include <vespa/vespalib/util/time.h>
 
 namespace search {
 
@@ -104,7 +105,6 @@ MultiValueEnumAttribute<B, M>::load_enumerated_data(ReaderBase& attrReader,
                                                              loader.get_enum_value_remapping(),
                                                              attribute::SaveLoadedEnum(loader.get_loaded_enums()));
     loader.free_enum_value_remapping();
-    loader.sort_loaded_enums();
     this->checkSetMaxValueCount(maxvc);
 }
 
@@ -148,7 +148,10 @@ MultiValueEnumAttribute<B, M>::onCommit()
     this->freezeEnumDictionary();
     std::atomic_thread_fence(std::memory_order_release);
     this->reclaim_unused_memory();
+    auto compaction_start = vespalib::steady_clock::now();
+    bool compacted = false;
     if (this->_mvMapping.consider_compact(this->getConfig().getCompactionStrategy())) {
+        compacted = true;
         this->incGeneration();
         this->updateStat(true);
     }
@@ -157,24 +160,31 @@ MultiValueEnumAttribute<B, M>::onCommit()
         multienumattribute::remap_enum_store_refs(*remapper, *this, this->_mvMapping);
         remapper->done();
         remapper.reset();
+        compacted = true;
         this->incGeneration();
         this->updateStat(true);
     }
     if (this->_enumStore.consider_compact_dictionary(this->getConfig().getCompactionStrategy())) {
+        compacted = true;
         this->incGeneration();
         this->updateStat(true);
     }
     auto *pab = this->getIPostingListAttributeBase();
     if (pab != nullptr) {
         if (pab->consider_compact_worst_btree_nodes(this->getConfig().getCompactionStrategy())) {
+            compacted = true;
             this->incGeneration();
             this->updateStat(true);
         }
         if (pab->consider_compact_worst_buffers(this->getConfig().getCompactionStrategy())) {
+            compacted = true;
             this->incGeneration();
             this->updateStat(true);
         }
     }
+    if (compacted) {
+        this->getStatus().add_compaction_time(vespalib::steady_clock::now() - compaction_start);
+    }
 }
 
 template <typename B, typename M>
@@ -12,6 +12,7 @@
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/query/query_term_simple.h>
 #include <vespa/searchlib/util/fileutil.h>
+#include <vespa/vespalib/util/time.h>
 
 namespace search {
 
@@ -67,7 +68,9 @@ MultiValueNumericAttribute<B, M>::onCommit()
     this->reclaim_unused_memory();
 
     this->_changes.clear();
+    auto compaction_start = vespalib::steady_clock::now();
     if (this->_mvMapping.consider_compact(this->getConfig().getCompactionStrategy())) {
+        this->getStatus().add_compaction_time(vespalib::steady_clock::now() - compaction_start);
         this->incGeneration();
         this->updateStat(true);
     }
@@ -54,7 +54,7 @@ MultiValueNumericEnumAttribute<B, M>::loadAllAtOnce(AttributeReader & attrReader
 
 template <typename B, typename M>
 bool
-MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase &attrReader)
+MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor* executor)
 {
     auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
 
@@ -74,10 +74,14 @@ MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase &attrReader)
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
         loader.build_enum_value_remapping();
         this->load_enumerated_data(attrReader, loader, numValues);
+        this->end_load_phase("read");
+        loader.sort_loaded_enums(executor);
+        this->end_load_phase("sort");
         if (numDocs > 0) {
             this->onAddDoc(numDocs - 1);
         }
         this->load_posting_lists_and_update_enum_store(loader);
+        this->end_load_phase("posting_lists");
     } else {
         auto loader = this->getEnumStore().make_enumerated_loader();
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
@@ -90,7 +94,7 @@ MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase &attrReader)
 
 template <typename B, typename M>
 bool
-MultiValueNumericEnumAttribute<B, M>::onLoad(vespalib::Executor *)
+MultiValueNumericEnumAttribute<B, M>::onLoad(vespalib::Executor *executor)
 {
     AttributeReader attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -106,7 +110,7 @@ MultiValueNumericEnumAttribute<B, M>::onLoad(vespalib::Executor *)
     this->setCreateSerialNum(attrReader.getCreateSerialNum());
 
     if (attrReader.getEnumerated()) {
-        return onLoadEnumerated(attrReader);
+        return onLoadEnumerated(attrReader, executor);
     }
     
     size_t numDocs = attrReader.getNumIdx() - 1;
@@ -193,6 +193,13 @@ PostingListAttributeBase<P>::consider_compact_worst_buffers(const CompactionStra
     return _posting_store.consider_compact_worst_buffers(compaction_strategy);
 }
 
+template <typename P>
+bool
+PostingListAttributeBase<P>::consider_drop_btrees_of_frozen_bitvectors()
+{
+    return _posting_store.consider_drop_btrees_of_frozen_bitvectors(vespalib::steady_clock::now());
+}
+
 template <typename P, typename LoadedVector, typename LoadedValueType,
           typename EnumStoreType>
 PostingListAttributeSubBase<P, LoadedVector, LoadedValueType, EnumStoreType>::
@@ -69,6 +69,7 @@ protected:
     attribute::PostingStoreMemoryUsage getMemoryUsage() const override;
     bool consider_compact_worst_btree_nodes(const CompactionStrategy& compaction_strategy) override;
     bool consider_compact_worst_buffers(const CompactionStrategy& compaction_strategy) override;
+    bool consider_drop_btrees_of_frozen_bitvectors() override;
 
 public:
     const PostingStore & get_posting_store() const { return _posting_store; }
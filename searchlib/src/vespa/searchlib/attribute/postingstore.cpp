@@ -28,6 +28,7 @@ PostingStoreBase2::PostingStoreBase2(IEnumStoreDictionary& dictionary, Status &s
       _status(status),
       _bvExtraBytes(0),
       _compaction_spec(),
+      _next_frozen_check(),
       _isFilter(config.getIsFilter())
 { }
 
@@ -57,6 +58,17 @@ PostingStoreBase2::resizeBitVectors(uint32_t newSize, uint32_t newCapacity)
 }
 
 
+bool
+PostingStoreBase2::consider_drop_btrees_of_frozen_bitvectors(vespalib::steady_time now)
+{
+    if (now < _next_frozen_check) {
+        return false;
+    }
+    _next_frozen_check = now + frozen_check_interval;
+    return drop_btrees_of_frozen_bitvectors();
+}
+
+
 template <typename DataT>
 PostingStore<DataT>::PostingStore(IEnumStoreDictionary& dictionary, Status &status, const Config &config)
     : Parent(false),
@@ -162,6 +174,73 @@ PostingStore<DataT>::consider_remove_sparse_bitvector(std::vector<EntryRef>& ref
     }
 }
 
+template <typename DataT>
+bool
+PostingStore<DataT>::drop_btrees_of_frozen_bitvectors()
+{
+    if (!drops_frozen_btrees || isFilter()) {
+        return false;
+    }
+    bool has_frozen = false;
+    for (auto &i : _bvs) {
+        const BitVectorEntry *bve = getBitVectorEntry(RefType(EntryRef(i)));
+        if (!bve->_changed && bve->_tree.valid()) {
+            has_frozen = true;
+            break;
+        }
+    }
+    if (has_frozen) {
+        EntryRefFilter filter(RefType::numBuffers(), RefType::offset_bits);
+        filter.add_buffers(_bvType.get_active_buffers());
+        _dictionary.normalize_posting_lists([this](std::vector<EntryRef>& refs)
+                                            { drop_frozen_btrees(refs); },
+                                            filter);
+    }
+    // Start a new period for detecting frozen posting lists
+    for (auto &i : _bvs) {
+        getWBitVectorEntry(RefType(EntryRef(i)))->_changed = false;
+    }
+    return has_frozen;
+}
+
+template <typename DataT>
+void
+PostingStore<DataT>::drop_frozen_btrees(std::vector<EntryRef>& refs)
+{
+    for (auto& ref : refs) {
+        RefType iRef(ref);
+        assert(iRef.valid());
+        uint32_t typeId = getTypeId(iRef);
+        (void) typeId;
+        assert(isBitVector(typeId));
+        const BitVectorEntry *bve = getBitVectorEntry(iRef);
+        if (bve->_changed || !bve->_tree.valid()) {
+            continue;
+        }
+        RefType iRef2(bve->_tree);
+        assert(isBTree(iRef2));
+        auto bPair = allocBitVectorCopy(*bve);
+        bPair.data->_tree = EntryRef();
+        /*
+         * The btree nodes are handed to a copy of the tree root, which is
+         * cleared. The old tree root keeps its frozen root, so readers using
+         * the old entry see all docids until the held nodes are reclaimed.
+         * Clearing the old tree root would give them an empty posting list
+         * after the next freeze.
+         */
+        BTreeType *tree = getWTreeEntry(iRef2);
+        auto ref_and_ptr = allocBTreeCopy(*tree);
+        tree->prepare_hold();
+        ref_and_ptr.data->clear(_allocator);
+        _store.hold_entry(ref_and_ptr.ref);
+        _store.hold_entry(iRef2);
+        _store.hold_entry(iRef);
+        _bvs.erase(iRef.ref());
+        _bvs.insert(bPair.ref.ref());
+        ref = bPair.ref;
+    }
+}
+
 template <typename DataT>
 void
 PostingStore<DataT>::applyNew(EntryRef &ref, AddIter a, AddIter ae)
@@ -359,6 +438,21 @@ PostingStore<DataT>::apply(EntryRef &ref, AddIter a, AddIter ae, RemoveIter r, R
     // ... or old data was bitvector
     if (isBitVector(typeId)) {
         BitVectorEntry *bve = getWBitVectorEntry(iRef);
+        bve->_changed = true;
+        if (!bve->_tree.valid() && !isFilter()) {
+            // Posting list is no longer frozen, recreate btree in a copy of the entry, as
+            // readers might be using the old entry
+            EntryRef tree_ref;
+            makeDegradedTree(tree_ref, bve->_bv->writer());
+            auto bPair = allocBitVectorCopy(*getBitVectorEntry(iRef));
+            bPair.data->_tree = tree_ref;
+            _store.hold_entry(iRef);
+            _bvs.erase(iRef.ref());
+            _bvs.insert(bPair.ref.ref());
+            ref = bPair.ref;
+            iRef = ref;
+            bve = bPair.data;
+        }
         EntryRef ref2(bve->_tree);
         RefType iRef2(ref2);
         if (iRef2.valid()) {
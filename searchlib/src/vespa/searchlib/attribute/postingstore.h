@@ -6,6 +6,7 @@
 #include "posting_store_compaction_spec.h"
 #include "posting_store_memory_usage.h"
 #include "postinglisttraits.h"
+#include <vespa/vespalib/util/time.h>
 #include <set>
 
 namespace search {
@@ -26,11 +27,13 @@ class BitVectorEntry
 public:
     vespalib::datastore::EntryRef _tree; // Daisy chained reference to tree based posting list
     std::shared_ptr<GrowableBitVector> _bv; // bitvector
+    bool _changed; // Changed since last check for frozen posting lists
 
 public:
     BitVectorEntry() noexcept
         : _tree(),
-          _bv()
+          _bv(),
+          _changed(true)
     { }
 };
 
@@ -48,6 +51,7 @@ protected:
     Status                    &_status;
     uint64_t                   _bvExtraBytes;
     PostingStoreCompactionSpec _compaction_spec;
+    vespalib::steady_time      _next_frozen_check;
 private:
     bool                       _isFilter;
 
@@ -57,6 +61,15 @@ public:
     virtual ~PostingStoreBase2();
     bool resizeBitVectors(uint32_t newSize, uint32_t newCapacity);
     virtual bool removeSparseBitVectors() = 0;
+    virtual bool drop_btrees_of_frozen_bitvectors() = 0;
+    /*
+     * Drop btrees of frozen bitvector posting lists if enough time has
+     * passed since the last check.
+     */
+    bool consider_drop_btrees_of_frozen_bitvectors(vespalib::steady_time now);
+
+    // Interval between checks. A bitvector posting list unchanged for a full interval is frozen.
+    static constexpr vespalib::duration frozen_check_interval = std::chrono::minutes(5);
 
     // Only used by unit test.
     const PostingStoreCompactionSpec& get_compaction_spec() const noexcept { return _compaction_spec; }
@@ -68,6 +81,12 @@ class PostingStore : public PostingListTraits<DataT>::PostingStoreBase,
 {
     vespalib::datastore::BufferType<BitVectorEntry> _bvType;
 public:
+    /*
+     * Without weights the btree next to a bitvector is redundant, and it is
+     * dropped when the posting list is frozen (unchanged for a while).
+     */
+    static constexpr bool drops_frozen_btrees = std::is_same_v<DataT, vespalib::btree::BTreeNoLeafData>;
+
     using DataType = DataT;
     using Parent = typename PostingListTraits<DataT>::PostingStoreBase;
     using AddIter = typename Parent::AddIter;
@@ -113,6 +132,13 @@ public:
 
     bool removeSparseBitVectors() override;
     void consider_remove_sparse_bitvector(std::vector<EntryRef> &refs);
+    /*
+     * Drop the btree of bitvector posting lists not changed since the
+     * previous call, leaving the bitvector as the compact representation of
+     * the frozen posting list. A later change recreates the btree.
+     */
+    bool drop_btrees_of_frozen_bitvectors() override;
+    void drop_frozen_btrees(std::vector<EntryRef> &refs);
     static bool isBitVector(uint32_t typeId) noexcept { return typeId == BUFFERTYPE_BITVECTOR; }
 
     void applyNew(EntryRef &ref, AddIter a, AddIter ae);
@@ -189,7 +215,8 @@ public:
         return _store.template getEntry<BitVectorEntry>(ref);
     }
     bool has_btree(const EntryRef ref) const noexcept {
-        return !ref.valid() || !isBitVector(getTypeId(RefType(ref))) || !isFilter();
+        RefType iRef(ref);
+        return !iRef.valid() || !isBitVector(getTypeId(iRef)) || getBitVectorEntry(iRef)->_tree.valid();
     }
     bool has_bitvector(const EntryRef ref) const noexcept {
         return ref.valid() && isBitVector(getTypeId(RefType(ref)));
@@ -4,12 +4,22 @@
 #include "attributevector.h"
 #include "attributeiterators.hpp"
 #include "ipostinglistsearchcontext.h"
+#include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 
 using search::queryeval::SearchIterator;
 
 namespace search::attribute {
 
+void
+SearchContext::prefetch_for_scan(const void* data, size_t size) const
+{
+    if (_attr.getConfig().paged() && _attr.claim_scan_prefetch()) {
+        vespalib::alloc::MmapFileAllocator::prefetch(data, size);
+    }
+}
+
 HitEstimate
 SearchContext::calc_hit_estimate() const
 {
@@ -55,6 +55,10 @@ protected:
     const AttributeVector&                _attr;
     attribute::IPostingListSearchContext* _plsc;
 
+    // Advise that the memory will be scanned by a strict iterator. Only has an effect for paged attributes,
+    // and only for the first strict iterator in each generation of the attribute.
+    void prefetch_for_scan(const void* data, size_t size) const;
+
     /**
      * Creates an attribute search iterator associated with this
      * search context. Postings lists are not used.
@@ -22,6 +22,9 @@ SingleNumericSearchContext<T, M>::createFilterIterator(fef::TermFieldMatchData*
     if (!this->valid()) {
         return std::make_unique<queryeval::EmptySearch>();
     }
+    if (strict) {
+        this->prefetch_for_scan(_data.data(), _data.size_bytes());
+    }
     if (this->getIsFilter()) {
         return strict
             ? std::make_unique<FilterAttributeIteratorStrict<SingleNumericSearchContext<T, M>>>(*this, matchData)
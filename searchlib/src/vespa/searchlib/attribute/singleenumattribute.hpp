@@ -10,6 +10,7 @@
 #include "enum_store_loaders.h"
 #include "valuemodifier.h"
 #include <vespa/vespalib/datastore/unique_store_remapper.h>
+#include <vespa/vespalib/util/time.h>
 
 namespace search {
 
@@ -96,28 +97,41 @@ SingleValueEnumAttribute<B>::onCommit()
     freezeEnumDictionary();
     std::atomic_thread_fence(std::memory_order_release);
     this->reclaim_unused_memory();
+    auto compaction_start = vespalib::steady_clock::now();
+    bool compacted = false;
     auto remapper = this->_enumStore.consider_compact_values(this->getConfig().getCompactionStrategy());
     if (remapper) {
         remap_enum_store_refs(*remapper, *this);
         remapper->done();
         remapper.reset();
+        compacted = true;
         this->incGeneration();
         this->updateStat(true);
     }
     if (this->_enumStore.consider_compact_dictionary(this->getConfig().getCompactionStrategy())) {
+        compacted = true;
         this->incGeneration();
         this->updateStat(true);
     }
     auto *pab = this->getIPostingListAttributeBase();
     if (pab != nullptr) {
         if (pab->consider_compact_worst_btree_nodes(this->getConfig().getCompactionStrategy())) {
+            compacted = true;
             this->incGeneration();
             this->updateStat(true);
         }
         if (pab->consider_compact_worst_buffers(this->getConfig().getCompactionStrategy())) {
+            compacted = true;
             this->incGeneration();
             this->updateStat(true);
         }
+        if (pab->consider_drop_btrees_of_frozen_bitvectors()) {
+            this->incGeneration();
+            this->updateStat(true);
+        }
+    }
+    if (compacted) {
+        this->getStatus().add_compaction_time(vespalib::steady_clock::now() - compaction_start);
     }
 }
 
@@ -235,7 +249,6 @@ SingleValueEnumAttribute<B>::load_enumerated_data(ReaderBase& attrReader,
                                              loader.get_enum_value_remapping(),
                                              attribute::SaveLoadedEnum(loader.get_loaded_enums()));
     loader.free_enum_value_remapping();
-    loader.sort_loaded_enums();
 }
     
 template <typename B>
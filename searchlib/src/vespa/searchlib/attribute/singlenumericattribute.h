@@ -29,6 +29,8 @@ private:
 
     DataVector _data;
 
+    static void update_compression_estimate(attribute::Status& status, std::span<const T> values);
+
     T getFromEnum(EnumHandle e) const override {
         (void) e;
         return T();
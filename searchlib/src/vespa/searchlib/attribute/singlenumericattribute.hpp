@@ -2,6 +2,7 @@
 #pragma once
 
 #include "attributevector.hpp"
+#include "frame_of_reference_estimate.h"
 #include "load_utils.h"
 #include "numeric_matcher.h"
 #include "numeric_range_matcher.h"
@@ -29,6 +30,15 @@ SingleValueNumericAttribute(const std::string & baseFileName, const AttributeVec
       _data(c.getGrowStrategy(), getGenerationHolder(), this->get_initial_alloc())
 { }
 
+template <typename B>
+void
+SingleValueNumericAttribute<B>::update_compression_estimate(attribute::Status& status, std::span<const T> values)
+{
+    if constexpr (std::is_integral_v<T>) {
+        status.update_compression_estimate(values.size_bytes(), attribute::estimate_frame_of_reference_bytes<T>(values));
+    }
+}
+
 template <typename B>
 SingleValueNumericAttribute<B>::~SingleValueNumericAttribute()
 {
@@ -124,6 +134,7 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
                                    udatBuffer->size() / sizeof(T));
     attribute::loadFromEnumeratedSingleValue(_data, getGenerationHolder(), attrReader,
                                              map, std::span<const uint32_t>(), attribute::NoSaveLoadedEnum());
+    update_compression_estimate(this->getStatus(), _data.make_read_view(numDocs));
     return true;
 }
 
@@ -155,6 +166,7 @@ SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
     B::setNumDocs(sz);
     B::setCommittedDocIdLimit(sz);
     this->set_size_on_disk(attrReader.size_on_disk());
+    update_compression_estimate(this->getStatus(), _data.make_read_view(sz));
 
     return true;
 }
@@ -212,8 +224,15 @@ SingleValueNumericAttribute<B>::onInitSave(std::string_view fileName)
 {
     const uint32_t numDocs(this->getCommittedDocIdLimit());
     assert(numDocs <= _data.size());
+    SingleValueNumericAttributeSaver::OnSave on_save;
+    if constexpr (std::is_integral_v<T>) {
+        // Measured on the copy made for the saver, outside the write thread.
+        on_save = [&status = this->getStatus()](const void *data, size_t size) {
+            update_compression_estimate(status, std::span<const T>(static_cast<const T *>(data), size / sizeof(T)));
+        };
+    }
     return std::make_unique<SingleValueNumericAttributeSaver>
-        (this->createAttributeHeader(fileName), &_data[0], numDocs * sizeof(T));
+        (this->createAttributeHeader(fileName), &_data[0], numDocs * sizeof(T), std::move(on_save));
 }
 
 }
@@ -12,9 +12,10 @@ namespace search {
 
 SingleValueNumericAttributeSaver::
 SingleValueNumericAttributeSaver(const attribute::AttributeHeader &header,
-                                 const void *data, size_t size)
+                                 const void *data, size_t size, OnSave on_save)
   : AttributeSaver(vespalib::GenerationHandler::Guard(), header),
-    _buf()
+    _buf(),
+    _on_save(std::move(on_save))
 {
     _buf = std::make_unique<BufferBuf>(size, FileSettings::DIRECTIO_ALIGNMENT);
     assert(_buf->getFreeLen() >= size);
@@ -30,6 +31,9 @@ SingleValueNumericAttributeSaver::~SingleValueNumericAttributeSaver() = default;
 bool
 SingleValueNumericAttributeSaver::onSave(IAttributeSaveTarget &saveTarget)
 {
+    if (_on_save) {
+        _on_save(_buf->getData(), _buf->getDataLen());
+    }
     saveTarget.datWriter().writeBuf(std::move(_buf));
     return true;
 }
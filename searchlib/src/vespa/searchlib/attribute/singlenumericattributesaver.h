@@ -4,6 +4,7 @@
 
 #include "attributesaver.h"
 #include "iattributefilewriter.h"
+#include <functional>
 
 namespace search {
 
@@ -15,15 +16,18 @@ class SingleValueNumericAttributeSaver : public AttributeSaver
 {
 public:
     using Buffer = IAttributeFileWriter::Buffer;
+    // Called with the saved data from the thread performing the save.
+    using OnSave = std::function<void(const void *data, size_t size)>;
 
 private:
     Buffer _buf;
+    OnSave _on_save;
     using BufferBuf = IAttributeFileWriter::BufferBuf;
 
     bool onSave(IAttributeSaveTarget &saveTarget) override;
 public:
     SingleValueNumericAttributeSaver(const attribute::AttributeHeader &header,
-                                     const void *data, size_t size);
+                                     const void *data, size_t size, OnSave on_save = OnSave());
 
     ~SingleValueNumericAttributeSaver() override;
 };
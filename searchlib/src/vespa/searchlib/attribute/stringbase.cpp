@@ -180,7 +180,7 @@ StringAttribute::apply(DocId, const ArithmeticValueUpdate & )
 }
 
 bool
-StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
+StringAttribute::onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor* executor)
 {
     auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
 
@@ -207,10 +207,14 @@ StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
         loader.build_enum_value_remapping();
         load_enumerated_data(attrReader, loader, numValues);
+        end_load_phase("read");
+        loader.sort_loaded_enums(executor);
+        end_load_phase("sort");
         if (numDocs > 0) {
             onAddDoc(numDocs - 1);
         }
         load_posting_lists_and_update_enum_store(loader);
+        end_load_phase("posting_lists");
     } else {
         auto loader = this->getEnumStoreBase()->make_enumerated_loader();
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
@@ -221,7 +225,7 @@ StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
 }
 
 bool
-StringAttribute::onLoad(vespalib::Executor *)
+StringAttribute::onLoad(vespalib::Executor *executor)
 {
     ReaderBase attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -237,7 +241,7 @@ StringAttribute::onLoad(vespalib::Executor *)
     setCreateSerialNum(attrReader.getCreateSerialNum());
 
     assert(attrReader.getEnumerated());
-    return onLoadEnumerated(attrReader);
+    return onLoadEnumerated(attrReader, executor);
 }
 
 bool
@@ -3,8 +3,10 @@
 #include "sortresults.h"
 #include "sort.h"
 #include <vespa/searchcommon/attribute/iattributecontext.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/util/array.h>
 #include <vespa/vespalib/util/issue.h>
+#include <numeric>
 
 using vespalib::Issue;
 
@@ -161,6 +163,90 @@ FastS_DefaultResultSorter FastS_DefaultResultSorter::_instance;
 
 //-----------------------------------------------------------------------------
 
+namespace {
+
+bool
+useOrdinalSortKeys(const FastS_SortSpec::VectorRef & vec)
+{
+    return (vec._type <= FastS_SortSpec::DESC_VECTOR) && vec._vector->isStringType() &&
+           vec._vector->hasEnum() && !vec._vector->hasMultiValue();
+}
+
+long
+serializeValue(const FastS_SortSpec::VectorRef & vec, uint32_t docId, void * serTo, long available)
+{
+    return (vec._type == FastS_SortSpec::ASC_VECTOR)
+        ? vec._vector->serializeForAscendingSort(docId, serTo, available, vec._converter)
+        : vec._vector->serializeForDescendingSort(docId, serTo, available, vec._converter);
+}
+
+void
+buildOrdinalSortKeys(const FastS_SortSpec::VectorRef & vec, const RankedHit *hits, uint32_t n,
+                     FastS_SortSpec::OrdinalSortKeys & keys)
+{
+    // Give each distinct value among the hits a dense index, and keep a document having it.
+    // The enum handle of each hit is read only once, as a concurrent feed might change it.
+    vespalib::hash_map<uint32_t, uint32_t> distinctIndexes(n);
+    std::vector<uint32_t> distinctDocs;
+    keys._hitOrdinals.clear();
+    keys._hitOrdinals.reserve(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        uint32_t docId = hits[i].getDocId();
+        auto inserted = distinctIndexes.insert(std::make_pair(vec._vector->getEnum(docId), uint32_t(distinctDocs.size())));
+        if (inserted.second) {
+            distinctDocs.push_back(docId);
+        }
+        keys._hitOrdinals.push_back(inserted.first->second); // Replaced by the ordinal below
+    }
+    // Serialize each distinct value once.
+    std::vector<uint8_t> blobs(distinctDocs.size() * 16 + 16);
+    std::vector<uint32_t> offsets;
+    offsets.reserve(distinctDocs.size() + 1);
+    size_t offset = 0;
+    for (uint32_t docId : distinctDocs) {
+        long written;
+        while ((written = serializeValue(vec, docId, blobs.data() + offset, blobs.size() - offset)) < 0) {
+            blobs.resize(blobs.size() * 2);
+        }
+        offsets.push_back(offset);
+        offset += written;
+    }
+    offsets.push_back(offset);
+    auto blob = [&](uint32_t i) noexcept {
+        return std::string_view(reinterpret_cast<const char *>(blobs.data()) + offsets[i], offsets[i + 1] - offsets[i]);
+    };
+    // Order the serialized values, giving equal serialized values the same ordinal.
+    std::vector<uint32_t> order(distinctDocs.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) noexcept { return blob(a) < blob(b); });
+    std::vector<uint32_t> ordinals(distinctDocs.size());
+    keys._blobOffsets.clear();
+    keys._blobs.clear();
+    uint32_t ordinal = 0;
+    for (size_t k = 0; k < order.size(); ++k) {
+        uint32_t i = order[k];
+        if ((k == 0) || (blob(order[k - 1]) != blob(i))) {
+            if (k != 0) {
+                ++ordinal;
+            }
+            keys._blobOffsets.push_back(keys._blobs.size());
+            keys._blobs.insert(keys._blobs.end(), blobs.data() + offsets[i], blobs.data() + offsets[i + 1]);
+        }
+        ordinals[i] = ordinal;
+    }
+    keys._blobOffsets.push_back(keys._blobs.size());
+    for (uint32_t & hitOrdinal : keys._hitOrdinals) {
+        hitOrdinal = ordinals[hitOrdinal];
+    }
+}
+
+}
+
+FastS_SortSpec::OrdinalSortKeys::OrdinalSortKeys() noexcept = default;
+FastS_SortSpec::OrdinalSortKeys::~OrdinalSortKeys() = default;
+
+//-----------------------------------------------------------------------------
+
 bool
 FastS_SortSpec::Add(IAttributeContext & vecMan, const SortInfo & sInfo)
 {
@@ -222,18 +308,29 @@ FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
     }
     _binarySortData.resize((fixedWidth + variableWidth) * n);
     _sortDataArray.resize(n);
+    const bool useOrdinals = !_ordinalSortKeys.empty();
+    if (useOrdinals) {
+        _segmentLengths.resize(size_t(n) * _vectors.size());
+    }
 
     size_t offset = 0;
     for (uint32_t i(0), idx(0); (i < n) && !_doom.hard_doom(); ++i) {
         uint32_t len = 0;
-        for (const auto & vec : _vectors) {
-            int written = initSortData(vec, hits[i], offset);
+        for (size_t v = 0; v < _vectors.size(); ++v) {
+            const VectorRef & vec = _vectors[v];
+            int written = (useOrdinals && !_ordinalSortKeys[v]._hitOrdinals.empty())
+                ? writeOrdinalSortData(_ordinalSortKeys[v]._hitOrdinals[i], offset)
+                : initSortData(vec, hits[i], offset);
+            if (useOrdinals) {
+                _segmentLengths[size_t(i) * _vectors.size() + v] = written;
+            }
             offset += written;
             len += written;
         }
         SortData & sd = _sortDataArray[i];
         sd._docId = hits[i]._docId;
         sd._rankValue = hits[i]._rankValue;
+        sd._hitIdx = i;
         sd._idx = idx;
         sd._len = len;
         sd._pos = 0;
@@ -294,13 +391,107 @@ FastS_SortSpec::initSortData(const VectorRef & vec, const RankedHit & hit, size_
     return written;
 }
 
+void
+FastS_SortSpec::ensureSortDataSize(size_t size)
+{
+    if (_binarySortData.size() < size) {
+        _binarySortData.resize(vespalib::roundUp2inN(std::max(size, _binarySortData.size() * 2)));
+    }
+}
+
+int
+FastS_SortSpec::writeOrdinalSortData(uint32_t ordinal, size_t offset)
+{
+    ensureSortDataSize(offset + sizeof(uint32_t));
+    return serializeForSort<convertForSort<uint32_t, true> >(ordinal, _binarySortData.data() + offset, sizeof(uint32_t));
+}
+
+void
+FastS_SortSpec::replaceOrdinalsWithValues()
+{
+    // The sort data of each hit is copied segment by segment in sorted order, with the
+    // ordinals replaced by the cached serialized values. Other keys are not serialized again.
+    const size_t numVectors = _vectors.size();
+    size_t size = 0;
+    for (const auto & sd : _sortDataArray) {
+        if (sd._len == 0) {
+            continue;
+        }
+        const uint32_t * segmentLengths = &_segmentLengths[size_t(sd._hitIdx) * numVectors];
+        for (size_t v = 0; v < numVectors; ++v) {
+            const auto & keys = _ordinalSortKeys[v];
+            if (!keys._hitOrdinals.empty()) {
+                uint32_t ordinal = keys._hitOrdinals[sd._hitIdx];
+                size += keys._blobOffsets[ordinal + 1] - keys._blobOffsets[ordinal];
+            } else {
+                size += segmentLengths[v];
+            }
+        }
+    }
+    BinarySortData values(size);
+    uint8_t * dst = values.data();
+    for (auto & sd : _sortDataArray) {
+        const uint8_t * src = _binarySortData.data() + sd._idx;
+        const uint32_t * segmentLengths = &_segmentLengths[size_t(sd._hitIdx) * numVectors];
+        uint8_t * start = dst;
+        if (sd._len != 0) { // Sort data is not written for hits after a hard doom
+            for (size_t v = 0; v < numVectors; ++v) {
+                const auto & keys = _ordinalSortKeys[v];
+                if (!keys._hitOrdinals.empty()) {
+                    uint32_t ordinal = keys._hitOrdinals[sd._hitIdx];
+                    uint32_t begin = keys._blobOffsets[ordinal];
+                    uint32_t len = keys._blobOffsets[ordinal + 1] - begin;
+                    memcpy(dst, keys._blobs.data() + begin, len);
+                    dst += len;
+                } else {
+                    memcpy(dst, src, segmentLengths[v]);
+                    dst += segmentLengths[v];
+                }
+                src += segmentLengths[v];
+            }
+        }
+        sd._idx = start - values.data();
+        sd._len = dst - start;
+        sd._pos = 0;
+    }
+    _binarySortData.swap(values);
+}
+
+bool
+FastS_SortSpec::initOrdinalSortKeys(const RankedHit *hits, uint32_t n)
+{
+    _ordinalSortKeys.clear();
+    if (n < _minHitsForOrdinalSort) {
+        return false;
+    }
+    bool useAny = false;
+    for (const auto & vec : _vectors) {
+        useAny |= useOrdinalSortKeys(vec);
+    }
+    if (!useAny) {
+        return false;
+    }
+    _ordinalSortKeys.resize(_vectors.size());
+    for (size_t v = 0; v < _vectors.size(); ++v) {
+        if (useOrdinalSortKeys(_vectors[v])) {
+            buildOrdinalSortKeys(_vectors[v], hits, n, _ordinalSortKeys[v]);
+        }
+    }
+    return true;
+}
+
 FastS_SortSpec::FastS_SortSpec(std::string_view documentmetastore, uint32_t partitionId, const Doom & doom, const ConverterFactory & ucaFactory)
     : _documentmetastore(documentmetastore),
       _partitionId(partitionId),
       _doom(doom),
       _ucaFactory(ucaFactory),
       _sortSpec(),
-      _vectors()
+      _vectors(),
+      _binarySortData(),
+      _sortDataArray(),
+      _ordinalSortKeys(),
+      _segmentLengths(),
+      _minHitsForOrdinalSort(DEFAULT_MIN_HITS_FOR_ORDINAL_SORT)
 { }
 
 
@@ -433,6 +624,9 @@ public:
 void
 FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
 {
+    // Single value string attributes are sorted on fixed width ordinals of their serialized
+    // values. The ordinals are then replaced by the serialized values, in sorted order.
+    bool useOrdinals = initOrdinalSortKeys(a, n);
     initSortData(a, n);
     {
         SortData * sortData = _sortDataArray.data();
@@ -444,4 +638,9 @@ FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
         a[i]._rankValue = _sortDataArray[i]._rankValue;
         a[i]._docId = _sortDataArray[i]._docId;
     }
+    if (useOrdinals) {
+        replaceOrdinalsWithValues();
+        _ordinalSortKeys.clear();
+        _segmentLengths.clear();
+    }
 }
@@ -69,6 +69,7 @@ public:
         ASC_DOCID   = 4,
         DESC_DOCID  = 5
     };
+    static constexpr uint32_t DEFAULT_MIN_HITS_FOR_ORDINAL_SORT = 256;
 
     struct VectorRef
     {
@@ -84,12 +85,28 @@ public:
 
     struct SortData : public search::RankedHit
     {
-        SortData() noexcept : RankedHit(), _idx(0u), _len(0u), _pos(0u) {}
+        SortData() noexcept : RankedHit(), _hitIdx(0u), _idx(0u), _len(0u), _pos(0u) {}
+        uint32_t _hitIdx; // position of the hit before sorting
         uint32_t _idx;
         uint32_t _len;
         uint32_t _pos;
     };
 
+    /**
+     * Sort keys for a single value string attribute with enum. Each
+     * distinct value among the hits is serialized once, and hits are
+     * sorted on the ordinal of their serialized value instead of on the
+     * variable length value itself.
+     **/
+    struct OrdinalSortKeys
+    {
+        OrdinalSortKeys() noexcept;
+        ~OrdinalSortKeys();
+        std::vector<uint32_t> _hitOrdinals; // ordinal of the serialized value for each hit
+        std::vector<uint32_t> _blobOffsets; // start of serialized value for each ordinal, followed by end
+        std::vector<uint8_t>  _blobs;
+    };
+
 private:
     using VectorRefList = std::vector<VectorRef>;
     using BinarySortData = std::vector<uint8_t, vespalib::allocator_large<uint8_t>>;
@@ -103,10 +120,17 @@ private:
     VectorRefList            _vectors;
     BinarySortData           _binarySortData;
     SortDataArray            _sortDataArray;
+    std::vector<OrdinalSortKeys> _ordinalSortKeys;
+    std::vector<uint32_t>    _segmentLengths; // length of the sort data of each vector for each hit, with ordinals
+    uint32_t                 _minHitsForOrdinalSort;
 
     bool Add(search::attribute::IAttributeContext & vecMan, const search::common::SortInfo & sInfo);
     void initSortData(const search::RankedHit *a, uint32_t n);
     int initSortData(const VectorRef & vec, const search::RankedHit & hit, size_t offset);
+    bool initOrdinalSortKeys(const search::RankedHit *a, uint32_t n);
+    int writeOrdinalSortData(uint32_t ordinal, size_t offset);
+    void replaceOrdinalsWithValues();
+    void ensureSortDataSize(size_t size);
 
 public:
     FastS_SortSpec(const FastS_SortSpec &) = delete;
@@ -123,6 +147,8 @@ public:
     void copySortData(uint32_t offset, uint32_t n, uint32_t *idx, char *buf);
     void freeSortData();
     void initWithoutSorting(const search::RankedHit * hits, uint32_t hitCnt);
+    // Minimum number of hits before sort keys for string attributes are replaced by ordinals
+    void setMinHitsForOrdinalSort(uint32_t minHits) { _minHitsForOrdinalSort = minHits; }
 };
 
 //-----------------------------------------------------------------------------
@@ -68,7 +68,7 @@ protected:
     Value&                   _empty_output;
     TypedCells               _identity;
     const ITensorAttribute&  _attr;
-    std::unique_ptr<Value>   _output;
+    FastValueView            _output;
 public:
     ClosestExecutor(DistanceCalculatorBundle&& bundle, Value& empty_output, TypedCells identity, const ITensorAttribute& attr);
     ~ClosestExecutor() override;
@@ -103,7 +103,7 @@ ClosestExecutor::ClosestExecutor(DistanceCalculatorBundle&& bundle, Value& empty
       _empty_output(empty_output),
       _identity(identity),
       _attr(attr),
-      _output()
+      _output(empty_output.type())
 {
 }
 
@@ -138,9 +138,8 @@ ClosestSerializedExecutor::execute(uint32_t docId)
         elem.calc->calc_closest_subspace(ref.get_vectors(), closest_subspace, best_distance);
     }
     if (closest_subspace.has_value()) {
-        auto labels = ref.get_labels(closest_subspace.value());
-        _output = std::make_unique<FastValueView>(_empty_output.type(), labels, _identity, labels.size(), 1);
-        outputs().set_object(0, *_output);
+        _output.set(ref.get_labels(closest_subspace.value()), _identity, 1);
+        outputs().set_object(0, _output);
     } else {
         outputs().set_object(0, _empty_output);
     }
@@ -175,8 +174,8 @@ ClosestDirectExecutor::execute(uint32_t docId)
         view->lookup({});
         while (view->next_result(_label_ptrs, subspace_id)) {
             if (subspace_id == closest_subspace.value()) {
-                _output = std::make_unique<FastValueView>(_empty_output.type(), _labels, _identity, _labels.size(), 1);
-                outputs().set_object(0, *_output);
+                _output.set(_labels, _identity, 1);
+                outputs().set_object(0, _output);
                 return;
             }
         }
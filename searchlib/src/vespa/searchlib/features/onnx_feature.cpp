@@ -2,6 +2,7 @@
 
 #include "onnx_feature.h"
 #include <vespa/searchlib/fef/properties.h>
+#include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/onnx_model.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
 #include <vespa/eval/eval/value.h>
@@ -11,6 +12,7 @@
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/issue.h>
+#include <algorithm>
 #include <cctype>
 
 #include <vespa/log/log.h>
@@ -51,15 +53,20 @@ std::string normalize_name(const std::string &name, const char *context) {
     return result;
 }
 
+std::vector<Value::UP> make_dry_run_inputs(const Onnx::WireInfo &wire) {
+    std::vector<Value::UP> inputs;
+    for (const auto &input_type: wire.vespa_inputs) {
+        TensorSpec spec(input_type.to_spec());
+        inputs.push_back(value_from_spec(spec, FastValueBuilderFactory::get()));
+    }
+    return inputs;
+}
+
 std::string my_dry_run(const Onnx &model, const Onnx::WireInfo &wire) {
     std::string error_msg;
     try {
         Onnx::EvalContext context(model, wire);
-        std::vector<Value::UP> inputs;
-        for (const auto &input_type: wire.vespa_inputs) {
-            TensorSpec spec(input_type.to_spec());
-            inputs.push_back(value_from_spec(spec, FastValueBuilderFactory::get()));
-        }
+        auto inputs = make_dry_run_inputs(wire);
         for (size_t i = 0; i < inputs.size(); ++i) {
             context.bind_param(i, *inputs[i]);
         }
@@ -70,6 +77,23 @@ std::string my_dry_run(const Onnx &model, const Onnx::WireInfo &wire) {
     return error_msg;
 }
 
+std::string my_batch_dry_run(const Onnx &model, const Onnx::WireInfo &wire, size_t batch_size) {
+    std::string error_msg;
+    try {
+        Onnx::BatchEvalContext context(model, wire, batch_size);
+        auto inputs = make_dry_run_inputs(wire);
+        for (size_t entry = 0; entry < batch_size; ++entry) {
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                context.bind_param(entry, i, *inputs[i]);
+            }
+        }
+        context.eval(batch_size);
+    } catch (const Ort::Exception &ex) {
+        error_msg = ex.what();
+    }
+    return error_msg;
+}
+
 } // <unnamed>
 
 /**
@@ -79,14 +103,18 @@ class OnnxFeatureExecutor : public FeatureExecutor
 {
 private:
     Onnx::EvalContext _eval_context;
+protected:
+    void bind_single_results() {
+        for (size_t i = 0; i < _eval_context.num_results(); ++i) {
+            outputs().set_object(i, _eval_context.get_result(i));
+        }
+    }
 public:
     OnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info)
         : _eval_context(model, wire_info) {}
     bool isPure() override { return true; }
     void handle_bind_outputs(std::span<fef::NumberOrObject>) override {
-        for (size_t i = 0; i < _eval_context.num_results(); ++i) {
-            outputs().set_object(i, _eval_context.get_result(i));
-        }
+        bind_single_results();
     }
     void execute(uint32_t) override {
         for (size_t i = 0; i < _eval_context.num_params(); ++i) {
@@ -101,12 +129,89 @@ public:
     }
 };
 
+/**
+ * Feature executor that evaluates an onnx model with a free batch
+ * dimension for several documents at once when the framework
+ * provides batches, falling back to evaluating one document at a
+ * time for documents outside the current batch.
+ */
+class OnnxBatchFeatureExecutor : public OnnxFeatureExecutor
+{
+private:
+    Onnx::BatchEvalContext _batch_context;
+    std::vector<uint32_t>  _batch_docs;
+    bool                   _batch_ready;
+    bool                   _bound_to_batch;
+    size_t find_in_batch(uint32_t docid) const {
+        if (_batch_ready) {
+            auto pos = std::lower_bound(_batch_docs.begin(), _batch_docs.end(), docid);
+            if ((pos != _batch_docs.end()) && (*pos == docid)) {
+                return (pos - _batch_docs.begin());
+            }
+        }
+        return _batch_docs.size();
+    }
+public:
+    OnnxBatchFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info, size_t batch_size)
+        : OnnxFeatureExecutor(model, wire_info),
+          _batch_context(model, wire_info, batch_size),
+          _batch_docs(),
+          _batch_ready(false),
+          _bound_to_batch(false)
+    {
+        _batch_docs.reserve(batch_size);
+    }
+    size_t max_batch_size() override { return _batch_context.max_batch_size(); }
+    void add_to_batch(uint32_t docid) override {
+        if (_batch_ready) {
+            _batch_docs.clear();
+            _batch_ready = false;
+        }
+        size_t entry = _batch_docs.size();
+        if (entry == _batch_context.max_batch_size()) {
+            return;
+        }
+        for (size_t i = 0; i < _batch_context.num_params(); ++i) {
+            _batch_context.bind_param(entry, i, inputs().get_object(i, docid).get());
+        }
+        _batch_docs.push_back(docid);
+    }
+    void run_batch() override {
+        if (_batch_docs.empty()) {
+            return;
+        }
+        try {
+            _batch_context.eval(_batch_docs.size());
+            _batch_ready = true;
+        } catch (const Ort::Exception &ex) {
+            Issue::report("onnx model batch evaluation failed: %s", ex.what());
+            _batch_docs.clear();
+        }
+    }
+    void execute(uint32_t docid) override {
+        size_t entry = find_in_batch(docid);
+        if (entry < _batch_docs.size()) {
+            for (size_t i = 0; i < _batch_context.num_results(); ++i) {
+                outputs().set_object(i, _batch_context.get_result(entry, i));
+            }
+            _bound_to_batch = true;
+            return;
+        }
+        if (_bound_to_batch) {
+            bind_single_results();
+            _bound_to_batch = false;
+        }
+        OnnxFeatureExecutor::execute(docid);
+    }
+};
+
 OnnxBlueprint::OnnxBlueprint(std::string_view baseName)
     : Blueprint(baseName),
       _cache_token(),
       _debug_model(),
       _model(nullptr),
-      _wire_info()
+      _wire_info(),
+      _batch_size(0)
 {
     assert((baseName == "onnx") || (baseName == "onnxModel"));
 }
@@ -173,6 +278,20 @@ OnnxBlueprint::setup(const IIndexEnvironment &env,
     } else {
         LOG(warning, "dry-run disabled for onnx model '%s'", model_cfg->name().c_str());
     }
+    size_t batch_size = fef::indexproperties::eval::OnnxBatchSize::lookup(env.getProperties());
+    if (batch_size > 1) {
+        if (!_model->has_free_batch_dimension()) {
+            LOG(warning, "onnx model '%s' does not have a free batch dimension; batched evaluation disabled",
+                model_cfg->name().c_str());
+        } else if (auto error_msg = model_cfg->dry_run_on_setup() ? my_batch_dry_run(*_model, _wire_info, batch_size) : "";
+                   !error_msg.empty())
+        {
+            LOG(warning, "batched dry-run failed for onnx model '%s'; batched evaluation disabled: %s",
+                model_cfg->name().c_str(), error_msg.c_str());
+        } else {
+            _batch_size = batch_size;
+        }
+    }
     return true;
 }
 
@@ -180,6 +299,9 @@ FeatureExecutor &
 OnnxBlueprint::createExecutor(const IQueryEnvironment &, Stash &stash) const
 {
     assert(_model != nullptr);
+    if (_batch_size > 1) {
+        return stash.create<OnnxBatchFeatureExecutor>(*_model, _wire_info, _batch_size);
+    }
     return stash.create<OnnxFeatureExecutor>(*_model, _wire_info);
 }
 
@@ -19,6 +19,7 @@ using vespalib::eval::DoubleValue;
 using vespalib::eval::FastValueBuilderFactory;
 using vespalib::eval::Function;
 using vespalib::eval::InterpretedFunction;
+using vespalib::eval::InterpretedFunctionCache;
 using vespalib::eval::LazyParams;
 using vespalib::eval::NodeTypes;
 using vespalib::eval::PassParams;
@@ -123,6 +124,7 @@ public:
     InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
                                          std::span<const char> input_is_object);
     bool isPure() override { return true; }
+    void set_thread_bundle(vespalib::ThreadBundle *thread_bundle) override { _context.set_thread_bundle(thread_bundle); }
     void execute(uint32_t docId) override;
 };
 
@@ -141,6 +143,7 @@ public:
     UnboxingInterpretedRankingExpressionExecutor(const InterpretedFunction &function,
                                                  std::span<const char> input_is_object);
     bool isPure() override { return true; }
+    void set_thread_bundle(vespalib::ThreadBundle *thread_bundle) override { _context.set_thread_bundle(thread_bundle); }
     void execute(uint32_t docId) override;
 };
 
@@ -360,8 +363,9 @@ RankingExpressionBlueprint::setup(const fef::IIndexEnvironment &env,
                 }
             }
         } else {
-            _interpreted_function.reset(new InterpretedFunction(FastValueBuilderFactory::get(),
-                                                                *rank_function, node_types));
+            // identical expressions in other rank profiles (or config generations) share the function
+            _interpreted_function = InterpretedFunctionCache::create(FastValueBuilderFactory::get(),
+                                                                     script, *rank_function, input_types);
             _should_unbox = root_type.is_double();
         }
     }
@@ -395,9 +399,9 @@ RankingExpressionBlueprint::createExecutor(const fef::IQueryEnvironment &env, ve
     if (_interpreted_function) {
         std::span<const char> input_is_object = stash.copy_array<char>(_input_is_object);
         if (_should_unbox) {
-            return stash.create<UnboxingInterpretedRankingExpressionExecutor>(*_interpreted_function, input_is_object);
+            return stash.create<UnboxingInterpretedRankingExpressionExecutor>(_interpreted_function->get(), input_is_object);
         } else {
-            return stash.create<InterpretedRankingExpressionExecutor>(*_interpreted_function, input_is_object);
+            return stash.create<InterpretedRankingExpressionExecutor>(_interpreted_function->get(), input_is_object);
         }
     }
     if (_fast_forest) {
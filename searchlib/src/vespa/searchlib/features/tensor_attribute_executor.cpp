@@ -9,16 +9,16 @@ TensorAttributeExecutor::
 TensorAttributeExecutor(const search::tensor::ITensorAttribute& attribute)
     : _attribute(attribute),
       _emptyTensor(attribute.getEmptyTensor()),
-      _tensor()
+      _tensorView(attribute.getTensorType())
 {
 }
 
 void
 TensorAttributeExecutor::execute(uint32_t docId)
 {
-    _tensor = _attribute.getTensor(docId);
-    if (_tensor) {
-        outputs().set_object(0, *_tensor);
+    const auto* tensor = _attribute.get_tensor_view(docId, _tensorView);
+    if (tensor != nullptr) {
+        outputs().set_object(0, *tensor);
     } else {
         outputs().set_object(0, *_emptyTensor);
     }
@@ -4,18 +4,24 @@
 
 #include <vespa/searchcommon/attribute/iattributevector.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
+#include <vespa/searchlib/tensor/fast_value_view.h>
 #include <vespa/eval/eval/value.h>
 #include <string>
 
 namespace search::tensor { class ITensorAttribute; }
 namespace search::features {
 
+/**
+ * Executor for extracting tensors from an underlying tensor attribute
+ * without copying cells data. The sparse index (if any) is built in a
+ * view that is re-used for all documents.
+ */
 class TensorAttributeExecutor : public fef::FeatureExecutor
 {
 private:
     const search::tensor::ITensorAttribute& _attribute;
     std::unique_ptr<vespalib::eval::Value> _emptyTensor;
-    std::unique_ptr<vespalib::eval::Value> _tensor;
+    search::tensor::FastValueView _tensorView;
 
 public:
     TensorAttributeExecutor(const search::tensor::ITensorAttribute& attribute);
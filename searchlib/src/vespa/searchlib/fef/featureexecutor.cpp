@@ -20,6 +20,27 @@ FeatureExecutor::isPure()
     return false;
 }
 
+size_t
+FeatureExecutor::max_batch_size()
+{
+    return 0;
+}
+
+void
+FeatureExecutor::add_to_batch(uint32_t)
+{
+}
+
+void
+FeatureExecutor::run_batch()
+{
+}
+
+void
+FeatureExecutor::set_thread_bundle(vespalib::ThreadBundle *)
+{
+}
+
 void
 FeatureExecutor::handle_bind_inputs(std::span<const LazyValue>)
 {
@@ -6,6 +6,8 @@
 #include "number_or_object.h"
 #include <span>
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace search::fef {
 
 class FeatureExecutor;
@@ -53,6 +55,7 @@ public:
         void bind(std::span<const LazyValue> inputs) { _inputs = inputs; }
         inline feature_t get_number(size_t idx) const;
         inline vespalib::eval::Value::CREF get_object(size_t idx) const;
+        inline vespalib::eval::Value::CREF get_object(size_t idx, uint32_t docid) const;
         size_t size() const { return _inputs.size(); }
     };
 
@@ -148,6 +151,48 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Obtain the maximum number of documents this feature executor
+     * is able to calculate outputs for at once. Executors where this
+     * is more efficient than calculating them one document at a time
+     * (typically model evaluation) may override this function as
+     * well as add_to_batch and run_batch. The default value of 0
+     * means that batching is not supported.
+     *
+     * @return max number of documents in a batch
+     **/
+    virtual size_t max_batch_size();
+
+    /**
+     * Add a document to the next batch. Documents are added in
+     * ascending docid order, with match data unpacked for the
+     * document being added. Input values for the given document can
+     * be obtained with Inputs::get_object(idx, docid).
+     *
+     * @param docid the local document id to add
+     **/
+    virtual void add_to_batch(uint32_t docid);
+
+    /**
+     * Calculate outputs for all documents added to the batch since
+     * the last call to this function. Later execution for any of
+     * these documents should use the pre-calculated outputs, while
+     * other documents must still be executed normally.
+     **/
+    virtual void run_batch();
+
+    /**
+     * Offer a thread bundle that may be used to parallelize the
+     * calculation of outputs. This is only done for constant
+     * (query-level) executors during rank program setup, where the
+     * bundle is known to be idle. The bundle is detached again by
+     * passing nullptr when the executor has been run. The default
+     * implementation ignores the bundle.
+     *
+     * @param thread_bundle the bundle to use, or nullptr
+     **/
+    virtual void set_thread_bundle(vespalib::ThreadBundle *thread_bundle);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -189,6 +234,10 @@ vespalib::eval::Value::CREF FeatureExecutor::Inputs::get_object(size_t idx) cons
     return _inputs[idx].as_object(_docid);
 }
 
+vespalib::eval::Value::CREF FeatureExecutor::Inputs::get_object(size_t idx, uint32_t docid) const {
+    return _inputs[idx].as_object(docid);
+}
+
 }
 
 //  LocalWords:  param
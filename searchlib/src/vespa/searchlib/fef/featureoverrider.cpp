@@ -30,6 +30,12 @@ FeatureOverrider::isPure()
     return _executor.isPure();
 }
 
+void
+FeatureOverrider::set_thread_bundle(vespalib::ThreadBundle *thread_bundle)
+{
+    _executor.set_thread_bundle(thread_bundle);
+}
+
 void
 FeatureOverrider::execute(uint32_t docId)
 {
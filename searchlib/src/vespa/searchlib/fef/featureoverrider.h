@@ -32,6 +32,7 @@ public:
     FeatureOverrider &operator=(const FeatureOverrider &) = delete;
     FeatureOverrider(FeatureExecutor &executor, uint32_t outputIdx, feature_t number, Value::UP object);
     bool isPure() override;
+    void set_thread_bundle(vespalib::ThreadBundle *thread_bundle) override;
     void execute(uint32_t docId) override;
 };
 
@@ -100,6 +100,10 @@ const std::string UseFastForest::NAME("vespa.eval.use_fast_forest");
 const bool UseFastForest::DEFAULT_VALUE(false);
 bool UseFastForest::check(const Properties &props) { return lookupBool(props, NAME, DEFAULT_VALUE); }
 
+const std::string OnnxBatchSize::NAME("vespa.eval.onnx_batch_size");
+const uint32_t OnnxBatchSize::DEFAULT_VALUE(0);
+uint32_t OnnxBatchSize::lookup(const Properties &props) { return lookupUint32(props, NAME, DEFAULT_VALUE); }
+
 } // namespace eval
 
 namespace rank {
@@ -36,6 +36,15 @@ struct UseFastForest {
     static bool check(const Properties &props);
 };
 
+// max number of documents evaluated together by onnx models with a
+// free batch dimension. 0 or 1 disables batching. affects second
+// phase ranking and match features
+struct OnnxBatchSize {
+    static const std::string NAME;
+    static const uint32_t DEFAULT_VALUE;
+    static uint32_t lookup(const Properties &props);
+};
+
 } // namespace eval
 
 namespace rank {
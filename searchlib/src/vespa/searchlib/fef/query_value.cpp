@@ -105,6 +105,8 @@ decode_tensor_value(Property prop, const ValueType& value_type)
         try {
             auto tensor = vespalib::eval::decode_value(stream, vespalib::eval::FastValueBuilderFactory::get());
             if (TensorDataType::isAssignableType(value_type, tensor->type())) {
+                // query tensors take part in operations for each hit
+                vespalib::eval::add_sorted_label_index(*tensor);
                 return tensor;
             } else {
                 Issue::report("Query value type is '%s' but decoded tensor type is '%s'",
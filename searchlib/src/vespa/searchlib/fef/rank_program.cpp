@@ -20,6 +20,7 @@ LOG_SETUP(".fef.rankprogram");
 using vespalib::Stash;
 using vespalib::Issue;
 using vespalib::ExecutionProfiler;
+using vespalib::ThreadBundle;
 using vespalib::eval::Value;
 using vespalib::eval::ValueType;
 using vespalib::eval::FastValueBuilderFactory;
@@ -123,6 +124,22 @@ struct ProfiledExecutor : FeatureExecutor {
     bool isPure() override {
         return executor.isPure();
     }
+    size_t max_batch_size() override {
+        return executor.max_batch_size();
+    }
+    void add_to_batch(uint32_t docId) override {
+        profiler.start(self);
+        executor.add_to_batch(docId);
+        profiler.complete();
+    }
+    void run_batch() override {
+        profiler.start(self);
+        executor.run_batch();
+        profiler.complete();
+    }
+    void set_thread_bundle(vespalib::ThreadBundle *thread_bundle) override {
+        executor.set_thread_bundle(thread_bundle);
+    }
     void execute(uint32_t docId) override {
         profiler.start(self);
         executor.lazy_execute(docId);
@@ -165,9 +182,15 @@ RankProgram::check_const(FeatureExecutor *executor, const std::vector<BlueprintR
 }
 
 void
-RankProgram::run_const(FeatureExecutor *executor)
+RankProgram::run_const(FeatureExecutor *executor, vespalib::ThreadBundle *thread_bundle)
 {
-    executor->lazy_execute(1);
+    if (thread_bundle != nullptr) {
+        executor->set_thread_bundle(thread_bundle);
+        executor->lazy_execute(1);
+        executor->set_thread_bundle(nullptr);
+    } else {
+        executor->lazy_execute(1);
+    }
     const auto &outputs = executor->outputs();
     for (size_t out_idx = 0; out_idx < outputs.size(); ++out_idx) {
         _is_const.insert(outputs.get_raw(out_idx));
@@ -222,6 +245,7 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _hot_stash(32_Ki),
       _cold_stash(),
       _executors(),
+      _batch_executors(),
       _unboxed_seeds(),
       _is_const()
 {
@@ -233,7 +257,8 @@ void
 RankProgram::setup(const MatchData &md,
                    const IQueryEnvironment &queryEnv,
                    const Properties &featureOverrides,
-                   ExecutionProfiler *profiler)
+                   ExecutionProfiler *profiler,
+                   ThreadBundle *thread_bundle)
 {
     const auto &specs = _resolver->getExecutorSpecs();
     assert(_executors.empty());
@@ -278,7 +303,9 @@ RankProgram::setup(const MatchData &md,
         executor->bind_match_data(md);
         _executors.push_back(executor);
         if (is_const) {
-            run_const(executor);
+            run_const(executor, thread_bundle);
+        } else if (executor->max_batch_size() > 0) {
+            _batch_executors.push_back(executor);
         }
     }
     for (const auto &seed_entry: _resolver->getSeedMap()) {
@@ -306,6 +333,33 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+size_t
+RankProgram::max_batch_size() const
+{
+    size_t result = 0;
+    for (FeatureExecutor *executor: _batch_executors) {
+        size_t limit = executor->max_batch_size();
+        result = (result == 0) ? limit : std::min(result, limit);
+    }
+    return result;
+}
+
+void
+RankProgram::add_to_batch(uint32_t docid)
+{
+    for (FeatureExecutor *executor: _batch_executors) {
+        executor->add_to_batch(docid);
+    }
+}
+
+void
+RankProgram::run_batch()
+{
+    for (FeatureExecutor *executor: _batch_executors) {
+        executor->run_batch();
+    }
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
@@ -12,6 +12,7 @@
 #include <string>
 
 namespace vespalib { class ExecutionProfiler; }
+namespace vespalib { struct ThreadBundle; }
 
 namespace search::fef {
 
@@ -38,12 +39,13 @@ private:
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
+    std::vector<FeatureExecutor *>   _batch_executors;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
 
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
-    void run_const(FeatureExecutor *executor);
+    void run_const(FeatureExecutor *executor, vespalib::ThreadBundle *thread_bundle);
     void unbox(BlueprintResolver::FeatureRef seed, const MatchData &md);
     FeatureResolver resolve(const BlueprintResolver::FeatureMap &features, bool unbox_seeds) const;
 
@@ -66,12 +68,16 @@ public:
     /**
      * Set up this rank program by creating the needed feature
      * executors and wiring them together. This function will also
-     * pre-calculate all constant features.
+     * pre-calculate all constant features. If a thread bundle is
+     * given, it may be used to parallelize the calculation of large
+     * constant (query-level) tensor expressions. The bundle must be
+     * idle (not running the calling thread) during setup.
      **/
     void setup(const MatchData &md,
                const IQueryEnvironment &queryEnv,
                const Properties &featureOverrides = Properties(),
-               vespalib::ExecutionProfiler *profiler = nullptr);
+               vespalib::ExecutionProfiler *profiler = nullptr,
+               vespalib::ThreadBundle *thread_bundle = nullptr);
 
     /**
      * Obtain the names and storage locations of all seed features for
@@ -91,6 +97,28 @@ public:
      * @params unbox_seeds make sure seeds values are numbers
      **/
     FeatureResolver get_all_features(bool unbox_seeds = true) const;
+
+    /**
+     * Obtain the maximum number of documents that should be added to
+     * a batch before running it. Returns 0 if no executors in this
+     * program support batching (see FeatureExecutor::max_batch_size).
+     **/
+    size_t max_batch_size() const;
+
+    /**
+     * Add a document to the next batch for all executors supporting
+     * batching. Documents must be added in ascending docid order, and
+     * match data must be unpacked for the document being added.
+     **/
+    void add_to_batch(uint32_t docid);
+
+    /**
+     * Let all executors supporting batching calculate their outputs
+     * for the documents added since the last batch was run. Resolved
+     * features can then be obtained for these documents as usual,
+     * after unpacking their match data again.
+     **/
+    void run_batch();
 };
 
 }
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "dense_tensor_store.h"
+#include "fast_value_view.h"
 #include "subspace_type.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/vespalib/datastore/compacting_buffers.h>
@@ -184,6 +185,16 @@ DenseTensorStore::get_tensor(EntryRef ref) const
     return std::make_unique<vespalib::eval::DenseValueView>(_type, cells_ref);
 }
 
+const vespalib::eval::Value*
+DenseTensorStore::get_tensor_view(EntryRef ref, FastValueView& view) const
+{
+    if (!ref.valid()) {
+        return nullptr;
+    }
+    view.set({}, get_typed_cells(ref), 1);
+    return &view;
+}
+
 bool
 DenseTensorStore::encode_stored_tensor(EntryRef ref, vespalib::nbostream& target) const
 {
@@ -74,6 +74,7 @@ public:
     EntryRef store_tensor(const vespalib::eval::Value &tensor) override;
     EntryRef store_encoded_tensor(vespalib::nbostream &encoded) override;
     std::unique_ptr<vespalib::eval::Value> get_tensor(EntryRef ref) const override;
+    const vespalib::eval::Value* get_tensor_view(EntryRef ref, FastValueView& view) const override;
     bool encode_stored_tensor(EntryRef ref, vespalib::nbostream &target) const override;
     const DenseTensorStore* as_dense() const override;
     DenseTensorStore* as_dense() override;
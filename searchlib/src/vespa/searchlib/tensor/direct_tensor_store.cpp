@@ -126,6 +126,12 @@ DirectTensorStore::get_tensor(EntryRef ref) const
     return FastValueBuilderFactory::get().copy(*_tensor_store.getEntry(ref));
 }
 
+const vespalib::eval::Value*
+DirectTensorStore::get_tensor_view(EntryRef ref, FastValueView&) const
+{
+    return get_tensor_ptr(ref);
+}
+
 bool
 DirectTensorStore::encode_stored_tensor(EntryRef ref, vespalib::nbostream& target) const
 {
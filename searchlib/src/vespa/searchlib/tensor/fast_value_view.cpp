@@ -20,6 +20,22 @@ FastValueView::FastValueView(const ValueType& type, std::span<const string_id> l
       _index(num_mapped_dimensions, _labels, num_subspaces),
       _cells(cells)
 {
+    add_mappings(num_subspaces);
+}
+
+FastValueView::FastValueView(const ValueType& type)
+    : Value(),
+      _type(type),
+      _labels(),
+      _index(type.count_mapped_dimensions(), _labels, 1),
+      _cells(nullptr, type.cell_type(), 0)
+{
+}
+
+void
+FastValueView::add_mappings(size_t num_subspaces)
+{
+    size_t num_mapped_dimensions = _index.map.addr_size();
     for (size_t i = 0; i < num_subspaces; ++i) {
         std::span<const string_id> addr(_labels.data() + (i * num_mapped_dimensions), num_mapped_dimensions);
         _index.map.add_mapping(FastAddrMap::hash_labels(addr));
@@ -27,6 +43,15 @@ FastValueView::FastValueView(const ValueType& type, std::span<const string_id> l
     assert(_index.map.size() == num_subspaces);
 }
 
+void
+FastValueView::set(std::span<const string_id> labels, TypedCells cells, size_t num_subspaces)
+{
+    _index.map.clear();
+    _labels.assign(labels.begin(), labels.end());
+    _cells = cells;
+    add_mappings(num_subspaces);
+}
+
 MemoryUsage
 FastValueView::get_memory_usage() const
 {
@@ -8,13 +8,23 @@ namespace search::tensor {
 
 /*
  * Tensor view that is not self-contained. It references external cell values.
+ *
+ * A view can be re-pointed to another tensor with the same type using
+ * set(). The memory used for labels and the sparse index is kept, so
+ * a view that is re-used for each document will normally not allocate.
  */
 struct FastValueView final : vespalib::eval::Value {
     const vespalib::eval::ValueType& _type;
     vespalib::StringIdVector         _labels;
     vespalib::eval::FastValueIndex   _index;
     vespalib::eval::TypedCells       _cells;
+private:
+    void add_mappings(size_t num_subspaces);
+public:
     FastValueView(const vespalib::eval::ValueType& type, std::span<const vespalib::string_id> labels, vespalib::eval::TypedCells cells, size_t num_mapped_dimensions, size_t num_subspaces);
+    // empty view, use set() to make it refer to a tensor
+    explicit FastValueView(const vespalib::eval::ValueType& type);
+    void set(std::span<const vespalib::string_id> labels, vespalib::eval::TypedCells cells, size_t num_subspaces);
     const vespalib::eval::ValueType& type() const override { return _type; }
     const vespalib::eval::Value::Index& index() const override { return _index; }
     vespalib::eval::TypedCells cells() const override { return _cells; }
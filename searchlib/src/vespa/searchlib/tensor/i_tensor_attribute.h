@@ -13,6 +13,7 @@ namespace vespalib::slime { struct Inserter; }
 namespace search::tensor {
 
 struct DistanceFunctionFactory;
+struct FastValueView;
 class NearestNeighborIndex;
 class SerializedTensorRef;
 
@@ -23,6 +24,15 @@ class ITensorAttribute : public DocVectorAccess {
 public:
     virtual ~ITensorAttribute() = default;
     virtual std::unique_ptr<vespalib::eval::Value> getTensor(uint32_t docId) const = 0;
+    /**
+     * Get the tensor for the given document without copying it. The
+     * given view (created with the tensor type of this attribute) is
+     * used as storage when the stored format needs one, and re-using
+     * the same view for many documents avoids memory allocation.
+     * Returns nullptr if the document has no tensor. The result is
+     * only valid until the view is re-used.
+     */
+    virtual const vespalib::eval::Value* get_tensor_view(uint32_t docid, FastValueView& view) const = 0;
     virtual std::unique_ptr<vespalib::eval::Value> getEmptyTensor() const = 0;
     virtual vespalib::eval::TypedCells extract_cells_ref(uint32_t docid) const = 0;
     virtual const vespalib::eval::Value& get_tensor_ref(uint32_t docid) const = 0;
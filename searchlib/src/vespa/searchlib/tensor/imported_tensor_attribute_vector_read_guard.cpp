@@ -42,6 +42,12 @@ ImportedTensorAttributeVectorReadGuard::getTensor(uint32_t docId) const
     return _target_tensor_attribute.getTensor(getTargetLid(docId));
 }
 
+const vespalib::eval::Value*
+ImportedTensorAttributeVectorReadGuard::get_tensor_view(uint32_t docid, FastValueView& view) const
+{
+    return _target_tensor_attribute.get_tensor_view(getTargetLid(docid), view);
+}
+
 std::unique_ptr<vespalib::eval::Value>
 ImportedTensorAttributeVectorReadGuard::getEmptyTensor() const
 {
@@ -32,6 +32,7 @@ public:
     const ITensorAttribute *asTensorAttribute() const override;
 
     std::unique_ptr<vespalib::eval::Value> getTensor(uint32_t docId) const override;
+    const vespalib::eval::Value* get_tensor_view(uint32_t docid, FastValueView& view) const override;
     std::unique_ptr<vespalib::eval::Value> getEmptyTensor() const override;
     vespalib::eval::TypedCells extract_cells_ref(uint32_t docid) const override;
     const vespalib::eval::Value& get_tensor_ref(uint32_t docid) const override;
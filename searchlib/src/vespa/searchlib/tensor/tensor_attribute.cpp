@@ -304,6 +304,16 @@ TensorAttribute::getTensor(DocId docId) const
     return _tensorStore.get_tensor(ref);
 }
 
+const Value*
+TensorAttribute::get_tensor_view(uint32_t docid, FastValueView& view) const
+{
+    EntryRef ref;
+    if (docid < getCommittedDocIdLimit()) {
+        ref = acquire_entry_ref(docid);
+    }
+    return _tensorStore.get_tensor_view(ref, view);
+}
+
 void
 TensorAttribute::get_state(const vespalib::slime::Inserter& inserter) const
 {
@@ -60,6 +60,7 @@ public:
     void before_inc_generation(generation_t current_gen) override;
     bool addDoc(DocId &docId) override;
     std::unique_ptr<vespalib::eval::Value> getTensor(DocId docId) const override;
+    const vespalib::eval::Value* get_tensor_view(uint32_t docid, FastValueView& view) const override;
     std::unique_ptr<vespalib::eval::Value> getEmptyTensor() const override;
     vespalib::eval::TypedCells extract_cells_ref(uint32_t docid) const override;
     const vespalib::eval::Value& get_tensor_ref(uint32_t docid) const override;
@@ -368,6 +368,7 @@ TensorAttributeLoader::on_load(vespalib::Executor* executor)
     } else {
         load_tensor_store(reader, docid_limit);
     }
+    _attr.end_load_phase("tensors");
     _attr.commit();
     _attr.getStatus().setNumDocs(docid_limit);
     _attr.setCommittedDocIdLimit(docid_limit);
@@ -388,6 +389,7 @@ TensorAttributeLoader::on_load(vespalib::Executor* executor)
         } else {
             build_index(executor, docid_limit);
         }
+        _attr.end_load_phase("index");
     }
     return true;
 }
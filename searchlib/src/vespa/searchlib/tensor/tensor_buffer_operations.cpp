@@ -8,6 +8,7 @@
 #include <vespa/vespalib/util/atomic.h>
 #include <vespa/vespalib/util/shared_string_repo.h>
 #include <algorithm>
+#include <numeric>
 
 using vespalib::MemoryUsage;
 using vespalib::SharedStringRepo;
@@ -40,7 +41,11 @@ TensorBufferOperations::TensorBufferOperations(const vespalib::eval::ValueType&
       _min_alignment(adjust_min_alignment(vespalib::eval::CellTypeUtils::alignment(_subspace_type.cell_type()))),
       _addr(_num_mapped_dimensions),
       _addr_refs(),
-      _empty(_subspace_type)
+      _empty(_subspace_type),
+      _sort_subspaces(tensor_type.is_sparse() && (_num_mapped_dimensions == 1)),
+      _order(),
+      _sorted_labels(),
+      _sorted_cells()
 {
     _addr_refs.reserve(_addr.size());
     for (auto& label : _addr) {
@@ -50,6 +55,26 @@ TensorBufferOperations::TensorBufferOperations(const vespalib::eval::ValueType&
 
 TensorBufferOperations::~TensorBufferOperations() = default;
 
+void
+TensorBufferOperations::sort_subspaces(string_id* labels, char* cells, uint32_t num_subspaces)
+{
+    auto label_less = [](string_id a, string_id b) noexcept { return a.value() < b.value(); };
+    if (std::is_sorted(labels, labels + num_subspaces, label_less)) {
+        return;
+    }
+    _order.resize(num_subspaces);
+    std::iota(_order.begin(), _order.end(), 0);
+    std::sort(_order.begin(), _order.end(), [labels, &label_less](uint32_t a, uint32_t b) noexcept
+              { return label_less(labels[a], labels[b]); });
+    auto subspace_mem_size = _subspace_type.mem_size();
+    _sorted_labels.assign(labels, labels + num_subspaces);
+    _sorted_cells.assign(cells, cells + num_subspaces * subspace_mem_size);
+    for (uint32_t i = 0; i < num_subspaces; ++i) {
+        labels[i] = _sorted_labels[_order[i]];
+        memcpy(cells + i * subspace_mem_size, _sorted_cells.data() + _order[i] * subspace_mem_size, subspace_mem_size);
+    }
+}
+
 uint32_t
 TensorBufferOperations::get_num_subspaces_and_flag(std::span<const char> buf) const noexcept
 {
@@ -104,13 +129,16 @@ TensorBufferOperations::store_tensor(std::span<char> buf, const vespalib::eval::
     if (cells_mem_size > 0) {
         memcpy(buf.data() + cells_start_offset, cells.data, cells_mem_size);
     }
+    if (_sort_subspaces && num_subspaces > 1) {
+        sort_subspaces(labels, buf.data() + cells_start_offset, num_subspaces);
+    }
     if (cells_end_offset != buf.size()) {
         memset(buf.data() + cells_end_offset, 0, buf.size() - cells_end_offset);
     }
 }
 
-std::unique_ptr<vespalib::eval::Value>
-TensorBufferOperations::make_fast_view(std::span<const char> buf, const vespalib::eval::ValueType& tensor_type) const
+void
+TensorBufferOperations::set_fast_view(std::span<const char> buf, FastValueView& view) const
 {
     auto num_subspaces = get_num_subspaces(buf);
     assert(buf.size() >= get_buffer_size(num_subspaces));
@@ -121,7 +149,15 @@ TensorBufferOperations::make_fast_view(std::span<const char> buf, const vespalib
     auto cells_start_offset = get_cells_offset(num_subspaces, aligner);
     TypedCells cells(buf.data() + cells_start_offset, _subspace_type.cell_type(), cells_size);
     assert(cells_start_offset + cells_mem_size <= buf.size());
-    return std::make_unique<FastValueView>(tensor_type, labels, cells, _num_mapped_dimensions, num_subspaces);
+    view.set(labels, cells, num_subspaces);
+}
+
+std::unique_ptr<vespalib::eval::Value>
+TensorBufferOperations::make_fast_view(std::span<const char> buf, const vespalib::eval::ValueType& tensor_type) const
+{
+    auto view = std::make_unique<FastValueView>(tensor_type);
+    set_fast_view(buf, *view);
+    return view;
 }
 
 void
@@ -21,6 +21,8 @@ class ValueType;
 
 namespace search::tensor {
 
+struct FastValueView;
+
 /*
  * Class used to store a tensor in a buffer and make tensor views based on
  * buffer content.
@@ -38,6 +40,10 @@ namespace search::tensor {
  *
  * Alignment is dynamic, based on cell type, memory used by tensor cell values and
  * alignment required for reading num_subspaces and labels array.
+ *
+ * Subspaces of sparse tensors with a single mapped dimension are stored in
+ * increasing label (string id) order, allowing tensor views made from the
+ * buffer to use merge-based sparse joins.
  */
 class TensorBufferOperations
 {
@@ -47,6 +53,10 @@ class TensorBufferOperations
     std::vector<vespalib::string_id>  _addr;
     std::vector<vespalib::string_id*> _addr_refs;
     EmptySubspace                     _empty;
+    bool                              _sort_subspaces;
+    std::vector<uint32_t>             _order;
+    std::vector<vespalib::string_id>  _sorted_labels;
+    std::vector<char>                 _sorted_cells;
 
     using Aligner = vespalib::datastore::Aligner<vespalib::datastore::dynamic_alignment>;
 
@@ -69,6 +79,7 @@ class TensorBufferOperations
     size_t get_cells_offset(uint32_t num_subspaces, auto aligner) const noexcept {
         return aligner.align(get_labels_offset() + get_labels_mem_size(num_subspaces));
     }
+    void sort_subspaces(vespalib::string_id* labels, char* cells, uint32_t num_subspaces);
     uint32_t get_num_subspaces_and_flag(std::span<const char> buf) const noexcept;
     void set_skip_reclaim_labels(std::span<char> buf, uint32_t num_subspaces_and_flag) const noexcept;
     static uint32_t get_num_subspaces(uint32_t num_subspaces_and_flag) noexcept {
@@ -95,6 +106,8 @@ public:
     TensorBufferOperations& operator=(TensorBufferOperations&&) = delete;
     void store_tensor(std::span<char> buf, const vespalib::eval::Value& tensor);
     std::unique_ptr<vespalib::eval::Value> make_fast_view(std::span<const char> buf, const vespalib::eval::ValueType& tensor_type) const;
+    // Make an existing view refer to the tensor stored in the buffer
+    void set_fast_view(std::span<const char> buf, FastValueView& view) const;
 
     // Mark that reclaim_labels should be skipped for old buffer after copying tensor buffer
     void copied_labels(std::span<char> buf) const;
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "tensor_buffer_store.h"
+#include "fast_value_view.h"
 #include <vespa/document/util/serializableexceptions.h>
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/eval/streamed/streamed_value_builder_factory.h>
@@ -116,6 +117,17 @@ TensorBufferStore::get_tensor(EntryRef ref) const
     return _ops.make_fast_view(buf, _tensor_type);
 }
 
+const Value*
+TensorBufferStore::get_tensor_view(EntryRef ref, FastValueView& view) const
+{
+    if (!ref.valid()) {
+        return nullptr;
+    }
+    auto buf = _array_store.get(ref);
+    _ops.set_fast_view(buf, view);
+    return &view;
+}
+
 bool
 TensorBufferStore::encode_stored_tensor(EntryRef ref, vespalib::nbostream &target) const
 {
@@ -112,6 +112,12 @@ TensorExtAttribute::getTensor(uint32_t docid) const
     return FastValueBuilderFactory::get().copy(*tensor);
 }
 
+const Value*
+TensorExtAttribute::get_tensor_view(uint32_t docid, FastValueView&) const
+{
+    return _data[docid];
+}
+
 std::unique_ptr<Value>
 TensorExtAttribute::getEmptyTensor() const
 {
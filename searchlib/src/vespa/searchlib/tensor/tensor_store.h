@@ -15,6 +15,7 @@ namespace vespalib::eval { struct Value; }
 namespace search::tensor {
 
 class DenseTensorStore;
+struct FastValueView;
 
 /**
  * Class for storing serialized tensors in memory, used by TensorAttribute.
@@ -47,6 +48,10 @@ public:
     virtual EntryRef store_tensor(const vespalib::eval::Value& tensor) = 0;
     virtual EntryRef store_encoded_tensor(vespalib::nbostream& encoded) = 0;
     virtual std::unique_ptr<vespalib::eval::Value> get_tensor(EntryRef ref) const = 0;
+    // Get the stored tensor without copying cells. The view is used as
+    // (re-usable) storage when needed, and nullptr is returned for an
+    // invalid ref. The result is only valid until the view is re-used.
+    virtual const vespalib::eval::Value* get_tensor_view(EntryRef ref, FastValueView& view) const = 0;
     virtual bool encode_stored_tensor(EntryRef ref, vespalib::nbostream& target) const = 0;
     virtual const DenseTensorStore* as_dense() const;
     virtual DenseTensorStore* as_dense();
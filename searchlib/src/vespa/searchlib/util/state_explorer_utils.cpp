@@ -38,6 +38,31 @@ StateExplorerUtils::status_to_slime(const Status &status, Cursor &object)
         memory.setLong("onHoldBytes", status.getOnHold());
         memory.setLong("onHoldBytesMax", status.getOnHoldMax());
     }
+    {
+        Cursor &compaction = object.setObject("compaction");
+        compaction.setDouble("timeMs", status.get_compaction_time_ns() / 1000000.0);
+        compaction.setDouble("maxStallMs", status.get_max_compaction_stall_ns() / 1000000.0);
+    }
+    if (status.get_paged_hot_bytes() != 0 || status.get_paged_cold_bytes() != 0) {
+        Cursor &paged = object.setObject("pagedMemory");
+        paged.setLong("hotBytes", status.get_paged_hot_bytes());
+        paged.setLong("coldBytes", status.get_paged_cold_bytes());
+        paged.setLong("coldResidentBytes", status.get_paged_cold_resident_bytes());
+        paged.setLong("coldPageIns", status.get_paged_cold_page_ins());
+    }
+    if (status.get_estimate_compressed_bytes() != 0) {
+        Cursor &estimate = object.setObject("compressionEstimate");
+        estimate.setLong("plainBytes", status.get_estimate_plain_bytes());
+        estimate.setLong("estimatedCompressedBytes", status.get_estimate_compressed_bytes());
+        estimate.setDouble("estimatedRatio", static_cast<double>(status.get_estimate_plain_bytes()) / status.get_estimate_compressed_bytes());
+    }
+    if (status.get_policy_mapped_bytes() != 0) {
+        Cursor &policy = object.setObject("policyMemory");
+        policy.setLong("mappedBytes", status.get_policy_mapped_bytes());
+        policy.setLong("hugePageBytes", status.get_policy_huge_page_bytes());
+        policy.setLong("hugePageFallbacks", status.get_policy_huge_page_fallbacks());
+        policy.setLong("numaFailures", status.get_policy_numa_failures());
+    }
 }
 
 }
@@ -12,6 +12,7 @@
 #include <vespa/searchlib/attribute/iattributemanager.h>
 #include <vespa/searchlib/common/matching_elements.h>
 #include <vespa/searchlib/common/matching_elements_fields.h>
+#include <vespa/searchlib/tensor/fast_value_view.h>
 #include <vespa/searchlib/tensor/i_tensor_attribute.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/objects/nbostream.h>
@@ -89,8 +90,9 @@ SingleAttrDFW::insertField(uint32_t docid, GetDocsumsState& state, Inserter &tar
     case BasicType::Type::TENSOR: {
         const tensor::ITensorAttribute *tv = v.asTensorAttribute();
         assert(tv != nullptr);
-        const auto tensor = tv->getTensor(docid);
-        if (tensor) {
+        tensor::FastValueView view(tv->getTensorType());
+        const auto* tensor = tv->get_tensor_view(docid, view);
+        if (tensor != nullptr) {
             vespalib::nbostream str;
             encode_value(*tensor, str);
             target.insertData(vespalib::Memory(str.peek(), str.size()));
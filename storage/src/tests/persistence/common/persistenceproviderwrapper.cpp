@@ -4,6 +4,7 @@
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/persistence/spi/doctype_gid_and_timestamp.h>
+#include <vespa/persistence/spi/feed_operation.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <sstream>
 
@@ -146,6 +147,13 @@ PersistenceProviderWrapper::updateAsync(const spi::Bucket& bucket, spi::Timestam
     _spi.updateAsync(bucket, timestamp, std::move(upd), std::move(onComplete));
 }
 
+void
+PersistenceProviderWrapper::feedBatchAsync(const spi::Bucket& bucket, std::vector<spi::FeedOperation> ops)
+{
+    LOG_SPI("feedBatch(" << bucket << ", " << ops.size() << " ops)");
+    _spi.feedBatchAsync(bucket, std::move(ops));
+}
+
 spi::GetResult
 PersistenceProviderWrapper::get(const spi::Bucket& bucket, const document::FieldSet& fieldSet,
                                 const spi::DocumentId& id, spi::Context& context) const
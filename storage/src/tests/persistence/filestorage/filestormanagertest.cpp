@@ -4,6 +4,7 @@
 #include <tests/common/storage_config_set.h>
 #include <tests/common/testhelper.h>
 #include <tests/common/teststorageapp.h>
+#include <tests/persistence/common/persistenceproviderwrapper.h>
 #include <tests/persistence/filestorage/forwardingmessagesender.h>
 #include <vespa/config/common/exceptions.h>
 #include <memory>
@@ -33,6 +34,7 @@
 #include <vespa/vdslib/distribution/distribution.h>
 #include <vespa/vdslib/state/clusterstate.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <gmock/gmock.h>
 #include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/config-stor-filestor.h>
@@ -253,6 +255,9 @@ struct PersistenceHandlerComponents : public FileStorHandlerComponents {
     std::unique_ptr<PersistenceHandler> persistenceHandler;
 
     explicit PersistenceHandlerComponents(FileStorTestBase& test)
+        : PersistenceHandlerComponents(test, test._node->getPersistenceProvider())
+    {}
+    PersistenceHandlerComponents(FileStorTestBase& test, spi::PersistenceProvider& provider)
         : FileStorHandlerComponents(test),
           executor(test._node->executor()),
           component(test._node->getComponentRegister(), "test"),
@@ -261,8 +266,7 @@ struct PersistenceHandlerComponents : public FileStorHandlerComponents {
     {
         StorFilestorConfig cfg;
         persistenceHandler =
-                std::make_unique<PersistenceHandler>(executor, component, 4_Mi, false,
-                                                     test._node->getPersistenceProvider(),
+                std::make_unique<PersistenceHandler>(executor, component, 4_Mi, false, provider,
                                                      *filestorHandler, bucketOwnershipNotifier,
                                                      *metrics.threads[0]);
     }
@@ -416,6 +420,32 @@ TEST_F(FileStorManagerTest, feed_op_batch_updates_bucket_db_and_reply_bucket_inf
     c.filestorHandler->close(); // Ensure persistence thread is no longer in message fetch code
 }
 
+TEST_F(FileStorManagerTest, feed_op_batch_is_handed_to_provider_in_a_single_call) {
+    PersistenceProviderWrapper provider(_node->getPersistenceProvider());
+    PersistenceHandlerComponents c(*this, provider);
+    c.filestorHandler->set_max_feed_op_batch_size(10);
+    BucketId bucket_id(16, 1);
+    createBucket(bucket_id);
+    constexpr uint32_t n = 3;
+    for (uint32_t i = 0; i < n; ++i) {
+        auto put = make_put_command(120, vespalib::make_string("id:foo:testdoctype1:n=1:%u", i), Timestamp(1000) + i);
+        put->setAddress(_storage3);
+        c.filestorHandler->schedule(put);
+    }
+    auto pt = c.make_disk_thread();
+    c.filestorHandler->flush(true);
+    c.top.waitForMessages(n, _waitTime);
+    c.executor.sync_all();
+    // Bucket info is fetched through the provider as well, so only look for the feed operations
+    std::string log = provider.toString();
+    EXPECT_THAT(log, HasSubstr(vespalib::make_string("feedBatch(%s, %u ops)", makeSpiBucket(bucket_id).toString().c_str(), n)));
+    EXPECT_THAT(log, Not(HasSubstr("put(")));
+    const auto& batch_size = c.metrics.threads[0]->feed_batch_size;
+    EXPECT_EQ(1, batch_size.getCount());
+    EXPECT_DOUBLE_EQ(n, batch_size.getAverage());
+    c.filestorHandler->close(); // Ensure persistence thread is no longer in message fetch code
+}
+
 TEST_F(FileStorManagerTest, running_task_against_unknown_bucket_fails) {
     TestFileStorComponents c(*this);
 
@@ -0,0 +1,121 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "stripe_work_stealing_fixture.h"
+#include <vespa/vespalib/gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <vespa/log/log.h>
+LOG_SETUP("stripe_work_stealing_benchmark");
+
+using namespace ::testing;
+
+namespace storage {
+
+bool bench = false;
+
+using StripeWorkStealingBenchmark = StripeWorkStealingFixture;
+
+namespace {
+
+struct DrainResult {
+    double   seconds;
+    uint64_t stolen;
+    bool     in_order;
+};
+
+}
+
+// Runs persistence-thread-like consumers against a skewed load (all buckets mapping to a single
+// stripe) with and without work stealing, checking that per-bucket ordering is kept and printing
+// the time taken to drain the queue.
+TEST_F(StripeWorkStealingBenchmark, drain_skewed_load_with_and_without_work_stealing) {
+    if (!bench) {
+        fprintf(stdout, "[ SKIPPING ] run with 'bench' parameter to activate\n");
+        return;
+    }
+    constexpr uint32_t threads_per_stripe = 2;
+    constexpr uint32_t ops_per_bucket = 250;
+    constexpr auto work_per_op = 50us;
+    constexpr auto max_wait_time = 100ms; // Same as the persistence threads
+    const auto buckets = buckets_in_stripe(0, 16);
+    const size_t num_ops = buckets.size() * ops_per_bucket;
+
+    auto run = [&](bool stealing) -> DrainResult {
+        _handler->set_stripe_work_stealing(stealing);
+        std::map<uint32_t, api::Timestamp> last_seen; // bucket idx -> last processed timestamp
+        std::mutex last_seen_lock;
+        std::atomic<uint32_t> remaining(num_ops);
+        std::atomic<bool> in_order(true);
+        for (uint32_t i = 0; i < ops_per_bucket; ++i) {
+            for (uint32_t b : buckets) {
+                send_put(b, i);
+            }
+        }
+        const uint64_t stolen_before = stolen_from(0);
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point end;
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < num_stripes * threads_per_stripe; ++t) {
+            threads.emplace_back([&, stripe = t % num_stripes]() {
+                while (remaining.load() > 0) {
+                    size_t done = 0;
+                    {
+                        auto batch = _handler->next_message_batch(stripe, fake_now(), std::chrono::steady_clock::now() + max_wait_time);
+                        if (batch.empty()) {
+                            continue;
+                        }
+                        auto bucket_idx = static_cast<uint32_t>(batch.lock->getBucket().getBucketId().getRawId() & 0xffff);
+                        auto timestamp = timestamp_of(batch);
+                        {
+                            std::lock_guard guard(last_seen_lock);
+                            auto& last = last_seen[bucket_idx];
+                            if (timestamp <= last) {
+                                in_order = false;
+                            }
+                            last = timestamp;
+                        }
+                        std::this_thread::sleep_for(work_per_op); // Simulated persistence provider work
+                        done = batch.size();
+                    } // Releases the bucket lock
+                    if (remaining.fetch_sub(done) == done) {
+                        end = std::chrono::steady_clock::now();
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join(); // Threads waiting for work when the queue is drained return after max_wait_time
+        }
+        double seconds = std::chrono::duration<double>(end - start).count();
+        uint64_t stolen = stolen_from(0) - stolen_before;
+        fprintf(stderr, "work stealing %s: %zu ops in %.3f seconds (%.0f ops/s), %" PRIu64 " stolen\n",
+                (stealing ? "enabled" : "disabled"), num_ops, seconds, num_ops / seconds, stolen);
+        return {seconds, stolen, in_order.load()};
+    };
+    auto without = run(false);
+    EXPECT_TRUE(without.in_order);
+    EXPECT_EQ(without.stolen, 0u);
+    auto with = run(true);
+    EXPECT_TRUE(with.in_order);
+    EXPECT_GT(with.stolen, 0u);
+    EXPECT_EQ(_handler->getQueueSize(), 0u);
+}
+
+} // storage
+
+int main(int argc, char **argv) {
+    if (argc > 1 && (argv[1] == std::string("bench"))) {
+        fprintf(stderr, "running in benchmarking mode\n");
+        storage::bench = true;
+        ++argv;
+        --argc;
+    }
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,80 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "stripe_work_stealing_fixture.h"
+#include <tests/common/testhelper.h>
+#include <vespa/document/test/make_document_bucket.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using document::test::makeDocumentBucket;
+using document::BucketId;
+
+namespace storage {
+
+StripeWorkStealingFixture::StripeWorkStealingFixture()
+    : FileStorTestFixture(),
+      _top(),
+      _message_sender(),
+      _metrics(),
+      _handler(),
+      _next_timestamp(1000)
+{
+}
+
+StripeWorkStealingFixture::~StripeWorkStealingFixture() = default;
+
+void
+StripeWorkStealingFixture::SetUp()
+{
+    FileStorTestFixture::SetUp();
+    auto message_receiver = std::make_unique<DummyStorageLink>();
+    _message_sender = std::make_unique<ForwardingMessageSender>(*message_receiver);
+    _top.push_back(std::move(message_receiver));
+    _top.open();
+    _metrics.initDiskMetrics(num_stripes, 2);
+    _handler = std::make_unique<FileStorHandlerImpl>(2 * num_stripes, num_stripes, *_message_sender, _metrics,
+                                                     _node->getComponentRegister(),
+                                                     vespalib::SharedOperationThrottler::DynamicThrottleParams());
+}
+
+void
+StripeWorkStealingFixture::TearDown()
+{
+    _handler.reset();
+    FileStorTestFixture::TearDown();
+}
+
+document::Bucket
+StripeWorkStealingFixture::bucket_of(uint32_t bucket_idx)
+{
+    return makeDocumentBucket(BucketId(16, bucket_idx));
+}
+
+std::vector<uint32_t>
+StripeWorkStealingFixture::buckets_in_stripe(uint32_t stripe, uint32_t n) const
+{
+    std::vector<uint32_t> result;
+    for (uint32_t i = 1; result.size() < n; ++i) {
+        if (_handler->stripe_index_for_testing(bucket_of(i)) == stripe) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+void
+StripeWorkStealingFixture::send_put(uint32_t bucket_idx, uint32_t doc_idx)
+{
+    auto id = vespalib::make_string("id:foo:testdoctype1:n=%u:%u", bucket_idx, doc_idx);
+    auto doc = _node->getTestDocMan().createDocument("foobar", id);
+    auto cmd = std::make_shared<api::PutCommand>(bucket_of(bucket_idx), std::move(doc), _next_timestamp++);
+    cmd->setAddress(makeSelfAddress());
+    _handler->schedule(cmd);
+}
+
+api::Timestamp
+StripeWorkStealingFixture::timestamp_of(const FileStorHandler::LockedMessageBatch& batch)
+{
+    return dynamic_cast<const api::PutCommand&>(*batch.messages[0].first).getTimestamp();
+}
+
+}
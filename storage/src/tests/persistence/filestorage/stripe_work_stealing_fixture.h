@@ -0,0 +1,56 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <tests/common/dummystoragelink.h>
+#include <tests/persistence/common/filestortestfixture.h>
+#include <tests/persistence/filestorage/forwardingmessagesender.h>
+#include <vespa/storage/persistence/filestorage/filestorhandlerimpl.h>
+#include <vespa/storage/persistence/filestorage/filestormetrics.h>
+#include <vector>
+
+namespace storage {
+
+/**
+ * Fixture with a FileStorHandlerImpl of several stripes and no persistence threads, shared by
+ * the stripe work stealing tests and benchmark.
+ */
+struct StripeWorkStealingFixture : FileStorTestFixture {
+    static constexpr uint32_t num_stripes = 4;
+
+    DummyStorageLink                         _top;
+    std::unique_ptr<ForwardingMessageSender> _message_sender;
+    FileStorMetrics                          _metrics;
+    std::unique_ptr<FileStorHandlerImpl>     _handler;
+    api::Timestamp                           _next_timestamp;
+
+    StripeWorkStealingFixture();
+    ~StripeWorkStealingFixture() override;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    [[nodiscard]] static document::Bucket bucket_of(uint32_t bucket_idx);
+
+    // Returns the `n` lowest bucket indices that map to the given stripe
+    [[nodiscard]] std::vector<uint32_t> buckets_in_stripe(uint32_t stripe, uint32_t n) const;
+
+    void send_put(uint32_t bucket_idx, uint32_t doc_idx);
+
+    [[nodiscard]] vespalib::steady_time fake_now() const {
+        return _node->getClock().getMonotonicTime();
+    }
+
+    // Deadline is in the past, so the call never blocks waiting for the queue
+    [[nodiscard]] FileStorHandler::LockedMessageBatch next_batch(uint32_t stripe) {
+        return _handler->next_message_batch(stripe, fake_now(), fake_now());
+    }
+
+    [[nodiscard]] uint64_t stolen_from(uint32_t stripe) const {
+        return _metrics.stripes[stripe]->stolen_operations.getValue();
+    }
+
+    [[nodiscard]] static api::Timestamp timestamp_of(const FileStorHandler::LockedMessageBatch& batch);
+};
+
+}
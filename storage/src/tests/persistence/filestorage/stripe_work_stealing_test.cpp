@@ -0,0 +1,91 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "stripe_work_stealing_fixture.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace ::testing;
+
+namespace storage {
+
+using StripeWorkStealingTest = StripeWorkStealingFixture;
+
+TEST_F(StripeWorkStealingTest, idle_stripe_does_not_steal_when_disabled) {
+    auto bucket = buckets_in_stripe(0, 1)[0];
+    send_put(bucket, 1);
+    EXPECT_TRUE(next_batch(1).empty());
+    EXPECT_EQ(stolen_from(0), 0u);
+    auto batch = next_batch(0);
+    ASSERT_FALSE(batch.empty());
+    EXPECT_EQ(batch.lock->getBucket(), bucket_of(bucket));
+} // storage
+
+TEST_F(StripeWorkStealingTest, idle_stripe_steals_from_busy_stripe) {
+    _handler->set_stripe_work_stealing(true);
+    auto bucket = buckets_in_stripe(0, 1)[0];
+    send_put(bucket, 1);
+    auto batch = next_batch(1);
+    ASSERT_FALSE(batch.empty());
+    EXPECT_EQ(batch.lock->getBucket(), bucket_of(bucket));
+    EXPECT_EQ(stolen_from(0), 1u);
+    EXPECT_TRUE(next_batch(0).empty());
+} // storage
+
+TEST_F(StripeWorkStealingTest, stripe_with_queued_operations_does_not_steal) {
+    _handler->set_stripe_work_stealing(true);
+    auto bucket0 = buckets_in_stripe(0, 1)[0];
+    auto bucket1 = buckets_in_stripe(1, 1)[0];
+    send_put(bucket0, 1);
+    send_put(bucket1, 2);
+    auto batch = next_batch(1);
+    ASSERT_FALSE(batch.empty());
+    EXPECT_EQ(batch.lock->getBucket(), bucket_of(bucket1));
+    EXPECT_EQ(stolen_from(0), 0u);
+} // storage
+
+TEST_F(StripeWorkStealingTest, stolen_operation_holds_bucket_lock_in_owning_stripe) {
+    _handler->set_stripe_work_stealing(true);
+    auto bucket = buckets_in_stripe(0, 1)[0];
+    send_put(bucket, 1);
+    send_put(bucket, 2);
+    {
+        auto stolen = next_batch(1);
+        ASSERT_FALSE(stolen.empty());
+        EXPECT_EQ(timestamp_of(stolen), 1000u);
+        // Next operation to the same bucket must wait for the stolen one, regardless of thread
+        EXPECT_TRUE(next_batch(0).empty());
+        EXPECT_TRUE(next_batch(2).empty());
+    }
+    auto batch = next_batch(0);
+    ASSERT_FALSE(batch.empty());
+    EXPECT_EQ(timestamp_of(batch), 1001u);
+} // storage
+
+TEST_F(StripeWorkStealingTest, waiting_thread_in_idle_stripe_is_woken_when_busy_stripe_gets_work) {
+    _handler->set_stripe_work_stealing(true);
+    auto bucket = buckets_in_stripe(0, 1)[0];
+    const auto wait_time = 60s;
+    std::chrono::steady_clock::duration waited;
+    document::Bucket stolen_bucket;
+    std::thread thread([&]() {
+        auto start = std::chrono::steady_clock::now();
+        // Stripe 0 has no waiting threads of its own, so scheduling to it wakes us up
+        for (;;) {
+            auto batch = _handler->next_message_batch(1, fake_now(), std::chrono::steady_clock::now() + wait_time);
+            if (!batch.empty()) {
+                stolen_bucket = batch.lock->getBucket();
+                break;
+            }
+        }
+        waited = std::chrono::steady_clock::now() - start;
+    });
+    std::this_thread::sleep_for(10ms);
+    send_put(bucket, 1);
+    thread.join();
+    EXPECT_EQ(stolen_bucket, bucket_of(bucket));
+    EXPECT_EQ(stolen_from(0), 1u);
+    EXPECT_LT(waited, wait_time);
+} // storage
+
+} // storage
@@ -168,6 +168,11 @@ struct MergeHandlerTest : PersistenceTestUtils {
         return {getEnv(), spi, getEnv()._component.cluster_context(),
                 getEnv()._component.getClock(), *_sequenceTaskExecutor, 4190208};
     }
+    MergeHandler createPipelinedHandler(uint32_t max_pending_write_windows, uint64_t pending_write_memory_budget) {
+        return {getEnv(), getPersistenceProvider(), getEnv()._component.cluster_context(),
+                getEnv()._component.getClock(), *_sequenceTaskExecutor, 0x400000,
+                max_pending_write_windows, pending_write_memory_budget};
+    }
 
     std::shared_ptr<api::StorageMessage> get_queued_reply() {
         std::shared_ptr<api::StorageMessage> msg;
@@ -1413,6 +1418,107 @@ TEST_F(MergeHandlerTest, partially_filled_apply_bucket_diff_reply)
     LOG(debug, "got mergebucket reply");
 }
 
+TEST_F(MergeHandlerTest, pipelined_local_writes_complete_before_merge_reply)
+{
+    auto doc1 = _env->_testDocMan.createRandomDocumentAtLocation(_location, 1);
+    auto doc2 = _env->_testDocMan.createRandomDocumentAtLocation(_location, 2);
+    _maxTimestamp = 30000;
+    spi::Bucket spi_bucket(_bucket);
+    auto docs_before = getPersistenceProvider().getBucketInfo(spi_bucket).getBucketInfo().getDocumentCount();
+
+    MergeHandler handler = createPipelinedHandler(2, 1_Mi);
+    auto cmd = std::make_shared<api::MergeBucketCommand>(_bucket, _nodes, _maxTimestamp);
+    handler.handleMergeBucket(*cmd, createTracker(cmd, _bucket));
+    auto get_bucket_diff_cmd = fetchSingleMessage<api::GetBucketDiffCommand>();
+    {
+        auto reply = std::make_unique<api::GetBucketDiffReply>(*get_bucket_diff_cmd);
+        // doc1 and doc2 are only present on node 1.
+        reply->getDiff().push_back(make_entry(20000, 2u));
+        reply->getDiff().push_back(make_entry(20100, 2u));
+        handler.handleGetBucketDiffReply(*reply, messageKeeper());
+    }
+    {
+        auto apply_cmd = fetchSingleMessage<api::ApplyBucketDiffCommand>();
+        auto reply = std::make_shared<api::ApplyBucketDiffReply>(*apply_cmd);
+        auto& diff = reply->getDiff();
+        ASSERT_EQ(get_bucket_diff_cmd->getDiff().size() + 2u, diff.size());
+        for (auto& e : diff) {
+            if (e._entry._timestamp == 20000u) {
+                fill_entry(e, *doc1, getEnv().getDocumentTypeRepo());
+            } else if (e._entry._timestamp != 20100u) {
+                e._entry._hasMask |= 2u; // Simulate diff entry having been applied on node 1.
+            }
+        }
+        // doc2 is left unfilled, forcing a second merge round while doc1 may still be written locally.
+        handler.handleApplyBucketDiffReply(*reply, messageKeeper(), createTracker(reply, _bucket));
+    }
+    {
+        auto apply_cmd = fetchSingleMessage<api::ApplyBucketDiffCommand>();
+        EXPECT_TRUE(getEnv()._fileStorHandler.isMerging(_bucket));
+        auto s = getEnv()._fileStorHandler.editMergeStatus(_bucket);
+        EXPECT_LE(s->pending_write_windows.size(), 1u);
+        auto reply = std::make_shared<api::ApplyBucketDiffReply>(*apply_cmd);
+        auto& diff = reply->getDiff();
+        ASSERT_EQ(1u, diff.size());
+        EXPECT_EQ(EntryCheck(20100u, 2u), diff[0]._entry);
+        fill_entry(diff[0], *doc2, getEnv().getDocumentTypeRepo());
+        handler.handleApplyBucketDiffReply(*reply, messageKeeper(), createTracker(reply, _bucket));
+    }
+    handler.drain_async_writes();
+    auto merge_reply = fetchSingleMessage<api::MergeBucketReply>();
+    EXPECT_TRUE(merge_reply->getResult().success());
+    EXPECT_FALSE(getEnv()._fileStorHandler.isMerging(_bucket));
+    const auto& metrics = getEnv()._metrics.merge_handler_metrics;
+    EXPECT_EQ(1u, metrics.merge_pending_write_windows.getCount());
+    EXPECT_EQ(1u, metrics.merge_throughput.getCount());
+    EXPECT_EQ(docs_before + 2u, getPersistenceProvider().getBucketInfo(spi_bucket).getBucketInfo().getDocumentCount());
+}
+
+TEST_F(MergeHandlerTest, pipelined_local_writes_complete_before_failed_merge_reply)
+{
+    auto doc1 = _env->_testDocMan.createRandomDocumentAtLocation(_location, 1);
+    _maxTimestamp = 30000;
+    spi::Bucket spi_bucket(_bucket);
+    auto docs_before = getPersistenceProvider().getBucketInfo(spi_bucket).getBucketInfo().getDocumentCount();
+
+    MergeHandler handler = createPipelinedHandler(2, 1_Mi);
+    auto cmd = std::make_shared<api::MergeBucketCommand>(_bucket, _nodes, _maxTimestamp);
+    handler.handleMergeBucket(*cmd, createTracker(cmd, _bucket));
+    auto get_bucket_diff_cmd = fetchSingleMessage<api::GetBucketDiffCommand>();
+    {
+        auto reply = std::make_unique<api::GetBucketDiffReply>(*get_bucket_diff_cmd);
+        // doc1 and doc2 are only present on node 1.
+        reply->getDiff().push_back(make_entry(20000, 2u));
+        reply->getDiff().push_back(make_entry(20100, 2u));
+        handler.handleGetBucketDiffReply(*reply, messageKeeper());
+    }
+    {
+        auto apply_cmd = fetchSingleMessage<api::ApplyBucketDiffCommand>();
+        auto reply = std::make_shared<api::ApplyBucketDiffReply>(*apply_cmd);
+        for (auto& e : reply->getDiff()) {
+            if (e._entry._timestamp == 20000u) {
+                fill_entry(e, *doc1, getEnv().getDocumentTypeRepo());
+            } else if (e._entry._timestamp != 20100u) {
+                e._entry._hasMask |= 2u; // Simulate diff entry having been applied on node 1.
+            }
+        }
+        // doc2 is left unfilled, forcing a second merge round while doc1 may still be written locally.
+        handler.handleApplyBucketDiffReply(*reply, messageKeeper(), createTracker(reply, _bucket));
+    }
+    {
+        auto apply_cmd = fetchSingleMessage<api::ApplyBucketDiffCommand>();
+        auto reply = std::make_shared<api::ApplyBucketDiffReply>(*apply_cmd);
+        reply->setResult(api::ReturnCode(api::ReturnCode::INTERNAL_FAILURE, "node 1 failed"));
+        handler.handleApplyBucketDiffReply(*reply, messageKeeper(), createTracker(reply, _bucket));
+    }
+    // The local write of doc1 is done when the failed merge is replied to.
+    auto merge_reply = fetchSingleMessage<api::MergeBucketReply>();
+    EXPECT_EQ(api::ReturnCode::INTERNAL_FAILURE, merge_reply->getResult().getResult());
+    EXPECT_FALSE(getEnv()._fileStorHandler.isMerging(_bucket));
+    EXPECT_EQ(docs_before + 1u, getPersistenceProvider().getBucketInfo(spi_bucket).getBucketInfo().getDocumentCount());
+    handler.drain_async_writes();
+}
+
 TEST_F(MergeHandlerTest, multiple_versions_in_apply_diff_only_writes_newest_version) {
     setUpChain(BACK);
 
@@ -68,6 +68,7 @@ DistributorStripe::DistributorStripe(DistributorComponentRegister& compReg,
                                                         *_throttlingStarter, *_blockingStarter)),
       _schedulingMode(MaintenanceScheduler::NORMAL_SCHEDULING_MODE),
       _recoveryTimeStarted(_component.getClock()),
+      _scanTimeStarted(_component.getClock()),
       _tickResult(framework::ThreadWaitInfo::NO_MORE_CRITICAL_WORK_KNOWN),
       _bucketIdHasher(std::make_unique<BucketGcTimeCalculator::BucketIdIdentityHasher>()),
       _node_supported_features_repo(std::make_shared<const NodeSupportedFeaturesRepo>()),
@@ -426,6 +427,7 @@ DistributorStripe::enterRecoveryMode()
     invalidate_internal_db_dependent_stats();
 
     _recoveryTimeStarted = framework::MilliSecTimer(_component.getClock());
+    _scanTimeStarted = framework::MilliSecTimer(_component.getClock());
 }
 
 void
@@ -782,6 +784,8 @@ DistributorStripe::scanNextBucket()
 {
     MaintenanceScanner::ScanResult scanResult(_scanner->scanNext());
     if (scanResult.isDone()) {
+        _metrics.full_scan_time.addValue(_scanTimeStarted.getElapsedTimeAsDouble());
+        _scanTimeStarted = framework::MilliSecTimer(_component.getClock());
         updateInternalMetricsForCompletedScan();
         leaveRecoveryMode();
         send_updated_host_info_if_required();
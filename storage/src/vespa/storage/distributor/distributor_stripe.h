@@ -357,6 +357,7 @@ private:
     std::unique_ptr<MaintenanceScheduler> _scheduler;
     MaintenanceScheduler::SchedulingMode _schedulingMode;
     framework::MilliSecTimer _recoveryTimeStarted;
+    framework::MilliSecTimer _scanTimeStarted;
     framework::ThreadWaitInfo _tickResult;
     BucketDBMetricUpdater _bucketDBMetricUpdater;
     std::unique_ptr<BucketGcTimeCalculator::BucketIdHasher> _bucketIdHasher;
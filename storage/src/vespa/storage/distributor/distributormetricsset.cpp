@@ -42,6 +42,9 @@ DistributorMetricSet::DistributorMetricSet()
       recoveryModeTime("recoverymodeschedulingtime", {},
               "Time spent scheduling operations in recovery mode "
               "after receiving new cluster state", this),
+      full_scan_time("full_scan_time", {},
+              "Time (in ms) from a maintenance scan of the bucket database is started "
+              "until all buckets have been scanned", this),
       docsStored("docsstored",
               {{"logdefault"},{"yamasdefault"}},
               "Number of documents stored in all buckets controlled by "
@@ -36,6 +36,7 @@ public:
     metrics::DoubleAverageMetric  set_cluster_state_processing_time;
     metrics::DoubleAverageMetric  activate_cluster_state_processing_time;
     metrics::DoubleAverageMetric  recoveryModeTime;
+    metrics::DoubleAverageMetric  full_scan_time;
     metrics::LongValueMetric      docsStored;
     metrics::LongValueMetric      bytesStored;
     BucketDbMetrics               mutable_dbs;
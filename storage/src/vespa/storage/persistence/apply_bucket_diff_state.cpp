@@ -37,7 +37,9 @@ ApplyBucketDiffState::ApplyBucketDiffState(const MergeBucketInfoSyncer& merge_bu
       _op_metrics(nullptr),
       _op_start_time(),
       _retain_guard(std::move(retain_guard)),
-      _merge_start_time()
+      _merge_start_time(),
+      _pending_write_timestamps(),
+      _pending_write_bytes(0)
 {
 }
 
@@ -143,6 +145,13 @@ ApplyBucketDiffState::set_merge_start_time(const framework::MilliSecTimer& merge
     _merge_start_time = merge_start_time;
 }
 
+void
+ApplyBucketDiffState::add_pending_write(uint64_t timestamp, uint64_t bytes)
+{
+    _pending_write_timestamps.emplace_back(timestamp);
+    _pending_write_bytes += bytes;
+}
+
 std::shared_ptr<ApplyBucketDiffState>
 ApplyBucketDiffState::create(const MergeBucketInfoSyncer& merge_bucket_info_syncer, MergeHandlerMetrics& merge_handler_metrics, const framework::Clock& clock, const spi::Bucket& bucket, RetainGuard&& retain_guard)
 {
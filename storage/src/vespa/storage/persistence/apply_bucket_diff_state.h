@@ -42,6 +42,8 @@ class ApplyBucketDiffState {
     std::optional<framework::MilliSecTimer> _op_start_time;
     vespalib::RetainGuard                   _retain_guard;
     std::optional<framework::MilliSecTimer> _merge_start_time;
+    std::vector<uint64_t>                   _pending_write_timestamps;
+    uint64_t                                _pending_write_bytes;
 
     ApplyBucketDiffState(const MergeBucketInfoSyncer &merge_bucket_info_syncer, MergeHandlerMetrics& merge_handler_metrics, const framework::Clock& clock, const spi::Bucket& bucket, vespalib::RetainGuard&& retain_guard);
 public:
@@ -58,6 +60,14 @@ public:
     void set_tracker(std::unique_ptr<MessageTracker>&& tracker);
     void set_merge_start_time(const framework::MilliSecTimer& merge_start_time);
     const spi::Bucket& get_bucket() const noexcept { return _bucket; }
+    /*
+     * Record that a diff entry with the given timestamp and payload size has been
+     * handed to the persistence provider. Only called by the thread applying the diff,
+     * before the state is shared with a pending write window.
+     */
+    void add_pending_write(uint64_t timestamp, uint64_t bytes);
+    const std::vector<uint64_t>& pending_write_timestamps() const noexcept { return _pending_write_timestamps; }
+    uint64_t pending_write_bytes() const noexcept { return _pending_write_bytes; }
 };
 
 }
@@ -5,6 +5,7 @@
 #include "testandsethelper.h"
 #include "bucketownershipnotifier.h"
 #include "bucketprocessor.h"
+#include "feed_operation_batch.h"
 #include <vespa/persistence/spi/persistenceprovider.h>
 #include <vespa/persistence/spi/docentry.h>
 #include <vespa/persistence/spi/doctype_gid_and_timestamp.h>
@@ -153,7 +154,7 @@ AsyncHandler::handleRunTask(RunTaskCommand& cmd, MessageTracker::UP tracker) con
 }
 
 MessageTracker::UP
-AsyncHandler::handlePut(api::PutCommand& cmd, MessageTracker::UP trackerUP) const
+AsyncHandler::handlePut(api::PutCommand& cmd, MessageTracker::UP trackerUP, FeedOperationBatch* feed_batch) const
 {
     MessageTracker & tracker = *trackerUP;
     auto& metrics = _env._metrics.put;
@@ -172,8 +173,12 @@ AsyncHandler::handlePut(api::PutCommand& cmd, MessageTracker::UP trackerUP) cons
         (void)tracker->checkForError(*response);
         tracker->sendReply();
     });
-    _spi.putAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getDocument(),
-                  std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task)));
+    auto on_complete = std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task));
+    if (feed_batch) {
+        feed_batch->add(spi::FeedOperation::make_put(spi::Timestamp(cmd.getTimestamp()), cmd.getDocument(), std::move(on_complete)));
+    } else {
+        _spi.putAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getDocument(), std::move(on_complete));
+    }
 
     return trackerUP;
 }
@@ -338,7 +343,7 @@ AsyncHandler::handleSetBucketState(api::SetBucketStateCommand& cmd, MessageTrack
 }
 
 MessageTracker::UP
-AsyncHandler::handleUpdate(api::UpdateCommand& cmd, MessageTracker::UP trackerUP) const
+AsyncHandler::handleUpdate(api::UpdateCommand& cmd, MessageTracker::UP trackerUP, FeedOperationBatch* feed_batch) const
 {
     MessageTracker & tracker = *trackerUP;
     auto& metrics = _env._metrics.update;
@@ -370,13 +375,17 @@ AsyncHandler::handleUpdate(api::UpdateCommand& cmd, MessageTracker::UP trackerUP
         }
         tracker->sendReply();
     });
-    _spi.updateAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getUpdate(),
-                     std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task)));
+    auto on_complete = std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task));
+    if (feed_batch) {
+        feed_batch->add(spi::FeedOperation::make_update(spi::Timestamp(cmd.getTimestamp()), cmd.getUpdate(), std::move(on_complete)));
+    } else {
+        _spi.updateAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getUpdate(), std::move(on_complete));
+    }
     return trackerUP;
 }
 
 MessageTracker::UP
-AsyncHandler::handleRemove(api::RemoveCommand& cmd, MessageTracker::UP trackerUP) const
+AsyncHandler::handleRemove(api::RemoveCommand& cmd, MessageTracker::UP trackerUP, FeedOperationBatch* feed_batch) const
 {
     MessageTracker & tracker = *trackerUP;
     auto& metrics = _env._metrics.remove;
@@ -401,8 +410,12 @@ AsyncHandler::handleRemove(api::RemoveCommand& cmd, MessageTracker::UP trackerUP
         }
         tracker->sendReply();
     });
-    _spi.removeIfFoundAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getDocumentId(),
-                            std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task)));
+    auto on_complete = std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task));
+    if (feed_batch) {
+        feed_batch->add(spi::FeedOperation::make_remove_if_found(spi::Timestamp(cmd.getTimestamp()), cmd.getDocumentId(), std::move(on_complete)));
+    } else {
+        _spi.removeIfFoundAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getDocumentId(), std::move(on_complete));
+    }
     return trackerUP;
 }
 
@@ -15,6 +15,7 @@ namespace spi {
 }
 class PersistenceUtil;
 class BucketOwnershipNotifier;
+class FeedOperationBatch;
 class MessageTracker;
 
 /**
@@ -26,9 +27,10 @@ class AsyncHandler {
 public:
     AsyncHandler(const PersistenceUtil&, spi::PersistenceProvider&, BucketOwnershipNotifier&,
                  vespalib::ISequencedTaskExecutor& executor, const document::BucketIdFactory& bucketIdFactory);
-    MessageTrackerUP handlePut(api::PutCommand& cmd, MessageTrackerUP tracker) const;
-    MessageTrackerUP handleRemove(api::RemoveCommand& cmd, MessageTrackerUP tracker) const;
-    MessageTrackerUP handleUpdate(api::UpdateCommand& cmd, MessageTrackerUP tracker) const;
+    // If feed_batch is non-null, the SPI operation is added to it instead of being dispatched directly.
+    MessageTrackerUP handlePut(api::PutCommand& cmd, MessageTrackerUP tracker, FeedOperationBatch* feed_batch = nullptr) const;
+    MessageTrackerUP handleRemove(api::RemoveCommand& cmd, MessageTrackerUP tracker, FeedOperationBatch* feed_batch = nullptr) const;
+    MessageTrackerUP handleUpdate(api::UpdateCommand& cmd, MessageTrackerUP tracker, FeedOperationBatch* feed_batch = nullptr) const;
     MessageTrackerUP handleRunTask(RunTaskCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handleSetBucketState(api::SetBucketStateCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handle_delete_bucket_throttling(api::DeleteBucketCommand& cmd, MessageTrackerUP tracker) const;
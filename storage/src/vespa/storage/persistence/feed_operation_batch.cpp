@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "feed_operation_batch.h"
+#include <vespa/persistence/spi/persistenceprovider.h>
+#include <cassert>
+
+namespace storage {
+
+FeedOperationBatch::FeedOperationBatch(spi::PersistenceProvider& spi, const spi::Bucket& bucket)
+    : _spi(spi),
+      _bucket(bucket),
+      _ops()
+{
+}
+
+FeedOperationBatch::~FeedOperationBatch()
+{
+    assert(_ops.empty());
+}
+
+void
+FeedOperationBatch::add(spi::FeedOperation op)
+{
+    _ops.emplace_back(std::move(op));
+}
+
+void
+FeedOperationBatch::flush()
+{
+    if (_ops.empty()) {
+        return;
+    }
+    std::vector<spi::FeedOperation> ops;
+    ops.swap(_ops);
+    _spi.feedBatchAsync(_bucket, std::move(ops));
+}
+
+}
@@ -0,0 +1,37 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/persistence/spi/bucket.h>
+#include <vespa/persistence/spi/feed_operation.h>
+#include <vector>
+
+namespace storage {
+
+namespace spi { struct PersistenceProvider; }
+
+/**
+ * Collects the put, update and remove operations of a locked message batch
+ * towards a single bucket, so that they can be handed to the persistence
+ * provider in one feedBatchAsync call instead of one call per operation.
+ *
+ * Not thread safe; owned by the persistence thread processing the batch.
+ */
+class FeedOperationBatch {
+    spi::PersistenceProvider&       _spi;
+    spi::Bucket                     _bucket;
+    std::vector<spi::FeedOperation> _ops;
+public:
+    FeedOperationBatch(spi::PersistenceProvider& spi, const spi::Bucket& bucket);
+    FeedOperationBatch(const FeedOperationBatch&) = delete;
+    FeedOperationBatch& operator=(const FeedOperationBatch&) = delete;
+    ~FeedOperationBatch();
+
+    void add(spi::FeedOperation op);
+    // Dispatches all collected operations to the provider, in the order they were added.
+    void flush();
+    [[nodiscard]] const spi::Bucket& bucket() const noexcept { return _bucket; }
+    [[nodiscard]] size_t size() const noexcept { return _ops.size(); }
+    [[nodiscard]] bool empty() const noexcept { return _ops.empty(); }
+};
+
+}
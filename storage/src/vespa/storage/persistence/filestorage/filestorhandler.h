@@ -290,6 +290,13 @@ public:
     virtual void set_throttle_apply_bucket_diff_ops(bool throttle_apply_bucket_diff) noexcept = 0;
 
     virtual void set_max_feed_op_batch_size(uint32_t max_batch) noexcept = 0;
+
+    /**
+     * Allow persistence threads that find their own stripe idle to dispatch operations queued
+     * in other stripes. Operations are still locked and released in the stripe owning their
+     * bucket, so per-bucket ordering and locking is unaffected.
+     */
+    virtual void set_stripe_work_stealing(bool enabled) noexcept = 0;
 private:
     vespalib::duration _getNextMessageTimout;
 };
@@ -62,7 +62,8 @@ FileStorHandlerImpl::FileStorHandlerImpl(uint32_t numThreads, uint32_t numStripe
       _paused(false),
       _throttle_apply_bucket_diff_ops(false),
       _last_active_operations_stats(),
-      _max_feed_op_batch_size(1)
+      _max_feed_op_batch_size(1),
+      _stripe_work_stealing(false)
 {
     assert(numStripes > 0);
     _stripes.reserve(numStripes);
@@ -413,7 +414,69 @@ FileStorHandlerImpl::next_message_batch(uint32_t stripe_id, vespalib::steady_tim
     if (!tryHandlePause()) {
         return {};
     }
-    return _stripes[stripe_id].next_message_batch(now, deadline);
+    if (stripe_work_stealing() && (_stripes.size() > 1) && (_stripes[stripe_id].get_cached_queue_size() == 0)) {
+        // Taken before trying the other stripes, so that work arriving anywhere after the attempt
+        // keeps us from going to sleep below.
+        const uint64_t seen_work_generation = work_generation();
+        auto stolen = steal_message_batch(stripe_id, now);
+        if (!stolen.empty()) {
+            return stolen;
+        }
+        // Wait on our own stripe. A stripe that gets work while none of its own threads are
+        // waiting wakes up one waiting thread in another stripe (see wake_idle_stealer()).
+        return _stripes[stripe_id].next_message_batch(now, deadline, seen_work_generation);
+    }
+    return _stripes[stripe_id].next_message_batch(now, deadline, std::nullopt);
+}
+
+FileStorHandler::LockedMessageBatch
+FileStorHandlerImpl::steal_message_batch(uint32_t stripe_id, vespalib::steady_time now)
+{
+    const size_t num_stripes = _stripes.size();
+    for (size_t i = 1; i < num_stripes; ++i) {
+        Stripe& victim = _stripes[(stripe_id + i) % num_stripes];
+        if (victim.get_cached_queue_size() == 0) {
+            continue;
+        }
+        auto batch = victim.try_steal_message_batch(now);
+        if (!batch.empty()) {
+            return batch;
+        }
+    }
+    return {};
+}
+
+uint64_t
+FileStorHandlerImpl::work_generation() const noexcept
+{
+    uint64_t sum = 0;
+    for (const auto& stripe : _stripes) {
+        sum += stripe.work_generation();
+    }
+    return sum;
+}
+
+void
+FileStorHandlerImpl::wake_idle_stealer(const Stripe& stripe_with_work) const
+{
+    if (!stripe_work_stealing()) {
+        return;
+    }
+    // Pairs with the fence in Stripe::wait_for_work(). Either we see a thread that registered
+    // as idle, or that thread sees the work generation bumped before calling us.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (stripe_with_work.idle_threads() != 0) {
+        return; // One of the stripe's own threads is woken up instead
+    }
+    const size_t num_stripes = _stripes.size();
+    const size_t self = &stripe_with_work - _stripes.data();
+    for (size_t i = 1; i < num_stripes; ++i) {
+        const Stripe& stripe = _stripes[(self + i) % num_stripes];
+        if (stripe.idle_threads() != 0) {
+            stripe.wake_idle_thread();
+            return;
+        }
+    }
 }
 
 FileStorHandler::LockedMessage
@@ -923,6 +986,8 @@ FileStorHandlerImpl::Stripe::Stripe(const FileStorHandlerImpl & owner, MessageSe
       _cond(std::make_unique<std::condition_variable>()),
       _queue(std::make_unique<PriorityQueue>()),
       _cached_queue_size(_queue->size()),
+      _work_generation(0),
+      _idle_threads(0),
       _lockedBuckets(),
       _active_merges(0),
       _active_operations_stats()
@@ -955,8 +1020,64 @@ FileStorHandlerImpl::Stripe::operation_type_should_be_throttled(api::MessageType
     }
 }
 
+std::optional<FileStorHandler::LockedMessage>
+FileStorHandlerImpl::Stripe::try_pop_next_message(monitor_guard& guard, ThrottleToken& throttle_token, bool& was_throttled)
+{
+    PriorityIdx& idx(bmi::get<1>(*_queue));
+    PriorityIdx::iterator iter(idx.begin()), end(idx.end());
+
+    while ((iter != end) && operationIsInhibited(guard, iter->_bucket, *iter->_command)) {
+        ++iter;
+    }
+    if (iter == end) {
+        return std::nullopt;
+    }
+    const bool should_throttle_op = operation_type_should_be_throttled(iter->_command->getType().getId());
+    if (!should_throttle_op && throttle_token.valid()) {
+        throttle_token.reset(); // Let someone else play with it.
+    } else if (should_throttle_op && !throttle_token.valid()) {
+        // Important: _non-blocking_ attempt at getting a throttle token.
+        throttle_token = _owner.operation_throttler().try_acquire_one();
+        if (!throttle_token.valid()) {
+            was_throttled = true;
+            _metrics->throttled_persistence_thread_polls.inc();
+        }
+    }
+    if (!should_throttle_op || throttle_token.valid()) {
+        return getMessage(guard, idx, iter, std::move(throttle_token));
+    }
+    return std::nullopt;
+}
+
+void
+FileStorHandlerImpl::Stripe::wake_idle_thread() const
+{
+    // Taking the lock ensures that a thread registered as idle has started waiting
+    {
+        std::lock_guard guard(*_lock);
+    }
+    _cond->notify_one();
+}
+
+void
+FileStorHandlerImpl::Stripe::wait_for_work(monitor_guard& guard, vespalib::steady_time deadline,
+                                           std::optional<uint64_t> seen_work_generation)
+{
+    if (!seen_work_generation.has_value()) {
+        _cond->wait_until(guard, deadline);
+        return;
+    }
+    _idle_threads.store_relaxed(_idle_threads.load_relaxed() + 1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_owner.work_generation() == seen_work_generation.value()) {
+        _cond->wait_until(guard, deadline);
+    }
+    _idle_threads.store_relaxed(_idle_threads.load_relaxed() - 1);
+}
+
 FileStorHandler::LockedMessage
-FileStorHandlerImpl::Stripe::next_message_impl(monitor_guard& guard, vespalib::steady_time deadline)
+FileStorHandlerImpl::Stripe::next_message_impl(monitor_guard& guard, vespalib::steady_time deadline,
+                                               std::optional<uint64_t> seen_work_generation)
 {
     ThrottleToken throttle_token;
     // Try to grab a message+lock, immediately retrying once after a wait
@@ -964,34 +1085,16 @@ FileStorHandlerImpl::Stripe::next_message_impl(monitor_guard& guard, vespalib::s
     // second attempt. This is key to allowing the run loop to register
     // ticks at regular intervals while not busy-waiting.
     for (int attempt = 0; (attempt < 2) && !_owner.isPaused(); ++attempt) {
-        PriorityIdx& idx(bmi::get<1>(*_queue));
-        PriorityIdx::iterator iter(idx.begin()), end(idx.end());
         bool was_throttled = false;
-
-        while ((iter != end) && operationIsInhibited(guard, iter->_bucket, *iter->_command)) {
-            ++iter;
-        }
-        if (iter != end) {
-            const bool should_throttle_op = operation_type_should_be_throttled(iter->_command->getType().getId());
-            if (!should_throttle_op && throttle_token.valid()) {
-                throttle_token.reset(); // Let someone else play with it.
-            } else if (should_throttle_op && !throttle_token.valid()) {
-                // Important: _non-blocking_ attempt at getting a throttle token.
-                throttle_token = _owner.operation_throttler().try_acquire_one();
-                if (!throttle_token.valid()) {
-                    was_throttled = true;
-                    _metrics->throttled_persistence_thread_polls.inc();
-                }
-            }
-            if (!should_throttle_op || throttle_token.valid()) {
-                return getMessage(guard, idx, iter, std::move(throttle_token));
-            }
+        auto popped = try_pop_next_message(guard, throttle_token, was_throttled);
+        if (popped) {
+            return std::move(*popped);
         }
         if (attempt == 0) {
             // Depending on whether we were blocked due to no usable ops in queue or throttling,
             // wait for either the queue or throttler to (hopefully) have some fresh stuff for us.
             if (!was_throttled) {
-                _cond->wait_until(guard, deadline);
+                wait_for_work(guard, deadline, seen_work_generation);
             } else {
                 // Have to release lock before doing a blocking throttle token fetch, since it
                 // prevents RPC threads from pushing onto the queue.
@@ -1012,7 +1115,7 @@ FileStorHandler::LockedMessage
 FileStorHandlerImpl::Stripe::getNextMessage(vespalib::steady_time deadline)
 {
     std::unique_lock guard(*_lock);
-    return next_message_impl(guard, deadline);
+    return next_message_impl(guard, deadline, std::nullopt);
 }
 
 namespace {
@@ -1039,12 +1142,35 @@ document::GlobalId gid_from_feed_op(const api::StorageMessage& msg) {
 } // anon ns
 
 FileStorHandler::LockedMessageBatch
-FileStorHandlerImpl::Stripe::next_message_batch(vespalib::steady_time now, vespalib::steady_time deadline)
+FileStorHandlerImpl::Stripe::next_message_batch(vespalib::steady_time now, vespalib::steady_time deadline,
+                                                std::optional<uint64_t> seen_work_generation)
 {
-    const auto max_batch_size = _owner.max_feed_op_batch_size();
-
     std::unique_lock guard(*_lock);
-    auto initial_locked = next_message_impl(guard, deadline);
+    return make_batch(guard, next_message_impl(guard, deadline, seen_work_generation), now);
+}
+
+FileStorHandler::LockedMessageBatch
+FileStorHandlerImpl::Stripe::try_steal_message_batch(vespalib::steady_time now)
+{
+    std::unique_lock guard(*_lock, std::try_to_lock);
+    if (!guard.owns_lock() || _owner.isPaused()) {
+        return {};
+    }
+    ThrottleToken throttle_token;
+    bool was_throttled = false;
+    auto popped = try_pop_next_message(guard, throttle_token, was_throttled);
+    if (!popped || !popped->lock) {
+        return {};
+    }
+    _metrics->stolen_operations.inc();
+    return make_batch(guard, std::move(*popped), now);
+}
+
+FileStorHandler::LockedMessageBatch
+FileStorHandlerImpl::Stripe::make_batch(monitor_guard& guard, FileStorHandler::LockedMessage initial_locked,
+                                        vespalib::steady_time now)
+{
+    const auto max_batch_size = _owner.max_feed_op_batch_size();
     if (!initial_locked.lock || !is_batchable_feed_op(initial_locked.msg->getType().getId()) || (max_batch_size == 1)) {
         return LockedMessageBatch(std::move(initial_locked));
     }
@@ -1211,8 +1337,10 @@ FileStorHandlerImpl::Stripe::schedule(MessageEntry messageEntry)
         std::lock_guard guard(*_lock);
         _queue->emplace_back(std::move(messageEntry));
         update_cached_queue_size(guard);
+        bump_work_generation();
     }
     _cond->notify_one();
+    _owner.wake_idle_stealer(*this);
     return true;
 }
 
@@ -1222,9 +1350,12 @@ FileStorHandlerImpl::Stripe::schedule_and_get_next_async_message(MessageEntry en
     std::unique_lock guard(*_lock);
     _queue->emplace_back(std::move(entry));
     update_cached_queue_size(guard);
+    bump_work_generation();
     auto lockedMessage = get_next_async_message(guard);
     if ( ! lockedMessage.msg) {
         _cond->notify_one();
+        guard.unlock();
+        _owner.wake_idle_stealer(*this);
     }
     return lockedMessage;
 }
@@ -1298,11 +1429,17 @@ FileStorHandlerImpl::Stripe::release(const document::Bucket & bucket,
         _lockedBuckets.erase(iter); // No more locks held
     }
     bool emptySharedLocks = entry._sharedLocks.empty();
+    bump_work_generation();
+    const bool has_queued_operations = !_queue->empty();
     if (wasExclusive) {
         _cond->notify_all();
     } else if (emptySharedLocks) {
         _cond->notify_one();
     }
+    if (has_queued_operations) {
+        guard.unlock();
+        _owner.wake_idle_stealer(*this);
+    }
 }
 
 void
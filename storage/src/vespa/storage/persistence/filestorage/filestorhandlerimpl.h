@@ -137,6 +137,11 @@ public:
         void unsafe_update_cached_queue_size() {
             _cached_queue_size.store_relaxed(_queue->size());
         }
+        // Bumped whenever an operation may have become dispatchable from this stripe
+        [[nodiscard]] uint64_t work_generation() const noexcept { return _work_generation.load_relaxed(); }
+        // Number of this stripe's threads waiting for work while work stealing is enabled
+        [[nodiscard]] uint32_t idle_threads() const noexcept { return _idle_threads.load_relaxed(); }
+        void wake_idle_thread() const;
 
         void release(const document::Bucket & bucket, api::LockingRequirements reqOfReleasedLock,
                      api::StorageMessage::Id lockMsgId, bool was_active_merge);
@@ -156,7 +161,19 @@ public:
         void failOperations(const document::Bucket & bucket, const api::ReturnCode & code);
 
         [[nodiscard]] FileStorHandler::LockedMessage getNextMessage(vespalib::steady_time deadline);
-        [[nodiscard]] FileStorHandler::LockedMessageBatch next_message_batch(vespalib::steady_time now, vespalib::steady_time deadline);
+        /**
+         * If `seen_work_generation` is set, the calling thread may steal work from other stripes. It
+         * is then registered as idle while waiting, and does not wait at all if the owner's work
+         * generation has changed since it was read.
+         */
+        [[nodiscard]] FileStorHandler::LockedMessageBatch next_message_batch(vespalib::steady_time now, vespalib::steady_time deadline,
+                                                                             std::optional<uint64_t> seen_work_generation);
+        /**
+         * Non-blocking variant of next_message_batch() used by persistence threads of other stripes.
+         * Returns an empty batch if the stripe lock is contended, no operation can currently be
+         * dispatched or a throttle token is not immediately available.
+         */
+        [[nodiscard]] FileStorHandler::LockedMessageBatch try_steal_message_batch(vespalib::steady_time now);
         void dumpQueue(std::ostream & os) const;
         void dumpActiveHtml(std::ostream & os) const;
         void dumpQueueHtml(std::ostream & os) const;
@@ -172,12 +189,27 @@ public:
         void update_cached_queue_size(const std::unique_lock<std::mutex> &) {
             _cached_queue_size.store_relaxed(_queue->size());
         }
+        // Must be called with the stripe lock held
+        void bump_work_generation() noexcept {
+            _work_generation.store_relaxed(_work_generation.load_relaxed() + 1);
+        }
+        void wait_for_work(monitor_guard& held_lock, vespalib::steady_time deadline,
+                           std::optional<uint64_t> seen_work_generation);
         [[nodiscard]] bool hasActive(monitor_guard & monitor, const AbortBucketOperationsCommand& cmd) const;
         [[nodiscard]] FileStorHandler::LockedMessage get_next_async_message(monitor_guard& guard);
         [[nodiscard]] bool operation_type_should_be_throttled(api::MessageType::Id type_id) const noexcept;
 
         [[nodiscard]] FileStorHandler::LockedMessage next_message_impl(monitor_guard& held_lock,
-                                                                       vespalib::steady_time deadline);
+                                                                       vespalib::steady_time deadline,
+                                                                       std::optional<uint64_t> seen_work_generation);
+        // Makes a single non-waiting attempt at popping the highest priority operation that is not
+        // inhibited. Returns nullopt if no operation was popped. Otherwise returns the popped operation,
+        // which is empty if it had timed out in the queue (in which case `held_lock` has been released).
+        [[nodiscard]] std::optional<FileStorHandler::LockedMessage> try_pop_next_message(
+                monitor_guard& held_lock, ThrottleToken& throttle_token, bool& was_throttled);
+        [[nodiscard]] FileStorHandler::LockedMessageBatch make_batch(monitor_guard& held_lock,
+                                                                     FileStorHandler::LockedMessage initial_locked,
+                                                                     vespalib::steady_time now);
         void fill_feed_op_batch(monitor_guard& held_lock, LockedMessageBatch& batch,
                                 uint32_t max_batch_size, vespalib::steady_time now);
 
@@ -194,6 +226,8 @@ public:
         std::unique_ptr<std::condition_variable>   _cond;
         std::unique_ptr<PriorityQueue>  _queue;
         atomic_size_t                   _cached_queue_size;
+        vespalib::datastore::AtomicValueWrapper<uint64_t> _work_generation;
+        vespalib::datastore::AtomicValueWrapper<uint32_t> _idle_threads;
         LockedBuckets                   _lockedBuckets;
         uint32_t                        _active_merges;
         mutable SafeActiveOperationsStats _active_operations_stats;
@@ -307,11 +341,18 @@ public:
         return _max_feed_op_batch_size.load(std::memory_order_relaxed);
     }
 
+    void set_stripe_work_stealing(bool enabled) noexcept override {
+        _stripe_work_stealing.store(enabled, std::memory_order_relaxed);
+    }
+
     // Implements ResumeGuard::Callback
     void resume() override;
 
     // Use only for testing
     framework::MetricUpdateHook& get_metric_update_hook_for_testing() { return *this; }
+    [[nodiscard]] uint16_t stripe_index_for_testing(const document::Bucket& bucket) const noexcept {
+        return stripe_index(bucket);
+    }
 
 private:
     ServiceLayerComponent   _component;
@@ -332,6 +373,7 @@ private:
     std::atomic<bool>               _throttle_apply_bucket_diff_ops;
     std::optional<ActiveOperationsStats> _last_active_operations_stats;
     std::atomic<uint32_t>           _max_feed_op_batch_size;
+    std::atomic<bool>               _stripe_work_stealing;
 
     // Returns the index in the targets array we are sending to, or -1 if none of them match.
     int calculateTargetBasedOnDocId(const api::StorageMessage& msg, std::vector<RemapInfo*>& targets);
@@ -350,6 +392,25 @@ private:
      */
     bool isPaused() const { return _paused.load(std::memory_order_relaxed); }
 
+    [[nodiscard]] bool stripe_work_stealing() const noexcept {
+        return _stripe_work_stealing.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Tries to dispatch an operation from any stripe other than `stripe_id`, visiting stripes in
+     * round-robin order starting after it. Stripes with an empty queue are skipped without taking
+     * their lock, and stripes whose lock is contended are skipped rather than waited for.
+     */
+    LockedMessageBatch steal_message_batch(uint32_t stripe_id, vespalib::steady_time now);
+    // Sum of the work generations of all stripes
+    [[nodiscard]] uint64_t work_generation() const noexcept;
+    /**
+     * Called after `stripe_with_work` got an operation that may be dispatched. If work stealing is
+     * enabled and none of the stripe's own threads are waiting for work, wakes up one waiting
+     * thread in another stripe, looking at stripes in round-robin order starting after it.
+     */
+    void wake_idle_stealer(const Stripe& stripe_with_work) const;
+
     [[nodiscard]] bool throttle_apply_bucket_diff_ops() const noexcept {
         return _throttle_apply_bucket_diff_ops.load(std::memory_order_relaxed);
     }
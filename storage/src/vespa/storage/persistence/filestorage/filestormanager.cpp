@@ -187,7 +187,9 @@ FileStorManager::createRegisteredHandler(const ServiceLayerComponent & component
     _persistenceHandlers.push_back(
             std::make_unique<PersistenceHandler>(*_sequencedExecutor, component, _config->bucketMergeChunkSize,
                                                  false, *_provider, *_filestorHandler,
-                                                 *_bucketOwnershipNotifier, *_metrics->threads[index]));
+                                                 *_bucketOwnershipNotifier, *_metrics->threads[index],
+                                                 _config->bucketMergeMaxPendingWriteWindows,
+                                                 _config->bucketMergeWriteMemoryBudget));
     return *_persistenceHandlers.back();
 }
 
@@ -235,6 +237,7 @@ FileStorManager::on_configure(const StorFilestorConfig& config)
         _filestorHandler->reconfigure_dynamic_throttler(updated_dyn_throttle_params);
     }
     _filestorHandler->set_max_feed_op_batch_size(std::max(1, config.maxFeedOpBatchSize));
+    _filestorHandler->set_stripe_work_stealing(config.enableStripeWorkStealing);
     // TODO remove once desired throttling behavior is set in stone
     {
         _filestorHandler->use_dynamic_operation_throttling(use_dynamic_throttling);
@@ -172,6 +172,8 @@ FileStorThreadMetrics::FileStorThreadMetrics(const std::string& name, const std:
       applyBucketDiff("applybucketdiff", "Number of applybucketdiff commands that have been processed.", this),
       getBucketDiffReply("getbucketdiffreply", {}, "Number of getbucketdiff replies that have been processed.", this),
       applyBucketDiffReply("applybucketdiffreply", {}, "Number of applybucketdiff replies that have been processed.", this),
+      feed_batch_size("feed_batch_size", {}, "Number of put, update and remove operations handed to the "
+                                             "persistence provider per feed batch.", this),
       merge_handler_metrics(this)
 { }
 
@@ -188,7 +190,10 @@ FileStorStripeMetrics::FileStorStripeMetrics(const std::string& name, const std:
                                          "queued async operation because it was disallowed by the throttle policy", this),
       timeouts_waiting_for_throttle_token("timeouts_waiting_for_throttle_token", {},
                                           "Number of times a persistence thread timed out waiting for an available "
-                                          "throttle policy token", this)
+                                          "throttle policy token", this),
+      stolen_operations("stolen_operations", {},
+                        "Number of operations in this stripe's queue that were dispatched by a persistence "
+                        "thread belonging to another stripe", this)
 {
 }
 
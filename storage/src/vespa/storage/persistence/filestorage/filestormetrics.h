@@ -107,6 +107,7 @@ struct FileStorThreadMetrics : public metrics::MetricSet
     Op applyBucketDiff;
     metrics::LongCountMetric getBucketDiffReply;
     metrics::LongCountMetric applyBucketDiffReply;
+    metrics::LongAverageMetric feed_batch_size;
     MergeHandlerMetrics merge_handler_metrics;
 
     FileStorThreadMetrics(const std::string& name, const std::string& desc);
@@ -121,6 +122,7 @@ public:
     metrics::LongCountMetric throttled_rpc_direct_dispatches;
     metrics::LongCountMetric throttled_persistence_thread_polls;
     metrics::LongCountMetric timeouts_waiting_for_throttle_token;
+    metrics::LongCountMetric stolen_operations;
     FileStorStripeMetrics(const std::string& name, const std::string& description);
     ~FileStorStripeMetrics() override;
 };
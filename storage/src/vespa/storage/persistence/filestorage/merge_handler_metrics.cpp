@@ -20,6 +20,12 @@ MergeHandlerMetrics::MergeHandlerMetrics(metrics::MetricSet* owner)
                             "current node.", owner),
       mergeAverageDataReceivedNeeded("mergeavgdatareceivedneeded", {}, "Amount of data transferred from previous node "
                                                                        "in chain that we needed to apply locally.", owner),
+      merge_throughput("merge_throughput", {}, "Bytes per second moved by completed merges coordinated by this node, "
+                                               "counting data sent into the merge chain and data applied locally.", owner),
+      merge_pending_write_bytes("merge_pending_write_bytes", {}, "Bytes of local merge writes still in flight when "
+                                                                 "a new merge round is started.", owner),
+      merge_pending_write_windows("merge_pending_write_windows", {}, "Number of earlier merge rounds with local writes still "
+                                                                     "in flight when a new merge round is started.", owner),
       merge_put_latency("merge_put_latency", {}, "Latency of individual puts that are part of merge operations", owner),
       merge_remove_latency("merge_remove_latency", {}, "Latency of individual removes that are part of merge operations", owner)
 {}
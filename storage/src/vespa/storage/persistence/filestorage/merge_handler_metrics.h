@@ -19,6 +19,11 @@ struct MergeHandlerMetrics {
     metrics::DoubleAverageMetric mergeDataReadLatency;
     metrics::DoubleAverageMetric mergeDataWriteLatency;
     metrics::DoubleAverageMetric mergeAverageDataReceivedNeeded;
+    metrics::DoubleAverageMetric merge_throughput;
+    // Sampled each time a merge round is started while local writes from
+    // earlier rounds of the same merge are still in flight.
+    metrics::LongAverageMetric merge_pending_write_bytes;
+    metrics::LongAverageMetric merge_pending_write_windows;
     // Individual operation metrics. These capture both count and latency sum, so
     // no need for explicit count metric on the side.
     metrics::DoubleAverageMetric merge_put_latency;
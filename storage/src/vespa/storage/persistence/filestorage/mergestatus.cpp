@@ -2,6 +2,7 @@
 
 #include "mergestatus.h"
 #include "has_mask_remapper.h"
+#include <algorithm>
 #include <ostream>
 #include <vespa/log/log.h>
 
@@ -15,11 +16,39 @@ MergeStatus::MergeStatus(const framework::Clock& clock,
     : reply(), full_node_list(), nodeList(), maxTimestamp(0), diff(), pendingId(0),
       pendingGetDiff(), pendingApplyDiff(), timeout(0), startTime(clock),
       delayed_error(),
+      pending_write_windows(),
+      pending_write_bytes(0),
+      bytes_moved(0),
       context(priority, traceLevel)
 {}
 
 MergeStatus::~MergeStatus() = default;
 
+MergeStatus::PendingWriteWindow::PendingWriteWindow(std::future<std::string> done_in,
+                                                    std::vector<uint64_t> timestamps_in,
+                                                    uint64_t bytes_in)
+    : done(std::move(done_in)),
+      timestamps(std::move(timestamps_in)),
+      bytes(bytes_in)
+{}
+
+MergeStatus::PendingWriteWindow::PendingWriteWindow(PendingWriteWindow&&) noexcept = default;
+MergeStatus::PendingWriteWindow::~PendingWriteWindow() = default;
+
+bool
+MergeStatus::PendingWriteWindow::overlaps(const std::vector<api::ApplyBucketDiffCommand::Entry>& part,
+                                          uint16_t node_mask) const
+{
+    for (const auto& e : part) {
+        if ((e._entry._hasMask & node_mask) != 0 &&
+            std::binary_search(timestamps.begin(), timestamps.end(), e._entry._timestamp))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 /*
  * Note: hasMask parameter and _entry._hasMask in part vector are per-reply masks,
  *       based on the nodes returned in the ApplyBucketDiffReply.
@@ -144,4 +173,37 @@ MergeStatus::check_delayed_error(api::ReturnCode &return_code)
     }
 }
 
+void
+MergeStatus::add_pending_write_window(PendingWriteWindow window)
+{
+    pending_write_bytes += window.bytes;
+    pending_write_windows.emplace_back(std::move(window));
+}
+
+std::string
+MergeStatus::wait_oldest_pending_write_window()
+{
+    auto& window = pending_write_windows.front();
+    window.done.wait();
+    std::string fail_message = window.done.get();
+    pending_write_bytes -= window.bytes;
+    pending_write_windows.pop_front();
+    return fail_message;
+}
+
+std::string
+MergeStatus::retire_completed_write_windows()
+{
+    std::string fail_message;
+    while (!pending_write_windows.empty() &&
+           pending_write_windows.front().done.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        auto window_fail_message = wait_oldest_pending_write_window();
+        if (fail_message.empty()) {
+            fail_message = std::move(window_fail_message);
+        }
+    }
+    return fail_message;
+}
+
 };
@@ -18,6 +18,21 @@ namespace storage {
 
 class MergeStatus : public document::Printable {
 public:
+    /*
+     * Local writes from an earlier merge round that are still in flight while
+     * later rounds are being processed. Only used by the node coordinating the merge.
+     */
+    struct PendingWriteWindow {
+        std::future<std::string> done;
+        std::vector<uint64_t>    timestamps; // sorted ascending
+        uint64_t                 bytes;
+
+        PendingWriteWindow(std::future<std::string> done_in, std::vector<uint64_t> timestamps_in, uint64_t bytes_in);
+        PendingWriteWindow(PendingWriteWindow&&) noexcept;
+        ~PendingWriteWindow();
+        bool overlaps(const std::vector<api::ApplyBucketDiffCommand::Entry>& diff, uint16_t node_mask) const;
+    };
+
     std::shared_ptr<api::StorageReply> reply;
     std::vector<api::MergeBucketCommand::Node> full_node_list;
     std::vector<api::MergeBucketCommand::Node> nodeList;
@@ -29,6 +44,9 @@ public:
     vespalib::duration timeout;
     framework::MilliSecTimer startTime;
     std::optional<std::future<std::string>> delayed_error;
+    std::deque<PendingWriteWindow> pending_write_windows;
+    uint64_t pending_write_bytes;
+    uint64_t bytes_moved;
     spi::Context context;
  	
     MergeStatus(const framework::Clock&, api::StorageMessage::Priority, uint32_t traceLevel);
@@ -46,6 +64,14 @@ public:
     bool isFirstNode() const { return static_cast<bool>(reply); }
     void set_delayed_error(std::future<std::string>&& delayed_error_in);
     void check_delayed_error(api::ReturnCode &return_code);
+    void add_pending_write_window(PendingWriteWindow window);
+    /**
+     * Waits for the oldest pending write window to complete.
+     * @return the failure message of the window, empty on success.
+     */
+    std::string wait_oldest_pending_write_window();
+    /** Removes completed windows from the front of the queue, returning the first failure (if any). */
+    std::string retire_completed_write_windows();
 };
 
 } // storage
@@ -28,13 +28,17 @@ namespace storage {
 MergeHandler::MergeHandler(PersistenceUtil& env, spi::PersistenceProvider& spi,
                            const ClusterContext& cluster_context, const framework::Clock & clock,
                            vespalib::ISequencedTaskExecutor& executor,
-                           uint32_t maxChunkSize)
+                           uint32_t maxChunkSize,
+                           uint32_t max_pending_write_windows,
+                           uint64_t pending_write_memory_budget)
     : _clock(clock),
       _cluster_context(cluster_context),
       _env(env),
       _spi(spi),
       _monitored_ref_count(std::make_unique<MonitoredRefCount>()),
       _maxChunkSize(maxChunkSize),
+      _max_pending_write_windows(max_pending_write_windows),
+      _pending_write_memory_budget(pending_write_memory_budget),
       _executor(executor)
 {
 }
@@ -101,6 +105,24 @@ void check_apply_diff_sync(std::shared_ptr<ApplyBucketDiffState> async_results)
     }
 }
 
+// Wait for all pending local write windows of a completed merge, folding any failure into return_code.
+void drain_pending_writes(MergeStatus& status, api::ReturnCode& return_code) {
+    while (!status.pending_write_windows.empty()) {
+        auto fail_message = status.wait_oldest_pending_write_window();
+        if (!fail_message.empty() && !return_code.failed()) {
+            return_code = api::ReturnCode(api::ReturnCode::INTERNAL_FAILURE, std::move(fail_message));
+        }
+    }
+}
+
+uint64_t filled_data_size(const std::vector<api::ApplyBucketDiffCommand::Entry>& diff) {
+    uint64_t size = 0;
+    for (const auto& e : diff) {
+        size += e._headerBlob.size() + e._bodyBlob.size();
+    }
+    return size;
+}
+
 FileStorThreadMetrics::Op *get_op_metrics(FileStorThreadMetrics& metrics, const api::StorageReply &reply) {
     switch (reply.getType().getId()) {
     case api::MessageType::MERGEBUCKET_REPLY_ID:
@@ -520,6 +542,7 @@ MergeHandler::applyDiffEntry(std::shared_ptr<ApplyBucketDiffState> async_results
         }
     }
     auto throttle_token = _env._fileStorHandler.operation_throttler().blocking_acquire_one();
+    async_results->add_pending_write(e._entry._timestamp, e._headerBlob.size() + e._bodyBlob.size());
     spi::Timestamp timestamp(e._entry._timestamp);
     if (!(e._entry._flags & (DELETED | DELETED_IN_PLACE))) {
         // Regular put entry
@@ -830,13 +853,21 @@ MergeHandler::processBucketMerge(const spi::Bucket& bucket, MergeStatus& status,
     cmd->setPriority(status.context.getPriority());
     cmd->setTimeout(status.timeout);
     if (async_results) {
-        // Check currently pending writes to local node before sending new command.
-        check_apply_diff_sync(std::move(async_results));
+        if (_max_pending_write_windows > 0) {
+            defer_local_writes(status, std::move(async_results));
+        } else {
+            // Check currently pending writes to local node before sending new command.
+            check_apply_diff_sync(std::move(async_results));
+        }
+    }
+    if (!status.pending_write_windows.empty()) {
+        throttle_pending_writes(status, cmd->getDiff());
     }
     if (applyDiffNeedLocalData(cmd->getDiff(), 0, true)) {
         framework::MilliSecTimer startTime(_clock);
         fetchLocalData(bucket, cmd->getDiff(), 0, context);
         _env._metrics.merge_handler_metrics.mergeDataReadLatency.addValue(startTime.getElapsedTimeAsDouble());
+        status.bytes_moved += filled_data_size(cmd->getDiff());
     }
     status.pendingId = cmd->getMsgId();
     LOG(debug, "Sending %s", cmd->toString().c_str());
@@ -844,6 +875,47 @@ MergeHandler::processBucketMerge(const spi::Bucket& bucket, MergeStatus& status,
     return {};
 }
 
+void
+MergeHandler::defer_local_writes(MergeStatus& status, std::shared_ptr<ApplyBucketDiffState> async_results) const
+{
+    auto timestamps = async_results->pending_write_timestamps();
+    uint64_t bytes = async_results->pending_write_bytes();
+    auto done = async_results->get_future();
+    async_results.reset();
+    status.add_pending_write_window(MergeStatus::PendingWriteWindow(std::move(done), std::move(timestamps), bytes));
+}
+
+void
+MergeHandler::throttle_pending_writes(MergeStatus& status,
+                                      const std::vector<api::ApplyBucketDiffCommand::Entry>& next_diff) const
+{
+    auto fail_message = status.retire_completed_write_windows();
+    // Entries written locally in an earlier round may have to be read back to fill the next
+    // round's diff, so wait for every window up to and including the last one overlapping it.
+    size_t must_wait = 0;
+    for (size_t i = 0; i < status.pending_write_windows.size(); ++i) {
+        if (status.pending_write_windows[i].overlaps(next_diff, 1u)) {
+            must_wait = i + 1;
+        }
+    }
+    while (fail_message.empty() && !status.pending_write_windows.empty() &&
+           ((must_wait > 0) ||
+            (status.pending_write_windows.size() > _max_pending_write_windows) ||
+            (status.pending_write_bytes > _pending_write_memory_budget)))
+    {
+        fail_message = status.wait_oldest_pending_write_window();
+        if (must_wait > 0) {
+            --must_wait;
+        }
+    }
+    if (!fail_message.empty()) {
+        throw std::runtime_error(fail_message);
+    }
+    auto& metrics = _env._metrics.merge_handler_metrics;
+    metrics.merge_pending_write_windows.addValue(status.pending_write_windows.size());
+    metrics.merge_pending_write_bytes.addValue(status.pending_write_bytes);
+}
+
 /** Ensures merge states are deleted if we fail operation */
 class MergeStateDeleter {
 public:
@@ -1368,6 +1440,13 @@ MergeHandler::handleApplyBucketDiffReply(api::ApplyBucketDiffReply& reply, Messa
     api::ReturnCode returnCode = reply.getResult();
     // Check for delayed error from handleApplyBucketDiff
     s->check_delayed_error(returnCode);
+    if (s->isFirstNode() && !returnCode.failed()) {
+        // Check for errors in local writes from earlier rounds of this merge
+        auto fail_message = s->retire_completed_write_windows();
+        if (!fail_message.empty()) {
+            returnCode = api::ReturnCode(api::ReturnCode::INTERNAL_FAILURE, std::move(fail_message));
+        }
+    }
     try {
         if (reply.getResult().failed()) {
             LOG(debug, "Got failed apply bucket diff reply %s", reply.toString().c_str());
@@ -1382,6 +1461,9 @@ MergeHandler::handleApplyBucketDiffReply(api::ApplyBucketDiffReply& reply, Messa
             if (applyDiffHasLocallyNeededData(diff, index)) {
                 async_results = ApplyBucketDiffState::create(*this, _env._metrics.merge_handler_metrics, _clock, bucket, RetainGuard(*_monitored_ref_count));
                 applyDiffLocally(bucket, diff, index, s->context, async_results);
+                if (s->isFirstNode()) {
+                    s->bytes_moved += async_results->pending_write_bytes();
+                }
             } else {
                 LOG(spam, "Merge(%s): Didn't need fetched data on node %u (%u)",
                     bucket.toString().c_str(),
@@ -1417,8 +1499,10 @@ MergeHandler::handleApplyBucketDiffReply(api::ApplyBucketDiffReply& reply, Messa
             }
 
             if (returnCode.failed()) {
-                // Should reply now, since we failed.
+                // Should reply now, since we failed. Local writes from earlier rounds must still
+                // be done before the merge state is cleared.
                 replyToSend = s->reply;
+                drain_pending_writes(*s, returnCode);
             } else {
                 replyToSend = processBucketMerge(bucket, *s, sender, s->context, async_results);
 
@@ -1426,6 +1510,12 @@ MergeHandler::handleApplyBucketDiffReply(api::ApplyBucketDiffReply& reply, Messa
                     // We have sent something on and shouldn't reply now.
                     clearState = false;
                 } else {
+                    // Local writes from all earlier rounds must be done before the merge is reported complete.
+                    drain_pending_writes(*s, returnCode);
+                    double elapsed = vespalib::to_s(s->startTime.getElapsedTime());
+                    if (elapsed > 0.0) {
+                        _env._metrics.merge_handler_metrics.merge_throughput.addValue(s->bytes_moved / elapsed);
+                    }
                     if (async_results) {
                         async_results->set_merge_start_time(s->startTime);
                     } else {
@@ -1440,9 +1530,9 @@ MergeHandler::handleApplyBucketDiffReply(api::ApplyBucketDiffReply& reply, Messa
             s->pendingApplyDiff->getDiff().swap(reply.getDiff());
         }
     } catch (std::exception& e) {
-        _env._fileStorHandler.clearMergeStatus(
-                bucket.getBucket(),
-                api::ReturnCode(api::ReturnCode::INTERNAL_FAILURE, e.what()));
+        api::ReturnCode failure(api::ReturnCode::INTERNAL_FAILURE, e.what());
+        drain_pending_writes(*s, failure);
+        _env._fileStorHandler.clearMergeStatus(bucket.getBucket(), failure);
         throw;
     }
 
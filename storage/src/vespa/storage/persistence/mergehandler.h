@@ -54,7 +54,9 @@ public:
     MergeHandler(PersistenceUtil& env, spi::PersistenceProvider& spi,
                  const ClusterContext& cluster_context, const framework::Clock & clock,
                  vespalib::ISequencedTaskExecutor& executor,
-                 uint32_t maxChunkSize = 4190208);
+                 uint32_t maxChunkSize = 4190208,
+                 uint32_t max_pending_write_windows = 0,
+                 uint64_t pending_write_memory_budget = 67108864);
 
     ~MergeHandler() override;
 
@@ -94,6 +96,8 @@ private:
     spi::PersistenceProvider &_spi;
     std::unique_ptr<vespalib::MonitoredRefCount> _monitored_ref_count;
     const uint32_t            _maxChunkSize;
+    const uint32_t            _max_pending_write_windows;
+    const uint64_t            _pending_write_memory_budget;
     vespalib::ISequencedTaskExecutor& _executor;
 
     MessageTrackerUP handleGetBucketDiffStage2(api::GetBucketDiffCommand&, MessageTrackerUP) const;
@@ -101,6 +105,18 @@ private:
     api::StorageReply::SP processBucketMerge(const spi::Bucket& bucket, MergeStatus& status, MessageSender& sender,
                                              spi::Context& context, std::shared_ptr<ApplyBucketDiffState>& async_results) const;
 
+    /**
+     * Keep the local writes of the last merge round in flight while the next round
+     * is sent through the chain, instead of waiting for them to complete.
+     */
+    void defer_local_writes(MergeStatus& status, std::shared_ptr<ApplyBucketDiffState> async_results) const;
+    /**
+     * Wait for pending local write windows of a merge until the window count and
+     * memory budget are respected, and until no pending write is for an entry the
+     * next round must read locally. Throws std::runtime_error if a write failed.
+     */
+    void throttle_pending_writes(MergeStatus& status, const std::vector<api::ApplyBucketDiffCommand::Entry>& next_diff) const;
+
     /**
      * Invoke either put, remove or unrevertable remove on the SPI
      * depending on the flags in the diff entry.
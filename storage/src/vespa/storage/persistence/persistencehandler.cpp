@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "persistencehandler.h"
+#include "feed_operation_batch.h"
 
 #include <vespa/log/log.h>
 LOG_SETUP(".persistence.persistencehandler");
@@ -16,11 +17,15 @@ PersistenceHandler::PersistenceHandler(vespalib::ISequencedTaskExecutor & sequen
                                       spi::PersistenceProvider& provider,
                                       FileStorHandler& filestorHandler,
                                       BucketOwnershipNotifier & bucketOwnershipNotifier,
-                                      FileStorThreadMetrics& metrics)
+                                      FileStorThreadMetrics& metrics,
+                                      uint32_t maxPendingMergeWriteWindows,
+                                      uint64_t mergeWriteMemoryBudget)
     : _clock(component.getClock()),
+      _spi(provider),
       _env(component, filestorHandler, metrics, provider),
       _processAllHandler(_env, provider),
-      _mergeHandler(_env, provider, component.cluster_context(), _clock, sequencedExecutor, bucketMergeChunkSize),
+      _mergeHandler(_env, provider, component.cluster_context(), _clock, sequencedExecutor, bucketMergeChunkSize,
+                    maxPendingMergeWriteWindows, mergeWriteMemoryBudget),
       _asyncHandler(_env, provider, bucketOwnershipNotifier, sequencedExecutor, component.getBucketIdFactory()),
       _splitJoinHandler(_env, provider, bucketOwnershipNotifier, multibitSplit),
       _simpleHandler(_env, provider, component.getBucketIdFactory())
@@ -49,7 +54,8 @@ public:
 };
 
 MessageTracker::UP
-PersistenceHandler::handleCommandSplitByType(api::StorageCommand& msg, MessageTracker::UP tracker) const
+PersistenceHandler::handleCommandSplitByType(api::StorageCommand& msg, MessageTracker::UP tracker,
+                                             FeedOperationBatch* feed_batch) const
 {
     OperationSyncPhaseTrackingGuard sync_guard(*tracker);
     switch (msg.getType().getId()) {
@@ -59,11 +65,11 @@ PersistenceHandler::handleCommandSplitByType(api::StorageCommand& msg, MessageTr
         return _simpleHandler.handleGet(static_cast<api::GetCommand&>(msg), std::move(tracker));
     }
     case api::MessageType::PUT_ID:
-        return _asyncHandler.handlePut(static_cast<api::PutCommand&>(msg), std::move(tracker));
+        return _asyncHandler.handlePut(static_cast<api::PutCommand&>(msg), std::move(tracker), feed_batch);
     case api::MessageType::REMOVE_ID:
-        return _asyncHandler.handleRemove(static_cast<api::RemoveCommand&>(msg), std::move(tracker));
+        return _asyncHandler.handleRemove(static_cast<api::RemoveCommand&>(msg), std::move(tracker), feed_batch);
     case api::MessageType::UPDATE_ID:
-        return _asyncHandler.handleUpdate(static_cast<api::UpdateCommand&>(msg), std::move(tracker));
+        return _asyncHandler.handleUpdate(static_cast<api::UpdateCommand&>(msg), std::move(tracker), feed_batch);
     case api::MessageType::CREATEBUCKET_ID:
         return _asyncHandler.handleCreateBucket(static_cast<api::CreateBucketCommand&>(msg), std::move(tracker));
     case api::MessageType::DELETEBUCKET_ID:
@@ -128,7 +134,8 @@ PersistenceHandler::handleReply(api::StorageReply& reply, MessageTracker::UP tra
 }
 
 MessageTracker::UP
-PersistenceHandler::processMessage(api::StorageMessage& msg, MessageTracker::UP tracker) const
+PersistenceHandler::processMessage(api::StorageMessage& msg, MessageTracker::UP tracker,
+                                   FeedOperationBatch* feed_batch) const
 {
     MBUS_TRACE(msg.getTrace(), 5, "PersistenceHandler: Processing message in persistence layer");
 
@@ -147,7 +154,7 @@ PersistenceHandler::processMessage(api::StorageMessage& msg, MessageTracker::UP
         try {
             LOG(debug, "Handling command: %s", msg.toString().c_str());
             LOG(spam, "Message content: %s", msg.toString(true).c_str());
-            return handleCommandSplitByType(initiatingCommand, std::move(tracker));
+            return handleCommandSplitByType(initiatingCommand, std::move(tracker), feed_batch);
         } catch (std::exception& e) {
             LOG(debug, "Caught exception for %s: %s", msg.toString().c_str(), e.what());
             api::StorageReply::SP reply(initiatingCommand.makeReply());
@@ -178,6 +185,9 @@ PersistenceHandler::process_locked_message_batch(std::shared_ptr<FileStorHandler
 {
     const auto bucket = lock->getBucket();
     auto batch = std::make_shared<AsyncMessageBatch>(std::move(lock), _env, _env._fileStorHandler);
+    // Feed operations in the batch are handed to the provider as a single feed batch once all
+    // messages have been processed. FileStorHandler only batches operations towards distinct documents.
+    FeedOperationBatch feed_batch(_spi, spi::Bucket(bucket));
     for (auto& bm : bucket_messages) {
         assert(bm.first->getBucket() == bucket);
         // Important: we _copy_ the message shared_ptr instead of moving to ensure that `*bm.first` remains
@@ -185,11 +195,15 @@ PersistenceHandler::process_locked_message_batch(std::shared_ptr<FileStorHandler
         // are caught there, so we do not expect our loop to be interrupted.
         auto tracker = std::make_unique<MessageTracker>(framework::MilliSecTimer(_clock), _env, batch,
                                                         batch->deferred_sender_stub(), bm.first, std::move(bm.second));
-        tracker = processMessage(*bm.first, std::move(tracker));
+        tracker = processMessage(*bm.first, std::move(tracker), &feed_batch);
         if (tracker) {
             tracker->sendReply(); // Actually defers to batch reply queue
         }
     }
+    if (!feed_batch.empty()) {
+        _env._metrics.feed_batch_size.addValue(feed_batch.size());
+        feed_batch.flush();
+    }
 }
 
 }
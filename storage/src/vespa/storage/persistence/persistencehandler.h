@@ -16,6 +16,7 @@
 namespace storage {
 
 class BucketOwnershipNotifier;
+class FeedOperationBatch;
 
 /**
  * Handle all messages destined for the persistence layer. The detailed handling
@@ -27,7 +28,8 @@ class PersistenceHandler : public Types
 public:
     PersistenceHandler(vespalib::ISequencedTaskExecutor &, const ServiceLayerComponent & component,
                       uint32_t mergeChunkSize, bool multibitSplit, spi::PersistenceProvider &,
-                      FileStorHandler &, BucketOwnershipNotifier &, FileStorThreadMetrics&);
+                      FileStorHandler &, BucketOwnershipNotifier &, FileStorThreadMetrics&,
+                      uint32_t maxPendingMergeWriteWindows = 0, uint64_t mergeWriteMemoryBudget = 67108864);
     ~PersistenceHandler();
 
     void processLockedMessage(FileStorHandler::LockedMessage lock) const;
@@ -40,12 +42,15 @@ public:
     const SimpleMessageHandler & simpleMessageHandler() const { return _simpleHandler; }
 private:
     // Message handling functions
-    MessageTracker::UP handleCommandSplitByType(api::StorageCommand&, MessageTracker::UP tracker) const;
+    MessageTracker::UP handleCommandSplitByType(api::StorageCommand&, MessageTracker::UP tracker,
+                                                FeedOperationBatch* feed_batch) const;
     MessageTracker::UP handleReply(api::StorageReply&, MessageTracker::UP) const;
 
-    MessageTracker::UP processMessage(api::StorageMessage& msg, MessageTracker::UP tracker) const;
+    MessageTracker::UP processMessage(api::StorageMessage& msg, MessageTracker::UP tracker,
+                                      FeedOperationBatch* feed_batch = nullptr) const;
 
     const framework::Clock  & _clock;
+    spi::PersistenceProvider& _spi;
     PersistenceUtil           _env;
     ProcessAllHandler         _processAllHandler;
     MergeHandler              _mergeHandler;
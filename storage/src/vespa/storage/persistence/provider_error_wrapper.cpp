@@ -189,6 +189,15 @@ ProviderErrorWrapper::updateAsync(const spi::Bucket &bucket, spi::Timestamp ts,
     _impl.updateAsync(bucket, ts, std::move(upd), std::move(onComplete));
 }
 
+void
+ProviderErrorWrapper::feedBatchAsync(const spi::Bucket &bucket, std::vector<spi::FeedOperation> ops)
+{
+    for (auto& op : ops) {
+        op.on_complete().addResultHandler(this);
+    }
+    _impl.feedBatchAsync(bucket, std::move(ops));
+}
+
 std::unique_ptr<vespalib::IDestructorCallback>
 ProviderErrorWrapper::register_executor(std::shared_ptr<spi::BucketExecutor> executor)
 {
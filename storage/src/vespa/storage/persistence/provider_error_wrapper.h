@@ -60,6 +60,7 @@ public:
     void removeByGidAsync(const spi::Bucket&, std::vector<spi::DocTypeGidAndTimestamp>, std::unique_ptr<spi::OperationComplete>) override;
     void removeIfFoundAsync(const spi::Bucket&, spi::Timestamp, const document::DocumentId&, spi::OperationComplete::UP) override;
     void updateAsync(const spi::Bucket &, spi::Timestamp, spi::DocumentUpdateSP, spi::OperationComplete::UP) override;
+    void feedBatchAsync(const spi::Bucket&, std::vector<spi::FeedOperation>) override;
     void setActiveStateAsync(const spi::Bucket& b, spi::BucketInfo::ActiveState newState, spi::OperationComplete::UP onComplete) override;
     void createBucketAsync(const spi::Bucket&, spi::OperationComplete::UP) noexcept override;
     void deleteBucketAsync(const spi::Bucket&, spi::OperationComplete::UP) noexcept override;
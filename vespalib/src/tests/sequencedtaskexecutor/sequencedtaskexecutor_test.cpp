@@ -266,6 +266,21 @@ TEST(SequencedTaskExecutorTest, require_that_executeLambda_works)
     EXPECT_EQ(5, i);
 }
 
+TEST(SequencedTaskExecutorTest, require_that_scheduled_tasks_are_counted_per_executor_id)
+{
+    Fixture f;
+    ISequencedTaskExecutor::ExecutorId id0(0);
+    ISequencedTaskExecutor::ExecutorId id1(1);
+    f._threads->executeLambda(id0, []() noexcept { });
+    f._threads->executeLambda(id0, []() noexcept { });
+    ISequencedTaskExecutor::TaskList list;
+    list.emplace_back(id1, makeLambdaTask([]() noexcept { }));
+    f._threads->executeTasks(std::move(list));
+    f._threads->sync_all();
+    EXPECT_EQ(2u, f._threads->get_num_scheduled_tasks(id0));
+    EXPECT_EQ(1u, f._threads->get_num_scheduled_tasks(id1));
+}
+
 TEST(SequencedTaskExecutorTest, require_that_you_get_correct_number_of_executors) {
     auto seven = SequencedTaskExecutor::create(sequenced_executor, 7);
     EXPECT_EQ(7u, seven->getNumExecutors());
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/traits.h>
+#include <set>
 
 using namespace vespalib;
 
@@ -330,6 +331,65 @@ TEST("require that a stash only retains a single chunk when cleared") {
     EXPECT_EQUAL(sum({chunk_header_size()}), stash.count_used());    
 }
 
+TEST("require that a stash retains all chunks when reset") {
+    size_t destructed = 0;
+    Stash stash;
+    stash.create<Small>(destructed);
+    for (size_t i = 0; i < 100; ++i) {
+        stash.alloc(512);
+    }
+    auto usage = stash.get_memory_usage();
+    EXPECT_TRUE(usage.allocatedBytes() > 10 * stash.get_chunk_size());
+    EXPECT_FALSE(destructed);
+    stash.reset();
+    EXPECT_TRUE(destructed);
+    EXPECT_EQUAL(0u, stash.count_used());
+    EXPECT_EQUAL(usage.allocatedBytes(), stash.get_memory_usage().allocatedBytes());
+    EXPECT_EQUAL(0u, stash.get_memory_usage().usedBytes());
+}
+
+TEST("require that chunks retained by reset are reused") {
+    Stash stash;
+    std::vector<char *> first;
+    for (size_t i = 0; i < 100; ++i) {
+        first.push_back(stash.alloc(512));
+    }
+    size_t used = stash.count_used();
+    size_t allocated = stash.get_memory_usage().allocatedBytes();
+    stash.reset();
+    std::set<char *> chunk_memory(first.begin(), first.end());
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(chunk_memory.contains(stash.alloc(512)));
+    }
+    EXPECT_EQUAL(used, stash.count_used());
+    EXPECT_EQUAL(allocated, stash.get_memory_usage().allocatedBytes());
+    stash.clear();
+    EXPECT_EQUAL(sum({chunk_header_size()}), stash.count_used());
+    EXPECT_EQUAL(stash.get_chunk_size(), stash.get_memory_usage().allocatedBytes());
+}
+
+TEST("require that reset frees chunks not used since the previous reset") {
+    Stash stash;
+    for (size_t i = 0; i < 100; ++i) {
+        stash.alloc(512);
+    }
+    size_t allocated = stash.get_memory_usage().allocatedBytes();
+    stash.reset();
+    for (size_t i = 0; i < 10; ++i) {
+        stash.alloc(512);
+    }
+    size_t used = stash.count_used();
+    EXPECT_EQUAL(allocated, stash.get_memory_usage().allocatedBytes());
+    stash.reset();
+    size_t retained = stash.get_memory_usage().allocatedBytes();
+    EXPECT_TRUE(retained < allocated);
+    EXPECT_TRUE(retained >= used);
+    for (size_t i = 0; i < 10; ++i) {
+        stash.alloc(512);
+    }
+    EXPECT_EQUAL(retained, stash.get_memory_usage().allocatedBytes());
+}
+
 TEST("require that array constructor parameters are passed correctly") {
     Stash stash;
     {
@@ -0,0 +1,94 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/generationhandler.h>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using vespalib::GenerationHandler;
+
+/*
+ * Measures the cost of taking generation guards when many reader
+ * threads take guards on the same set of generation handlers (like
+ * match threads taking guards on many attributes per query), while a
+ * writer thread keeps increasing the generation.
+ *
+ * usage: generation_handler_contention_benchmark [max_threads] [num_handlers] [seconds] [reader_shards]
+ */
+
+namespace {
+
+struct Result {
+    double guards_per_second;
+    uint64_t write_cnt;
+};
+
+Result
+run(uint32_t num_threads, uint32_t num_handlers, uint32_t num_reader_shards, double seconds)
+{
+    std::vector<std::unique_ptr<GenerationHandler>> handlers;
+    for (uint32_t i = 0; i < num_handlers; ++i) {
+        handlers.emplace_back(std::make_unique<GenerationHandler>(num_reader_shards));
+    }
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> read_cnt(0);
+    uint64_t write_cnt = 0;
+    std::vector<std::thread> readers;
+    for (uint32_t t = 0; t < num_threads; ++t) {
+        readers.emplace_back([&]() {
+            uint64_t cnt = 0;
+            std::vector<GenerationHandler::Guard> guards(handlers.size());
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (size_t i = 0; i < handlers.size(); ++i) {
+                    guards[i] = handlers[i]->takeGuard();
+                }
+                for (auto& guard : guards) {
+                    guard = GenerationHandler::Guard();
+                }
+                cnt += handlers.size();
+            }
+            read_cnt += cnt;
+        });
+    }
+    std::thread writer([&]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            for (auto& handler : handlers) {
+                handler->incGeneration();
+            }
+            ++write_cnt;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    writer.join();
+    return {read_cnt.load() / seconds, write_cnt};
+}
+
+}
+
+int main(int argc, char **argv) {
+    uint32_t max_threads = (argc > 1) ? atoi(argv[1]) : std::max(std::thread::hardware_concurrency(), 1u);
+    uint32_t num_handlers = (argc > 2) ? atoi(argv[2]) : 32;
+    double seconds = (argc > 3) ? atof(argv[3]) : 1.0;
+    uint32_t sharded = (argc > 4) ? atoi(argv[4]) : GenerationHandler::default_num_reader_shards();
+    fprintf(stderr, "%u handlers, %u reader shards when sharded, %g seconds per run\n",
+            num_handlers, sharded, seconds);
+    for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+        auto plain = run(threads, num_handlers, 1, seconds);
+        auto sharded_result = run(threads, num_handlers, sharded, seconds);
+        fprintf(stderr, "%3u threads: plain %8.2f M guards/s (%" PRIu64 " writes), sharded %8.2f M guards/s (%" PRIu64 " writes), speedup: %6.3f\n",
+                threads, plain.guards_per_second / 1e6, plain.write_cnt,
+                sharded_result.guards_per_second / 1e6, sharded_result.write_cnt,
+                sharded_result.guards_per_second / plain.guards_per_second);
+    }
+    return 0;
+}
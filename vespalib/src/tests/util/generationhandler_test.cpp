@@ -3,12 +3,14 @@
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <deque>
+#include <thread>
+#include <vector>
 
 namespace vespalib {
 
 using GenGuard = GenerationHandler::Guard;
 
-class GenerationHandlerTest : public ::testing::Test {
+class GenerationHandlerTest : public ::testing::TestWithParam<uint32_t> {
 protected:
     GenerationHandler gh;
     GenerationHandlerTest();
@@ -16,14 +18,16 @@ protected:
 };
 
 GenerationHandlerTest::GenerationHandlerTest()
-    : ::testing::Test(),
-      gh()
+    : ::testing::TestWithParam<uint32_t>(),
+      gh(GetParam())
 {
 }
 
 GenerationHandlerTest::~GenerationHandlerTest() = default;
 
-TEST_F(GenerationHandlerTest, require_that_generation_can_be_increased)
+INSTANTIATE_TEST_SUITE_P(ReaderShards, GenerationHandlerTest, ::testing::Values(1u, 4u), ::testing::PrintToStringParamName());
+
+TEST_P(GenerationHandlerTest, require_that_generation_can_be_increased)
 {
     EXPECT_EQ(0u, gh.getCurrentGeneration());
     EXPECT_EQ(0u, gh.get_oldest_used_generation());
@@ -32,7 +36,7 @@ TEST_F(GenerationHandlerTest, require_that_generation_can_be_increased)
     EXPECT_EQ(1u, gh.get_oldest_used_generation());
 }
 
-TEST_F(GenerationHandlerTest, require_that_readers_can_take_guards)
+TEST_P(GenerationHandlerTest, require_that_readers_can_take_guards)
 {
     EXPECT_EQ(0u, gh.getGenerationRefCount(0));
     {
@@ -70,7 +74,7 @@ TEST_F(GenerationHandlerTest, require_that_readers_can_take_guards)
     EXPECT_EQ(0u, gh.getGenerationRefCount(2));
 }
 
-TEST_F(GenerationHandlerTest, require_that_guards_can_be_copied)
+TEST_P(GenerationHandlerTest, require_that_guards_can_be_copied)
 {
     GenGuard g1 = gh.takeGuard();
     EXPECT_EQ(1u, gh.getGenerationRefCount(0));
@@ -85,7 +89,7 @@ TEST_F(GenerationHandlerTest, require_that_guards_can_be_copied)
     EXPECT_EQ(0u, gh.getGenerationRefCount(1));
 }
 
-TEST_F(GenerationHandlerTest, require_that_the_first_used_generation_is_correct)
+TEST_P(GenerationHandlerTest, require_that_the_first_used_generation_is_correct)
 {
     EXPECT_EQ(0u, gh.get_oldest_used_generation());
     gh.incGeneration();
@@ -117,7 +121,7 @@ TEST_F(GenerationHandlerTest, require_that_the_first_used_generation_is_correct)
     EXPECT_EQ(4u, gh.get_oldest_used_generation());
 }
 
-TEST_F(GenerationHandlerTest, require_that_generation_can_grow_large)
+TEST_P(GenerationHandlerTest, require_that_generation_can_grow_large)
 {
     std::deque<GenGuard> guards;
     for (size_t i = 0; i < 10000; ++i) {
@@ -132,4 +136,36 @@ TEST_F(GenerationHandlerTest, require_that_generation_can_grow_large)
     }
 }
 
+TEST_P(GenerationHandlerTest, require_that_guards_from_many_threads_are_tracked)
+{
+    constexpr uint32_t num_threads = 8;
+    EXPECT_EQ(GetParam(), gh.get_num_reader_shards());
+    std::vector<GenGuard> guards(num_threads);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([this, &guards, i]() { guards[i] = gh.takeGuard(); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(num_threads, gh.getGenerationRefCount(0));
+    gh.incGeneration();
+    EXPECT_EQ(0u, gh.get_oldest_used_generation());
+    for (uint32_t i = 0; i + 1 < num_threads; ++i) {
+        guards[i] = GenGuard();
+        gh.update_oldest_used_generation();
+        EXPECT_EQ(num_threads - 1 - i, gh.getGenerationRefCount(0));
+        EXPECT_EQ(0u, gh.get_oldest_used_generation());
+    }
+    GenGuard copy(guards.back());
+    guards.back() = GenGuard();
+    gh.update_oldest_used_generation();
+    EXPECT_EQ(1u, gh.getGenerationRefCount(0));
+    EXPECT_EQ(0u, gh.get_oldest_used_generation());
+    copy = GenGuard();
+    gh.update_oldest_used_generation();
+    EXPECT_EQ(0u, gh.getGenerationRefCount());
+    EXPECT_EQ(1u, gh.get_oldest_used_generation());
+}
+
 }
@@ -1,11 +1,14 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/vespalib/util/mmap_file_allocator.h>
+#include <vespa/vespalib/util/mmap_file_allocator_tiers.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
 
 using vespalib::alloc::MemoryAllocator;
 using vespalib::alloc::MmapFileAllocator;
+using vespalib::alloc::MmapFileAllocatorTiers;
 using vespalib::alloc::PtrAndSize;
 
 namespace {
@@ -35,6 +38,13 @@ struct MyAlloc
     PtrAndSize asPair() const noexcept { return PtrAndSize(data, size); }
 };
 
+bool memlock_limit_too_low(size_t size)
+{
+    struct rlimit memlock_limit;
+    return getrlimit(RLIMIT_MEMLOCK, &memlock_limit) != 0 ||
+           (memlock_limit.rlim_cur != RLIM_INFINITY && memlock_limit.rlim_cur < size);
+}
+
 }
 
 struct AllocatorSetup {
@@ -129,3 +139,108 @@ TEST_P(MmapFileAllocatorTest, reuse_file_offset_works)
         EXPECT_EQ(0, memcmp(buf.data, world.c_str(), world.size() + 1));
     }
 }
+
+TEST_P(MmapFileAllocatorTest, tiering_is_disabled_by_default)
+{
+    EXPECT_FALSE(_allocator.has_tiers());
+    MyAlloc buf(_allocator, _allocator.alloc(256_Ki));
+    memset(buf.data, 1, buf.size);
+    auto stats = _allocator.get_tier_stats();
+    EXPECT_EQ(0u, stats.hot_bytes);
+    EXPECT_EQ(256_Ki, stats.cold_bytes);
+}
+
+TEST_P(MmapFileAllocatorTest, resident_area_is_pinned_and_later_released)
+{
+    if (memlock_limit_too_low(1_Mi)) {
+        GTEST_SKIP() << "memlock limit too low";
+    }
+    auto tiers = std::make_shared<MmapFileAllocatorTiers>(1_Mi);
+    _allocator.set_tiers(tiers);
+    MyAlloc buf(_allocator, _allocator.alloc(256_Ki));
+    memset(buf.data, 1, buf.size);
+    uint32_t updates = 0;
+    while (_allocator.get_tier_stats().hot_bytes == 0 && updates < 100) {
+        tiers->update_tiers();
+        ++updates;
+    }
+    auto stats = _allocator.get_tier_stats();
+    EXPECT_EQ(256_Ki, stats.hot_bytes);
+    EXPECT_EQ(0u, stats.cold_bytes);
+    EXPECT_EQ(256_Ki, tiers->get_hot_bytes());
+    EXPECT_LT(1u, updates);
+    while (_allocator.get_tier_stats().hot_bytes != 0 && updates < 200) {
+        tiers->update_tiers();
+        ++updates;
+    }
+    stats = _allocator.get_tier_stats();
+    EXPECT_EQ(0u, stats.hot_bytes);
+    EXPECT_EQ(256_Ki, stats.cold_bytes);
+    EXPECT_EQ(0u, tiers->get_hot_bytes());
+}
+
+TEST_P(MmapFileAllocatorTest, released_area_is_not_pinned_again_during_cooldown)
+{
+    if (memlock_limit_too_low(1_Mi)) {
+        GTEST_SKIP() << "memlock limit too low";
+    }
+    auto tiers = std::make_shared<MmapFileAllocatorTiers>(1_Mi);
+    _allocator.set_tiers(tiers);
+    MyAlloc buf(_allocator, _allocator.alloc(256_Ki));
+    memset(buf.data, 1, buf.size);
+    uint32_t updates = 0;
+    while (_allocator.get_tier_stats().hot_bytes == 0 && updates < 100) {
+        tiers->update_tiers();
+        ++updates;
+    }
+    ASSERT_EQ(256_Ki, _allocator.get_tier_stats().hot_bytes);
+    updates = 0;
+    while (_allocator.get_tier_stats().hot_bytes != 0 && updates < 200) {
+        tiers->update_tiers();
+        ++updates;
+    }
+    ASSERT_EQ(0u, _allocator.get_tier_stats().hot_bytes);
+    // A pinned area is held for many samples before it is released
+    EXPECT_LT(50u, updates);
+    // The area stays resident, but is only pinned again when the cooldown has passed
+    for (uint32_t i = 0; i < MmapFileAllocator::tier_cooldown_samples; ++i) {
+        tiers->update_tiers();
+        EXPECT_EQ(0u, _allocator.get_tier_stats().hot_bytes);
+    }
+    tiers->update_tiers();
+    EXPECT_EQ(256_Ki, _allocator.get_tier_stats().hot_bytes);
+}
+
+TEST_P(MmapFileAllocatorTest, area_is_not_pinned_when_above_hot_limit)
+{
+    auto tiers = std::make_shared<MmapFileAllocatorTiers>(128_Ki);
+    _allocator.set_tiers(tiers);
+    MyAlloc buf(_allocator, _allocator.alloc(256_Ki));
+    memset(buf.data, 1, buf.size);
+    for (uint32_t i = 0; i < 50; ++i) {
+        tiers->update_tiers();
+    }
+    auto stats = _allocator.get_tier_stats();
+    EXPECT_EQ(0u, stats.hot_bytes);
+    EXPECT_EQ(256_Ki, stats.cold_resident_bytes);
+}
+
+TEST_P(MmapFileAllocatorTest, hot_limit_is_shared_by_allocators)
+{
+    if (memlock_limit_too_low(1_Mi)) {
+        GTEST_SKIP() << "memlock limit too low";
+    }
+    auto tiers = std::make_shared<MmapFileAllocatorTiers>(256_Ki);
+    _allocator.set_tiers(tiers);
+    MmapFileAllocator other(basedir + "-other", GetParam().small_limit, GetParam().premmap_size);
+    other.set_tiers(tiers);
+    MyAlloc buf(_allocator, _allocator.alloc(256_Ki));
+    MyAlloc other_buf(other, other.alloc(256_Ki));
+    memset(buf.data, 1, buf.size);
+    memset(other_buf.data, 1, other_buf.size);
+    for (uint32_t i = 0; i < 20; ++i) {
+        tiers->update_tiers();
+    }
+    EXPECT_EQ(256_Ki, tiers->get_hot_bytes());
+    EXPECT_EQ(256_Ki, _allocator.get_tier_stats().hot_bytes + other.get_tier_stats().hot_bytes);
+}
@@ -0,0 +1,100 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/mmap_policy_allocator.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
+
+using vespalib::alloc::MemoryPolicy;
+using vespalib::alloc::MmapPolicyAllocator;
+using vespalib::alloc::PtrAndSize;
+
+using HugePages = MemoryPolicy::HugePages;
+using Numa = MemoryPolicy::Numa;
+
+namespace {
+
+void
+fill(PtrAndSize buf)
+{
+    memset(buf.get(), 0x55, buf.size());
+}
+
+}
+
+TEST(MmapPolicyAllocatorTest, small_allocations_use_heap)
+{
+    MmapPolicyAllocator allocator(MemoryPolicy(HugePages::NONE, Numa::DEFAULT, 0));
+    auto buf = allocator.alloc(1000);
+    EXPECT_EQ(1000u, buf.size());
+    fill(buf);
+    EXPECT_EQ(0u, allocator.get_stats().mapped_bytes);
+    allocator.free(buf);
+    EXPECT_EQ(0u, allocator.alloc(0).size());
+}
+
+TEST(MmapPolicyAllocatorTest, large_allocations_are_mapped)
+{
+    MmapPolicyAllocator allocator(MemoryPolicy(HugePages::TRANSPARENT, Numa::DEFAULT, 0));
+    EXPECT_EQ(4_Ki, allocator.get_policy().page_size());
+    auto buf = allocator.alloc(1_Mi + 1);
+    EXPECT_EQ(1_Mi + 4_Ki, buf.size());
+    fill(buf);
+    auto stats = allocator.get_stats();
+    EXPECT_EQ(buf.size(), stats.mapped_bytes);
+    EXPECT_EQ(0u, stats.huge_page_bytes);
+    EXPECT_EQ(0u, stats.fallbacks);
+    allocator.free(buf.get(), 1_Mi + 1);
+    EXPECT_EQ(0u, allocator.get_stats().mapped_bytes);
+}
+
+TEST(MmapPolicyAllocatorTest, default_huge_page_policy_uses_process_wide_mmap_allocator)
+{
+    MmapPolicyAllocator allocator(MemoryPolicy(HugePages::DEFAULT, Numa::INTERLEAVE, 0));
+    auto buf = allocator.alloc(1_Mi + 1);
+    EXPECT_EQ(1_Mi + 4_Ki, buf.size());
+    fill(buf);
+    auto stats = allocator.get_stats();
+    EXPECT_EQ(buf.size(), stats.mapped_bytes);
+    EXPECT_EQ(0u, stats.huge_page_bytes);
+    EXPECT_EQ(0u, stats.fallbacks);
+    allocator.free(buf.get(), 1_Mi + 1);
+    EXPECT_EQ(0u, allocator.get_stats().mapped_bytes);
+}
+
+TEST(MmapPolicyAllocatorTest, explicit_huge_pages_are_used_or_fall_back)
+{
+    MmapPolicyAllocator allocator(MemoryPolicy(HugePages::EXPLICIT_2M, Numa::DEFAULT, 0));
+    EXPECT_EQ(2_Mi, allocator.get_policy().page_size());
+    // Rounding up to whole huge pages would waste too much
+    auto normal = allocator.alloc(3_Mi);
+    EXPECT_EQ(3_Mi, normal.size());
+    // Rounding up to whole huge pages wastes less than 1/8
+    auto huge = allocator.alloc(4_Mi - 100_Ki);
+    EXPECT_EQ(4_Mi, huge.size());
+    fill(normal);
+    fill(huge);
+    auto stats = allocator.get_stats();
+    EXPECT_EQ(7_Mi, stats.mapped_bytes);
+    if (stats.fallbacks == 0) {
+        EXPECT_EQ(4_Mi, stats.huge_page_bytes);
+    } else {
+        EXPECT_EQ(1u, stats.fallbacks);
+        EXPECT_EQ(0u, stats.huge_page_bytes);
+    }
+    allocator.free(huge.get(), 4_Mi - 100_Ki);
+    allocator.free(normal);
+    stats = allocator.get_stats();
+    EXPECT_EQ(0u, stats.mapped_bytes);
+    EXPECT_EQ(0u, stats.huge_page_bytes);
+}
+
+TEST(MmapPolicyAllocatorTest, numa_policy_does_not_affect_content)
+{
+    for (auto numa : {Numa::INTERLEAVE, Numa::BIND}) {
+        MmapPolicyAllocator allocator(MemoryPolicy(HugePages::DEFAULT, numa, 1));
+        auto buf = allocator.alloc(1_Mi);
+        fill(buf);
+        EXPECT_EQ(0x55, static_cast<unsigned char*>(buf.get())[1_Mi - 1]);
+        allocator.free(buf);
+    }
+}
@@ -257,6 +257,7 @@ void
 AdaptiveSequencedExecutor::executeTask(ExecutorId id, Task::UP task)
 {
     assert(id.getId() < _strands.size());
+    count_scheduled_task(id);
     Strand &strand = _strands[id.getId()];
     auto guard = std::unique_lock(_mutex);
     assert(_self.state != Self::State::CLOSED);
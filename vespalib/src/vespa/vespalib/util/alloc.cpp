@@ -507,6 +507,11 @@ MemoryAllocator::select_allocator() {
     return & AutoAllocator::getDefault();
 }
 
+const MemoryAllocator *
+MemoryAllocator::select_mmap_allocator() {
+    return & MMapAllocator::getDefault();
+}
+
 Alloc
 Alloc::allocHeap(size_t sz)
 {
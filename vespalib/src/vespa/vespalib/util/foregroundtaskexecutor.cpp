@@ -22,6 +22,7 @@ void
 ForegroundTaskExecutor::executeTask(ExecutorId id, Executor::Task::UP task)
 {
     assert(id.getId() < getNumExecutors());
+    count_scheduled_task(id);
     task->run();
     _accepted++;
 }
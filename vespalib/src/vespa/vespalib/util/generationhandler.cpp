@@ -1,12 +1,29 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generationhandler.h"
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <thread>
 
 namespace vespalib {
 
-GenerationHandler::GenerationHold::GenerationHold() noexcept
-    : _refCount(1),
+namespace {
+
+constexpr uint32_t max_default_reader_shards = 16;
+
+// Slot assigned to the calling thread, used to select reader shard.
+uint32_t reader_slot() noexcept {
+    static std::atomic<uint32_t> next_slot(0);
+    thread_local uint32_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+}
+
+GenerationHandler::GenerationHold::GenerationHold(uint32_t numShards)
+    : _refCounts(std::make_unique<RefCount[]>(numShards)),
+      _numShards(numShards),
       _generation(0),
       _next(0)
 { }
@@ -17,52 +34,81 @@ GenerationHandler::GenerationHold::~GenerationHold() {
 
 void
 GenerationHandler::GenerationHold::setValid() noexcept {
-    auto old = _refCount.fetch_sub(1, std::memory_order_release);
-    assert(!valid(old));
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        auto old = _refCounts[i]._value.fetch_sub(1, std::memory_order_release);
+        (void) old;
+        assert(!valid(old));
+    }
 }
 
 bool
 GenerationHandler::GenerationHold::setInvalid() noexcept {
-    uint32_t refs = 0;
-    if (_refCount.compare_exchange_strong(refs, 1,
-                                          std::memory_order_acq_rel,
-                                          std::memory_order_relaxed))
-    {
-        return true;
-    } else {
-        assert(valid(refs));
-        return false;
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        uint32_t refs = 0;
+        if (!_refCounts[i]._value.compare_exchange_strong(refs, 1,
+                                                          std::memory_order_acq_rel,
+                                                          std::memory_order_relaxed))
+        {
+            assert(valid(refs));
+            // Still in use, make the shards already marked invalid valid again.
+            while (i > 0) {
+                --i;
+                _refCounts[i]._value.fetch_sub(1, std::memory_order_release);
+            }
+            return false;
+        }
     }
+    return true;
 }
 
 GenerationHandler::GenerationHold *
-GenerationHandler::GenerationHold::acquire() noexcept {
-    if (valid(_refCount.fetch_add(2, std::memory_order_acq_rel))) {
+GenerationHandler::GenerationHold::acquire(uint32_t shard) noexcept {
+    if (valid(_refCounts[shard]._value.fetch_add(2, std::memory_order_acq_rel))) {
         return this;
     } else {
-        release();
+        release(shard);
         return nullptr;
     }
 }
 
 GenerationHandler::GenerationHold *
-GenerationHandler::GenerationHold::copy(GenerationHold *self) noexcept {
+GenerationHandler::GenerationHold::copy(GenerationHold *self, uint32_t shard) noexcept {
     if (self == nullptr) {
         return nullptr;
     } else {
-        uint32_t oldRefCount = self->_refCount.fetch_add(2, std::memory_order_relaxed);
+        // The shard is guarded by the source, thus it cannot be marked invalid.
+        uint32_t oldRefCount = self->_refCounts[shard]._value.fetch_add(2, std::memory_order_relaxed);
         (void) oldRefCount;
         assert(valid(oldRefCount));
         return self;
     }
 }
 
+uint32_t
+GenerationHandler::GenerationHold::getRefCount() const noexcept {
+    uint32_t ret = 0;
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        ret += _refCounts[i]._value.load(std::memory_order_relaxed) / 2;
+    }
+    return ret;
+}
+
+uint32_t
+GenerationHandler::GenerationHold::getRefCountAcqRel() noexcept {
+    uint32_t ret = 0;
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        ret += _refCounts[i]._value.fetch_add(0, std::memory_order_acq_rel) / 2;
+    }
+    return ret;
+}
+
 GenerationHandler::Guard &
 GenerationHandler::Guard::operator=(const Guard & rhs) noexcept
 {
     if (&rhs != this) {
         cleanup();
-        _hold = GenerationHold::copy(rhs._hold);
+        _hold = GenerationHold::copy(rhs._hold, rhs._shard);
+        _shard = rhs._shard;
     }
     return *this;
 }
@@ -73,6 +119,7 @@ GenerationHandler::Guard::operator=(Guard &&rhs) noexcept
     if (&rhs != this) {
         cleanup();
         _hold = rhs._hold;
+        _shard = rhs._shard;
         rhs._hold = nullptr;
     }
     return *this;
@@ -97,14 +144,20 @@ GenerationHandler::update_oldest_used_generation()
 }
 
 GenerationHandler::GenerationHandler()
+    : GenerationHandler(1u)
+{
+}
+
+GenerationHandler::GenerationHandler(uint32_t numReaderShards)
     : _generation(0),
       _oldest_used_generation(0),
       _last(nullptr),
       _first(nullptr),
       _free(nullptr),
-      _numHolds(0u)
+      _numHolds(0u),
+      _numReaderShards(std::bit_ceil(std::max(numReaderShards, 1u)))
 {
-    _last = _first = new GenerationHold;
+    _last = _first = new GenerationHold(_numReaderShards);
     ++_numHolds;
     _first->_generation.store(getCurrentGeneration(), std::memory_order_relaxed);
     _first->setValid();
@@ -124,10 +177,17 @@ GenerationHandler::~GenerationHandler(void)
     delete _first;
 }
 
+uint32_t
+GenerationHandler::default_num_reader_shards() noexcept
+{
+    return std::min(std::bit_ceil(std::max(std::thread::hardware_concurrency(), 1u)), max_default_reader_shards);
+}
+
 GenerationHandler::Guard
 GenerationHandler::takeGuard() const
 {
-    Guard guard(_last.load(std::memory_order_acquire));
+    uint32_t shard = (_numReaderShards == 1u) ? 0u : (reader_slot() & (_numReaderShards - 1));
+    Guard guard(_last.load(std::memory_order_acquire), shard);
     for (;;) {
         // Must check valid() after increasing refcount
         if (guard.valid())
@@ -136,7 +196,7 @@ GenerationHandler::takeGuard() const
          * Clashed with writer freeing entry.  Must abandon current
          * guard and try again.
          */
-        guard = Guard(_last.load(std::memory_order_acquire));
+        guard = Guard(_last.load(std::memory_order_acquire), shard);
     }
     // Guard has been valid after bumping refCount
     return guard;
@@ -158,7 +218,7 @@ GenerationHandler::incGeneration()
     }
     GenerationHold *nhold = nullptr;
     if (_free == nullptr) {
-        nhold = new GenerationHold;
+        nhold = new GenerationHold(_numReaderShards);
         ++_numHolds;
     } else {
         nhold = _free;
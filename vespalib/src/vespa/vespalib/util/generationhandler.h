@@ -2,8 +2,9 @@
 
 #pragma once
 
-#include <cstdint>
 #include <atomic>
+#include <cstdint>
+#include <memory>
 
 namespace vespalib {
 
@@ -22,33 +23,38 @@ public:
      * This must be type stable memory, and cannot be freed before the
      * GenerationHandler is freed (i.e. when external methods ensure that
      * no readers are still active).
+     *
+     * The reference count can be split into multiple shards, each in its
+     * own cache line. A reader only touches the shard selected by its
+     * thread, and the writer aggregates all shards.
      */
     class GenerationHold
     {
-        // least significant bit is invalid flag
-        std::atomic<uint32_t> _refCount;
+        struct alignas(64) RefCount {
+            // least significant bit is invalid flag
+            std::atomic<uint32_t> _value;
+            RefCount() noexcept : _value(1) { }
+        };
+        std::unique_ptr<RefCount[]> _refCounts;
+        uint32_t                    _numShards;
 
         static bool valid(uint32_t refCount) noexcept { return (refCount & 1) == 0u; }
     public:
         std::atomic<generation_t> _generation;
         GenerationHold *_next;	// next free element or next newer element.
 
-        GenerationHold() noexcept;
+        explicit GenerationHold(uint32_t numShards);
         ~GenerationHold();
 
         void setValid() noexcept;
         bool setInvalid() noexcept;
-        void release() noexcept {
-            _refCount.fetch_sub(2, std::memory_order_release);
-        }
-        GenerationHold *acquire() noexcept;
-        static GenerationHold *copy(GenerationHold *self) noexcept;
-        uint32_t getRefCount() const noexcept {
-            return _refCount.load(std::memory_order_relaxed) / 2;
-        }
-        uint32_t getRefCountAcqRel() noexcept {
-            return _refCount.fetch_add(0, std::memory_order_acq_rel) / 2;
+        void release(uint32_t shard) noexcept {
+            _refCounts[shard]._value.fetch_sub(2, std::memory_order_release);
         }
+        GenerationHold *acquire(uint32_t shard) noexcept;
+        static GenerationHold *copy(GenerationHold *self, uint32_t shard) noexcept;
+        uint32_t getRefCount() const noexcept;
+        uint32_t getRefCountAcqRel() noexcept;
     };
 
     /**
@@ -57,19 +63,24 @@ public:
     class Guard {
     private:
         GenerationHold *_hold;
+        uint32_t        _shard;
         void cleanup() noexcept {
             if (_hold != nullptr) {
-                _hold->release();
+                _hold->release(_shard);
                 _hold = nullptr;
             }
         }
     public:
-        Guard() noexcept : _hold(nullptr) { }
-        Guard(GenerationHold *hold) noexcept : _hold(hold->acquire()) { } // hold is never nullptr
+        Guard() noexcept : _hold(nullptr), _shard(0) { }
+        Guard(GenerationHold *hold, uint32_t shard) noexcept // hold is never nullptr
+            : _hold(hold->acquire(shard)),
+              _shard(shard)
+        { }
         ~Guard() { cleanup(); }
-        Guard(const Guard & rhs) noexcept : _hold(GenerationHold::copy(rhs._hold)) { }
+        Guard(const Guard & rhs) noexcept : _hold(GenerationHold::copy(rhs._hold, rhs._shard)), _shard(rhs._shard) { }
         Guard(Guard &&rhs) noexcept
-            : _hold(rhs._hold)
+            : _hold(rhs._hold),
+              _shard(rhs._shard)
         {
             rhs._hold = nullptr;
         }
@@ -89,6 +100,7 @@ private:
     GenerationHold               *_first;     // Points to "firstUsedGeneration" entry
     GenerationHold               *_free;      // List of free entries
     uint32_t                      _numHolds;  // Number of allocated generation hold entries
+    uint32_t                      _numReaderShards; // Power of 2
 
     void set_generation(generation_t generation) noexcept { _generation.store(generation, std::memory_order_relaxed); }
 
@@ -97,6 +109,15 @@ public:
      * Creates a new generation handler.
      **/
     GenerationHandler();
+
+    /**
+     * Creates a new generation handler where reader reference counts
+     * are split into the given number of shards (rounded up to a power
+     * of 2). Reader threads are spread across the shards, reducing
+     * contention when many threads take guards concurrently, at the
+     * cost of more memory per generation and more work for the writer.
+     **/
+    explicit GenerationHandler(uint32_t numReaderShards);
     ~GenerationHandler();
 
     /**
@@ -136,6 +157,14 @@ public:
         return getCurrentGeneration() + 1;
     }
 
+    uint32_t get_num_reader_shards() const noexcept { return _numReaderShards; }
+
+    /**
+     * Number of reader shards suitable for a generation handler with
+     * many concurrent reader threads on this host.
+     **/
+    static uint32_t default_num_reader_shards() noexcept;
+
     /**
      * Returns the number of readers holding a generation guard on the
      * given generation.  Should be called by the writer thread.
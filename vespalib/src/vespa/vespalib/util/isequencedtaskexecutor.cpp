@@ -6,7 +6,8 @@
 namespace vespalib {
 
 ISequencedTaskExecutor::ISequencedTaskExecutor(uint32_t numExecutors)
-    : _numExecutors(numExecutors)
+    : _numExecutors(numExecutors),
+      _scheduled_tasks(std::make_unique<std::atomic<uint64_t>[]>(numExecutors))
 {
 }
 
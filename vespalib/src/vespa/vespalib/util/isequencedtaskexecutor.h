@@ -4,6 +4,8 @@
 #include <vespa/vespalib/util/executor.h>
 #include <vespa/vespalib/util/executor_stats.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -92,6 +94,16 @@ public:
 
     virtual ExecutorStats getStats() = 0;
 
+    /**
+     * Returns the number of tasks scheduled with the given id so far.
+     * Implementations count a task before queueing it. A caller that
+     * reads the same count after scheduling a task and at a later time
+     * knows that no other task with the same id was queued in between.
+     */
+    uint64_t get_num_scheduled_tasks(ExecutorId id) const noexcept {
+        return _scheduled_tasks[id.getId()].load();
+    }
+
     /**
      * Wrap lambda function into a task and schedule it to be run.
      * Caller must ensure that pointers and references are valid and
@@ -119,8 +131,11 @@ public:
         executeTask(id, makeLambdaTask(std::forward<FunctionType>(function)));
     }
 
+protected:
+    void count_scheduled_task(ExecutorId id) noexcept { _scheduled_tasks[id.getId()].fetch_add(1); }
 private:
     uint32_t                     _numExecutors;
+    std::unique_ptr<std::atomic<uint64_t>[]> _scheduled_tasks;
 };
 
 }
@@ -52,6 +52,8 @@ public:
     }
     static const MemoryAllocator * select_allocator();
     static const MemoryAllocator * select_allocator(size_t mmapLimit, size_t alignment);
+    // Process wide allocator for anonymous memory mappings, using huge pages if VESPA_USE_HUGEPAGES is set.
+    static const MemoryAllocator * select_mmap_allocator();
 };
 
 }
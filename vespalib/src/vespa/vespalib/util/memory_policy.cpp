@@ -0,0 +1,31 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "memory_policy.h"
+
+namespace vespalib::alloc {
+
+std::string_view
+to_string(MemoryPolicy::HugePages huge_pages) noexcept
+{
+    switch (huge_pages) {
+    case MemoryPolicy::HugePages::DEFAULT:     return "default";
+    case MemoryPolicy::HugePages::NONE:        return "none";
+    case MemoryPolicy::HugePages::TRANSPARENT: return "transparent";
+    case MemoryPolicy::HugePages::EXPLICIT_2M: return "explicit_2m";
+    case MemoryPolicy::HugePages::EXPLICIT_1G: return "explicit_1g";
+    }
+    return "unknown";
+}
+
+std::string_view
+to_string(MemoryPolicy::Numa numa) noexcept
+{
+    switch (numa) {
+    case MemoryPolicy::Numa::DEFAULT:    return "default";
+    case MemoryPolicy::Numa::INTERLEAVE: return "interleave";
+    case MemoryPolicy::Numa::BIND:       return "bind";
+    }
+    return "unknown";
+}
+
+}
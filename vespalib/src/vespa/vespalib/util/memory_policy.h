@@ -0,0 +1,60 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace vespalib::alloc {
+
+/*
+ * Huge page and NUMA placement policy for memory allocated on behalf of
+ * a data structure, e.g. an attribute vector.
+ */
+struct MemoryPolicy {
+    enum class HugePages : uint8_t {
+        DEFAULT,     // Process wide default, see MemoryAllocator::select_mmap_allocator()
+        NONE,        // Advise kernel to not use transparent huge pages
+        TRANSPARENT, // Advise kernel to use transparent huge pages
+        EXPLICIT_2M, // Preallocated 2 MiB huge pages, falling back to normal pages
+        EXPLICIT_1G  // Preallocated 1 GiB huge pages, falling back to normal pages
+    };
+    enum class Numa : uint8_t {
+        DEFAULT,     // Kernel default, i.e. local node of first touch
+        INTERLEAVE,  // Interleave pages across nodes in node mask
+        BIND         // Only allocate pages from nodes in node mask
+    };
+    HugePages huge_pages;
+    Numa      numa;
+    uint64_t  numa_node_mask; // 0 means all nodes
+
+    constexpr MemoryPolicy() noexcept
+        : MemoryPolicy(HugePages::DEFAULT, Numa::DEFAULT, 0)
+    { }
+    constexpr MemoryPolicy(HugePages huge_pages_in, Numa numa_in, uint64_t numa_node_mask_in) noexcept
+        : huge_pages(huge_pages_in),
+          numa(numa_in),
+          numa_node_mask(numa_node_mask_in)
+    { }
+    // Size of explicit huge pages, 0 if not using explicit huge pages.
+    size_t huge_page_size() const noexcept {
+        switch (huge_pages) {
+        case HugePages::EXPLICIT_2M: return size_t(2) << 20;
+        case HugePages::EXPLICIT_1G: return size_t(1) << 30;
+        default:                     return 0;
+        }
+    }
+    // Size of pages backing mapped memory, unless falling back from explicit huge pages.
+    size_t page_size() const noexcept {
+        size_t huge_size = huge_page_size();
+        return huge_size != 0 ? huge_size : size_t(4) << 10;
+    }
+    bool is_default() const noexcept { return huge_pages == HugePages::DEFAULT && numa == Numa::DEFAULT; }
+    bool operator==(const MemoryPolicy& rhs) const noexcept = default;
+};
+
+std::string_view to_string(MemoryPolicy::HugePages huge_pages) noexcept;
+std::string_view to_string(MemoryPolicy::Numa numa) noexcept;
+
+}
@@ -1,12 +1,14 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "mmap_file_allocator.h"
+#include "mmap_file_allocator_tiers.h"
 #include "round_up_to_page_size.h"
 #include "exceptions.h"
 #include "stringfmt.h"
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 
@@ -15,6 +17,17 @@ namespace fs = std::filesystem;
 
 namespace vespalib::alloc {
 
+// Residency of a cold area, sampled without holding _tier_lock
+struct MmapFileAllocator::TierSample {
+    void*                      ptr;
+    size_t                     size;
+    uint64_t                   id;
+    std::vector<unsigned char> residency; // Residency at previous sample, replaced when sampled
+    bool                       sampled;
+    size_t                     resident_pages;
+    uint64_t                   page_ins;
+};
+
 MmapFileAllocator::MmapFileAllocator(std::string dir_name)
     : MmapFileAllocator(std::move(dir_name), default_small_limit, default_premmap_size)
 {
@@ -30,7 +43,14 @@ MmapFileAllocator::MmapFileAllocator(std::string dir_name, uint32_t small_limit,
       _freelist(),
       _small_allocations(),
       _small_freelist(),
-      _premmapped_areas()
+      _premmapped_areas(),
+      _tiers(),
+      _tier_lock(),
+      _tier_states(),
+      _tier_state_ids(0),
+      _hot_bytes(0),
+      _cold_resident_bytes(0),
+      _cold_page_ins(0)
 {
     fs::create_directories(fs::path(_dir_name));
     _file.open(O_RDWR | O_CREAT | O_TRUNC, false);
@@ -38,6 +58,9 @@ MmapFileAllocator::MmapFileAllocator(std::string dir_name, uint32_t small_limit,
 
 MmapFileAllocator::~MmapFileAllocator()
 {
+    if (_tiers) {
+        _tiers->remove(*this);
+    }
     assert(_small_allocations.empty());
     assert(_allocations.size() == _premmapped_areas.size());
     for (auto& area : _premmapped_areas) {
@@ -53,6 +76,7 @@ MmapFileAllocator::~MmapFileAllocator()
     }
     _premmapped_areas.clear();
     assert(_allocations.empty());
+    assert(_tier_states.empty());
     _file.close();
     _file.unlink();
     fs::remove_all(fs::path(_dir_name));
@@ -99,8 +123,11 @@ MmapFileAllocator::alloc_large(size_t sz) const
     }
     assert(buf != nullptr);
     // Register allocation
-    auto ins_res = _allocations.insert(std::make_pair(buf, SizeAndOffset(sz, offset)));
-    assert(ins_res.second);
+    {
+        std::lock_guard guard(_tier_lock);
+        auto ins_res = _allocations.insert(std::make_pair(buf, SizeAndOffset(sz, offset)));
+        assert(ins_res.second);
+    }
     int retval = madvise(buf, sz, MADV_RANDOM);
     assert(retval == 0);
 #ifdef __linux__
@@ -180,7 +207,24 @@ MmapFileAllocator::remove_allocation(PtrAndSize alloc, Allocations& allocations)
 void
 MmapFileAllocator::free_large(PtrAndSize alloc) const noexcept
 {
-    auto offset = remove_allocation(alloc, _allocations);
+    uint64_t offset;
+    bool was_hot = false;
+    {
+        std::lock_guard guard(_tier_lock);
+        offset = remove_allocation(alloc, _allocations);
+        auto tier_itr = _tier_states.find(alloc.get());
+        if (tier_itr != _tier_states.end()) {
+            if (tier_itr->second.hot) {
+                was_hot = true;
+                _hot_bytes -= alloc.size();
+                _tiers->release_hot(alloc.size());
+            }
+            _tier_states.erase(tier_itr);
+        }
+    }
+    if (was_hot) {
+        munlock(alloc.get(), alloc.size());
+    }
     int retval = madvise(alloc.get(), alloc.size(), MADV_DONTNEED);
     assert(retval == 0);
     retval = munmap(alloc.get(), alloc.size());
@@ -201,4 +245,159 @@ MmapFileAllocator::resize_inplace(PtrAndSize, size_t) const
     return 0;
 }
 
+void
+MmapFileAllocator::sample_residency(TierSample& sample)
+{
+    size_t pages = sample.size / MemoryAllocator::PAGE_SIZE;
+    std::vector<unsigned char> residency(pages);
+    if (mincore(sample.ptr, sample.size, residency.data()) != 0) {
+        return; // Area was unmapped after it was listed
+    }
+    bool has_previous = sample.residency.size() == pages;
+    for (size_t i = 0; i < pages; ++i) {
+        bool resident = (residency[i] & 1) != 0;
+        if (resident) {
+            ++sample.resident_pages;
+            if (has_previous && (sample.residency[i] & 1) == 0) {
+                ++sample.page_ins;
+            }
+        }
+    }
+    sample.residency = std::move(residency);
+    sample.sampled = true;
+}
+
+MmapFileAllocator::TierState*
+MmapFileAllocator::find_tier_state(void* ptr, uint64_t id) const
+{
+    // Tier state is removed when the area is freed, and a new area at the same address gets a new id.
+    auto itr = _tier_states.find(ptr);
+    if (itr == _tier_states.end() || itr->second.id != id) {
+        return nullptr;
+    }
+    return &itr->second;
+}
+
+void
+MmapFileAllocator::set_tiers(std::shared_ptr<MmapFileAllocatorTiers> tiers)
+{
+    assert(!_tiers && _allocations.empty());
+    _tiers = std::move(tiers);
+    _tiers->add(*this);
+}
+
+void
+MmapFileAllocator::sample_tiers(std::vector<TierCandidate>& candidates) const
+{
+    std::vector<TierSample> samples;
+    std::vector<PtrAndSize> released;
+    {
+        std::lock_guard guard(_tier_lock);
+        samples.reserve(_allocations.size());
+        for (auto& allocation : _allocations) {
+            void* ptr = allocation.first;
+            size_t size = allocation.second.size;
+            auto& state = _tier_states[ptr];
+            if (state.id == 0) {
+                state.id = ++_tier_state_ids;
+            }
+            if (state.hot) {
+                state.score *= pinned_score_decay;
+                if (state.score < cold_score_threshold) {
+                    state.hot = false;
+                    state.score = 0.0;
+                    state.cooldown = tier_cooldown_samples;
+                    _hot_bytes -= size;
+                    _tiers->release_hot(size);
+                    released.emplace_back(ptr, size);
+                }
+                continue;
+            }
+            samples.push_back({ptr, size, state.id, std::move(state.residency), false, 0, 0});
+        }
+    }
+    for (auto& area : released) {
+        munlock(area.get(), area.size());
+    }
+    for (auto& sample : samples) {
+        sample_residency(sample);
+    }
+    std::lock_guard guard(_tier_lock);
+    _cold_resident_bytes = 0;
+    for (auto& sample : samples) {
+        auto* state = find_tier_state(sample.ptr, sample.id);
+        if (state == nullptr) {
+            continue; // Area was freed while sampling
+        }
+        state->residency = std::move(sample.residency);
+        if (!sample.sampled) {
+            continue;
+        }
+        size_t pages = sample.size / MemoryAllocator::PAGE_SIZE;
+        _cold_resident_bytes += sample.resident_pages * MemoryAllocator::PAGE_SIZE;
+        _cold_page_ins += sample.page_ins;
+        double resident_fraction = (pages != 0) ? (static_cast<double>(sample.resident_pages) / pages) : 0.0;
+        state->score = state->score * tier_score_decay + resident_fraction * (1.0 - tier_score_decay);
+        if (state->cooldown != 0) {
+            --state->cooldown;
+        } else if (state->score >= hot_score_threshold) {
+            candidates.push_back({this, sample.ptr, sample.size, sample.id, state->score});
+        }
+    }
+}
+
+bool
+MmapFileAllocator::pin(const TierCandidate& candidate) const
+{
+    {
+        std::lock_guard guard(_tier_lock);
+        auto* state = find_tier_state(candidate.ptr, candidate.id);
+        if (state == nullptr || state->hot) {
+            return false; // Area was freed after it was sampled
+        }
+    }
+    if (mlock(candidate.ptr, candidate.size) != 0) {
+        return false; // mlock is typically limited by RLIMIT_MEMLOCK
+    }
+    {
+        std::lock_guard guard(_tier_lock);
+        auto* state = find_tier_state(candidate.ptr, candidate.id);
+        if (state != nullptr) {
+            state->hot = true;
+            state->residency.clear();
+            _hot_bytes += candidate.size;
+            return true;
+        }
+    }
+    munlock(candidate.ptr, candidate.size); // Area was freed while it was locked
+    return false;
+}
+
+MmapFileAllocator::TierStats
+MmapFileAllocator::get_tier_stats() const
+{
+    std::lock_guard guard(_tier_lock);
+    TierStats stats;
+    size_t total_bytes = 0;
+    for (auto& allocation : _allocations) {
+        total_bytes += allocation.second.size;
+    }
+    stats.hot_bytes = _hot_bytes;
+    stats.cold_bytes = total_bytes - _hot_bytes;
+    stats.cold_resident_bytes = _cold_resident_bytes;
+    stats.cold_page_ins = _cold_page_ins;
+    return stats;
+}
+
+void
+MmapFileAllocator::prefetch(const void* ptr, size_t size) noexcept
+{
+    if (size == 0) {
+        return;
+    }
+    auto start = reinterpret_cast<uintptr_t>(ptr) & ~(MemoryAllocator::PAGE_SIZE - 1);
+    auto end = reinterpret_cast<uintptr_t>(ptr) + size;
+    madvise(reinterpret_cast<void*>(start), end - start, MADV_WILLNEED);
+}
+
 }
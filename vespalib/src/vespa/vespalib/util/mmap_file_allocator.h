@@ -8,10 +8,15 @@
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace vespalib::alloc {
 
+class MmapFileAllocatorTiers;
+
 /*
  * Class handling memory allocations backed by one or more files.
  * Not reentrant or thread safe. Should not be destructed before all allocations
@@ -19,6 +24,24 @@ namespace vespalib::alloc {
  *
  * Memory allocations smaller than _small_limit use portions of
  * premmapped areas to reduce the total number of memory mappings.
+ *
+ * Optional tiering of memory areas (large allocations and premmapped
+ * areas) is driven by MmapFileAllocatorTiers, which samples page cache
+ * residency for each area. Areas that stay resident (hot) are pinned in
+ * memory as long as the total size of pinned areas is below the hot
+ * limit, to avoid them being evicted by other file system activity.
+ *
+ * Residency of a pinned area tells nothing about how it is accessed, so
+ * the score of a pinned area decays slowly until the area is released
+ * again. A released area is then evaluated like other (cold) areas, and
+ * it cannot be pinned again before its score has been rebuilt from
+ * residency sampled over tier_cooldown_samples samples. Only areas that
+ * stay resident while not pinned are pinned again.
+ *
+ * Tiering runs in another thread, and _tier_lock protects the state
+ * shared with it. Kernel calls made for tiering (mincore, mlock, munlock)
+ * are made without holding _tier_lock, and the area is looked up again
+ * afterwards in case it was freed in the meantime.
  */
 class MmapFileAllocator : public MemoryAllocator {
     struct SizeAndOffset {
@@ -31,6 +54,16 @@ class MmapFileAllocator : public MemoryAllocator {
         { }
     };
     using Allocations = hash_map<void *, SizeAndOffset>;
+    struct TierState {
+        std::vector<unsigned char> residency; // Per page residency at last sample, empty if not sampled
+        uint64_t id;                           // Identifies the allocation, as the address can be reused
+        double   score;                        // Decaying average of resident fraction
+        uint32_t cooldown;                     // Samples left before the area can be pinned again
+        bool     hot;                          // Pinned in memory
+        TierState() noexcept : residency(), id(0), score(0.0), cooldown(0), hot(false) { }
+    };
+    using TierStates = hash_map<void *, TierState>;
+    struct TierSample;
     const std::string _dir_name;
     const uint32_t   _small_limit;
     const uint32_t   _premmap_size;
@@ -41,14 +74,42 @@ class MmapFileAllocator : public MemoryAllocator {
     mutable Allocations _small_allocations;
     mutable FileAreaFreeList _small_freelist;
     mutable std::map<uint64_t, void*> _premmapped_areas;
+    std::shared_ptr<MmapFileAllocatorTiers> _tiers;
+    mutable std::mutex _tier_lock;
+    mutable TierStates _tier_states;
+    mutable uint64_t _tier_state_ids;
+    mutable size_t   _hot_bytes;
+    mutable size_t   _cold_resident_bytes;
+    mutable uint64_t _cold_page_ins;
     uint64_t alloc_area(size_t sz) const;
     PtrAndSize alloc_large(size_t size) const;
     PtrAndSize alloc_small(size_t size) const;
     void free_large(PtrAndSize alloc) const noexcept;
     void free_small(PtrAndSize alloc) const noexcept;
+    static void sample_residency(TierSample& sample);
+    TierState* find_tier_state(void* ptr, uint64_t id) const;
     void* map_premapped_offset_to_ptr(uint64_t offset, size_t size) const;
     uint64_t remove_allocation(PtrAndSize alloc, Allocations& allocations) const noexcept;
 public:
+    struct TierCandidate {
+        const MmapFileAllocator* allocator;
+        void*                    ptr;
+        size_t                   size;
+        uint64_t                 id;
+        double                   score;
+    };
+    struct TierStats {
+        size_t   hot_bytes;           // Bytes in areas pinned in memory
+        size_t   cold_bytes;          // Bytes in areas left to the page cache
+        size_t   cold_resident_bytes; // Bytes of cold areas resident at last sample
+        uint64_t cold_page_ins;       // Pages of cold areas that became resident between samples
+        TierStats() noexcept : hot_bytes(0), cold_bytes(0), cold_resident_bytes(0), cold_page_ins(0) { }
+    };
+    static constexpr double tier_score_decay = 0.9;
+    static constexpr double pinned_score_decay = 0.99;
+    static constexpr uint32_t tier_cooldown_samples = 32;
+    static constexpr double hot_score_threshold = 0.75;
+    static constexpr double cold_score_threshold = 0.25;
     static constexpr uint32_t default_small_limit =  128_Ki;
     static constexpr uint32_t default_premmap_size = 1_Mi;
     explicit MmapFileAllocator(std::string dir_name);
@@ -58,6 +119,18 @@ public:
     void free(PtrAndSize alloc) const noexcept override;
     size_t resize_inplace(PtrAndSize, size_t) const override;
 
+    // Enable tiering of memory areas. Must be called before any allocations are made.
+    void set_tiers(std::shared_ptr<MmapFileAllocatorTiers> tiers);
+    bool has_tiers() const noexcept { return static_cast<bool>(_tiers); }
+    // Sample residency, release pinned areas that are no longer hot and add areas that
+    // can be pinned to candidates. Called by MmapFileAllocatorTiers.
+    void sample_tiers(std::vector<TierCandidate>& candidates) const;
+    // Pin a candidate area in memory. Called by MmapFileAllocatorTiers.
+    bool pin(const TierCandidate& candidate) const;
+    TierStats get_tier_stats() const;
+    // Advise that memory will be accessed soon, e.g. before a sequential scan.
+    static void prefetch(const void* ptr, size_t size) noexcept;
+
     // For unit test
     size_t get_end_offset() const noexcept { return _end_offset; }
 };
@@ -2,6 +2,7 @@
 
 #include "mmap_file_allocator_factory.h"
 #include "mmap_file_allocator.h"
+#include "mmap_file_allocator_tiers.h"
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <filesystem>
 
@@ -9,6 +10,7 @@ namespace vespalib::alloc {
 
 MmapFileAllocatorFactory::MmapFileAllocatorFactory()
     : _dir_name(),
+      _tiers(),
       _generation(0)
 {
 }
@@ -17,8 +19,15 @@ MmapFileAllocatorFactory::~MmapFileAllocatorFactory() = default;
 
 void
 MmapFileAllocatorFactory::setup(const std::string& dir_name)
+{
+    setup(dir_name, 0);
+}
+
+void
+MmapFileAllocatorFactory::setup(const std::string& dir_name, size_t hot_limit)
 {
     _dir_name = dir_name;
+    _tiers = (hot_limit != 0) ? std::make_shared<MmapFileAllocatorTiers>(hot_limit) : std::shared_ptr<MmapFileAllocatorTiers>();
     _generation = 0;
     if (!_dir_name.empty()) {
         std::filesystem::remove_all(std::filesystem::path(_dir_name));
@@ -33,9 +42,21 @@ MmapFileAllocatorFactory::make_memory_allocator(const std::string& name)
     }
     vespalib::asciistream os;
     os << _dir_name << "/" << _generation.fetch_add(1) << "." << name;
-    return std::make_unique<MmapFileAllocator>(os.str());
+    auto allocator = std::make_unique<MmapFileAllocator>(os.str());
+    if (_tiers) {
+        allocator->set_tiers(_tiers);
+    }
+    return allocator;
 };
 
+void
+MmapFileAllocatorFactory::update_tiers()
+{
+    if (_tiers) {
+        _tiers->update_tiers();
+    }
+}
+
 MmapFileAllocatorFactory&
 MmapFileAllocatorFactory::instance()
 {
@@ -9,12 +9,14 @@
 namespace vespalib::alloc {
 
 class MemoryAllocator;
+class MmapFileAllocatorTiers;
 
 /*
  * Class for creating an mmap file allocator on demand.
  */
 class MmapFileAllocatorFactory {
     std::string _dir_name;
+    std::shared_ptr<MmapFileAllocatorTiers> _tiers;
     std::atomic<uint64_t> _generation;
 
     MmapFileAllocatorFactory();
@@ -23,7 +25,12 @@ class MmapFileAllocatorFactory {
     MmapFileAllocatorFactory& operator=(const MmapFileAllocatorFactory &) = delete;
 public:
     void setup(const std::string &dir_name);
+    // hot_limit is the max number of bytes pinned in memory for all created allocators, 0 disables tiering
+    void setup(const std::string &dir_name, size_t hot_limit);
     std::unique_ptr<MemoryAllocator> make_memory_allocator(const std::string& name);
+    // Move memory areas of all created allocators between tiers, see MmapFileAllocatorTiers
+    void update_tiers();
+    bool has_tiers() const noexcept { return static_cast<bool>(_tiers); }
 
     static MmapFileAllocatorFactory& instance();
 };
@@ -0,0 +1,61 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mmap_file_allocator_tiers.h"
+#include "mmap_file_allocator.h"
+#include <algorithm>
+#include <cassert>
+
+namespace vespalib::alloc {
+
+MmapFileAllocatorTiers::MmapFileAllocatorTiers(size_t hot_limit)
+    : _hot_limit(hot_limit),
+      _hot_bytes(0),
+      _lock(),
+      _allocators()
+{
+}
+
+MmapFileAllocatorTiers::~MmapFileAllocatorTiers()
+{
+    assert(_allocators.empty());
+}
+
+void
+MmapFileAllocatorTiers::add(const MmapFileAllocator& allocator)
+{
+    std::lock_guard guard(_lock);
+    _allocators.emplace_back(&allocator);
+}
+
+void
+MmapFileAllocatorTiers::remove(const MmapFileAllocator& allocator)
+{
+    std::lock_guard guard(_lock);
+    auto itr = std::find(_allocators.begin(), _allocators.end(), &allocator);
+    assert(itr != _allocators.end());
+    _allocators.erase(itr);
+}
+
+void
+MmapFileAllocatorTiers::update_tiers()
+{
+    std::lock_guard guard(_lock);
+    std::vector<MmapFileAllocator::TierCandidate> candidates;
+    for (auto allocator : _allocators) {
+        allocator->sample_tiers(candidates);
+    }
+    // The hottest areas among all the allocators are pinned first.
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.score > rhs.score; });
+    for (auto& candidate : candidates) {
+        if (get_hot_bytes() + candidate.size > _hot_limit) {
+            continue;
+        }
+        _hot_bytes.fetch_add(candidate.size, std::memory_order_relaxed);
+        if (!candidate.allocator->pin(candidate)) {
+            release_hot(candidate.size);
+        }
+    }
+}
+
+}
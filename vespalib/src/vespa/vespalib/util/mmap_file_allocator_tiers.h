@@ -0,0 +1,41 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace vespalib::alloc {
+
+class MmapFileAllocator;
+
+/*
+ * Tiering of memory areas for a set of mmap file allocators, see
+ * MmapFileAllocator. Areas that stay resident in the page cache are
+ * pinned in memory, and the total size of pinned areas for all the
+ * allocators is kept below the hot limit.
+ *
+ * update_tiers() samples page cache residency of all areas and pins
+ * memory. It should be called periodically, from a thread that is not
+ * used for writing to the memory handled by the allocators.
+ */
+class MmapFileAllocatorTiers {
+    const size_t                          _hot_limit;
+    std::atomic<size_t>                   _hot_bytes;
+    std::mutex                            _lock;
+    std::vector<const MmapFileAllocator*> _allocators;
+public:
+    explicit MmapFileAllocatorTiers(size_t hot_limit);
+    ~MmapFileAllocatorTiers();
+    size_t get_hot_limit() const noexcept { return _hot_limit; }
+    size_t get_hot_bytes() const noexcept { return _hot_bytes.load(std::memory_order_relaxed); }
+    void add(const MmapFileAllocator& allocator);
+    void remove(const MmapFileAllocator& allocator);
+    void update_tiers();
+    // Called by an allocator when a pinned area is released or freed.
+    void release_hot(size_t size) noexcept { _hot_bytes.fetch_sub(size, std::memory_order_relaxed); }
+};
+
+}
@@ -0,0 +1,221 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mmap_policy_allocator.h"
+#include "round_up_to_page_size.h"
+#include "exceptions.h"
+#include "stringfmt.h"
+#include <vespa/vespalib/stllike/hash_set.hpp>
+#include <sys/mman.h>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdlib>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.alloc.mmap_policy_allocator");
+
+using vespalib::make_string_short::fmt;
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+namespace vespalib::alloc {
+
+namespace {
+
+// Memory policy modes and flags from <linux/mempolicy.h>
+constexpr int mpol_bind = 2;
+constexpr int mpol_interleave = 3;
+constexpr int mpol_f_mems_allowed = 1 << 2;
+constexpr unsigned long numa_mask_bits = 64;
+
+size_t
+round_up(size_t sz, size_t alignment) noexcept
+{
+    return (sz + (alignment - 1)) & ~(alignment - 1);
+}
+
+#ifdef __linux__
+uint64_t
+allowed_numa_nodes() noexcept
+{
+    uint64_t mask = 0;
+    if (syscall(SYS_get_mempolicy, nullptr, &mask, numa_mask_bits, nullptr, mpol_f_mems_allowed) != 0) {
+        return 0;
+    }
+    return mask;
+}
+#endif
+
+}
+
+MmapPolicyAllocator::MmapPolicyAllocator(const MemoryPolicy& policy)
+    : _policy(policy),
+      _huge_page_size(policy.huge_page_size()),
+      _lock(),
+      _huge_page_mappings(),
+      _mapped_bytes(0),
+      _huge_page_bytes(0),
+      _fallbacks(0),
+      _numa_failures(0)
+{
+}
+
+MmapPolicyAllocator::~MmapPolicyAllocator() = default;
+
+bool
+MmapPolicyAllocator::use_huge_pages(size_t mapped_sz) const noexcept
+{
+    if (_huge_page_size == 0 || mapped_sz < _huge_page_size) {
+        return false;
+    }
+    return (round_up(mapped_sz, _huge_page_size) - mapped_sz) <= mapped_sz / 8;
+}
+
+size_t
+MmapPolicyAllocator::mapped_size(size_t sz) const noexcept
+{
+    // Must give the same result for the requested and the returned size, since both are used when freeing.
+    size_t mapped_sz = round_up_to_page_size(sz);
+    return use_huge_pages(mapped_sz) ? round_up(mapped_sz, _huge_page_size) : mapped_sz;
+}
+
+void
+MmapPolicyAllocator::apply_numa_policy(void *buf, size_t mapped_sz) const noexcept
+{
+#ifdef __linux__
+    if (_policy.numa == MemoryPolicy::Numa::DEFAULT) {
+        return;
+    }
+    uint64_t mask = allowed_numa_nodes();
+    if (_policy.numa_node_mask != 0) {
+        mask &= _policy.numa_node_mask;
+    }
+    int mode = (_policy.numa == MemoryPolicy::Numa::BIND) ? mpol_bind : mpol_interleave;
+    if (mask == 0 || syscall(SYS_mbind, buf, mapped_sz, mode, &mask, numa_mask_bits + 1, 0u) != 0) {
+        _numa_failures.fetch_add(1, std::memory_order_relaxed);
+        LOG(debug, "Failed applying numa policy %s with node mask 0x%" PRIx64 " to %zu bytes at %p: errno %d",
+            to_string(_policy.numa).data(), mask, mapped_sz, buf, errno);
+    }
+#else
+    (void) buf;
+    (void) mapped_sz;
+#endif
+}
+
+void *
+MmapPolicyAllocator::map(size_t mapped_sz) const
+{
+    if (_policy.huge_pages == MemoryPolicy::HugePages::DEFAULT) {
+        void *buf = MemoryAllocator::select_mmap_allocator()->alloc(mapped_sz).get();
+        apply_numa_policy(buf, mapped_sz);
+        _mapped_bytes.fetch_add(mapped_sz, std::memory_order_relaxed);
+        return buf;
+    }
+    const int prot = PROT_READ | PROT_WRITE;
+    const int flags = MAP_ANON | MAP_PRIVATE;
+    void *buf = MAP_FAILED;
+#ifdef __linux__
+    if (use_huge_pages(mapped_sz)) {
+        int huge_flags = MAP_HUGETLB | (std::countr_zero(_huge_page_size) << MAP_HUGE_SHIFT);
+        buf = mmap(nullptr, mapped_sz, prot, flags | huge_flags, -1, 0);
+        if (buf != MAP_FAILED) {
+            std::lock_guard guard(_lock);
+            _huge_page_mappings.insert(buf);
+            _huge_page_bytes.fetch_add(mapped_sz, std::memory_order_relaxed);
+        } else {
+            _fallbacks.fetch_add(1, std::memory_order_relaxed);
+            LOG(debug, "Failed mapping %zu bytes with %s huge pages: errno %d. Using normal pages",
+                mapped_sz, to_string(_policy.huge_pages).data(), errno);
+        }
+    }
+#endif
+    if (buf == MAP_FAILED) {
+        buf = mmap(nullptr, mapped_sz, prot, flags, -1, 0);
+        if (buf == MAP_FAILED) {
+            throw OOMException(fmt("Failed mmaping anonymous of size %zu errno(%d)", mapped_sz, errno));
+        }
+#ifdef __linux__
+        // Just an advise, not everyone will listen...
+        if (_policy.huge_pages == MemoryPolicy::HugePages::NONE) {
+            madvise(buf, mapped_sz, MADV_NOHUGEPAGE);
+        } else {
+            madvise(buf, mapped_sz, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    apply_numa_policy(buf, mapped_sz);
+    _mapped_bytes.fetch_add(mapped_sz, std::memory_order_relaxed);
+    return buf;
+}
+
+PtrAndSize
+MmapPolicyAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return {};
+    }
+    if (sz < small_limit) {
+        void *buf = malloc(sz);
+        if (buf == nullptr) {
+            throw OOMException(fmt("Failed allocating %zu bytes from heap", sz));
+        }
+        return {buf, sz};
+    }
+    size_t mapped_sz = mapped_size(sz);
+    return {map(mapped_sz), mapped_sz};
+}
+
+void
+MmapPolicyAllocator::free(PtrAndSize alloc) const noexcept
+{
+    if (alloc.get() == nullptr) {
+        return;
+    }
+    if (alloc.size() < small_limit) {
+        ::free(alloc.get());
+        return;
+    }
+    size_t mapped_sz = mapped_size(alloc.size());
+    _mapped_bytes.fetch_sub(mapped_sz, std::memory_order_relaxed);
+    if (_policy.huge_pages == MemoryPolicy::HugePages::DEFAULT) {
+        MemoryAllocator::select_mmap_allocator()->free(PtrAndSize(alloc.get(), mapped_sz));
+        return;
+    }
+    {
+        std::lock_guard guard(_lock);
+        auto itr = _huge_page_mappings.find(alloc.get());
+        if (itr != _huge_page_mappings.end()) {
+            _huge_page_mappings.erase(alloc.get());
+            _huge_page_bytes.fetch_sub(mapped_sz, std::memory_order_relaxed);
+        }
+    }
+    int retval = munmap(alloc.get(), mapped_sz);
+    assert(retval == 0);
+    (void) retval;
+}
+
+size_t
+MmapPolicyAllocator::resize_inplace(PtrAndSize, size_t) const
+{
+    return 0;
+}
+
+MmapPolicyAllocator::Stats
+MmapPolicyAllocator::get_stats() const noexcept
+{
+    Stats stats;
+    stats.mapped_bytes = _mapped_bytes.load(std::memory_order_relaxed);
+    stats.huge_page_bytes = _huge_page_bytes.load(std::memory_order_relaxed);
+    stats.fallbacks = _fallbacks.load(std::memory_order_relaxed);
+    stats.numa_failures = _numa_failures.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}
@@ -0,0 +1,63 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "memory_allocator.h"
+#include "memory_policy.h"
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <atomic>
+#include <mutex>
+
+namespace vespalib::alloc {
+
+/*
+ * Class handling memory allocations with a given huge page and NUMA
+ * policy. Thread safe.
+ *
+ * Allocations smaller than small_limit are served from the heap, where
+ * the policy cannot be applied. Larger allocations are anonymous memory
+ * mappings. With the default huge page policy, mappings are made by the
+ * process wide mmap allocator, which honors VESPA_USE_HUGEPAGES. With an
+ * explicit huge page policy, allocations of at least one huge page are
+ * mapped with huge pages when rounding up to whole huge pages wastes at
+ * most 1/8 of the allocation. If no huge pages are
+ * available, normal pages are used instead and the fallback is counted.
+ * The NUMA policy is applied to each mapping before it is touched.
+ */
+class MmapPolicyAllocator : public MemoryAllocator {
+public:
+    struct Stats {
+        size_t   mapped_bytes;    // Bytes in memory mappings
+        size_t   huge_page_bytes; // Bytes in mappings backed by explicit huge pages
+        uint64_t fallbacks;       // Mappings that fell back to normal pages
+        uint64_t numa_failures;   // Mappings where the NUMA policy could not be applied
+        Stats() noexcept : mapped_bytes(0), huge_page_bytes(0), fallbacks(0), numa_failures(0) { }
+    };
+    static constexpr size_t small_limit = 128_Ki;
+private:
+    const MemoryPolicy         _policy;
+    const size_t               _huge_page_size;
+    mutable std::mutex         _lock;
+    mutable hash_set<void *>   _huge_page_mappings;
+    mutable std::atomic<size_t>   _mapped_bytes;
+    mutable std::atomic<size_t>   _huge_page_bytes;
+    mutable std::atomic<uint64_t> _fallbacks;
+    mutable std::atomic<uint64_t> _numa_failures;
+
+    size_t mapped_size(size_t sz) const noexcept;
+    bool use_huge_pages(size_t mapped_sz) const noexcept;
+    void *map(size_t mapped_sz) const;
+    void apply_numa_policy(void *buf, size_t mapped_sz) const noexcept;
+public:
+    explicit MmapPolicyAllocator(const MemoryPolicy& policy);
+    ~MmapPolicyAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const noexcept override;
+    using MemoryAllocator::free;
+    size_t resize_inplace(PtrAndSize, size_t) const override;
+
+    const MemoryPolicy& get_policy() const noexcept { return _policy; }
+    Stats get_stats() const noexcept;
+};
+
+}
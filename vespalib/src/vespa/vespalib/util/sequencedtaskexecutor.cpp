@@ -119,6 +119,7 @@ void
 SequencedTaskExecutor::executeTask(ExecutorId id, vespalib::Executor::Task::UP task)
 {
     assert(id.getId() < _executors.size());
+    count_scheduled_task(id);
     auto rejectedTask = _executors[id.getId()]->execute(std::move(task));
     assert(!rejectedTask);
 }
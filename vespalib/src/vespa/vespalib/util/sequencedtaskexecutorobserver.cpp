@@ -20,6 +20,7 @@ void
 SequencedTaskExecutorObserver::executeTask(ExecutorId id, Executor::Task::UP task)
 {
     ++_executeCnt;
+    count_scheduled_task(id);
     {
         std::lock_guard<std::mutex> guard(_mutex);
         _executeHistory.emplace_back(id.getId());
@@ -34,6 +35,7 @@ SequencedTaskExecutorObserver::executeTasks(TaskList tasks)
     {
         std::lock_guard<std::mutex> guard(_mutex);
         for (const auto & task : tasks) {
+            count_scheduled_task(task.first);
             _executeHistory.emplace_back(task.first.getId());
         }
     }
@@ -49,8 +49,16 @@ char *
 Stash::do_alloc(size_t size)
 {
     if (is_small(size)) {
-        void *chunk_mem = malloc(_chunk_size);
-        _chunks = new (chunk_mem) stash::Chunk(_chunks);
+        if (_spare != nullptr) {
+            stash::Chunk *chunk = _spare;
+            _spare = chunk->next;
+            chunk->next = _chunks;
+            chunk->clear();
+            _chunks = chunk;
+        } else {
+            void *chunk_mem = malloc(_chunk_size);
+            _chunks = new (chunk_mem) stash::Chunk(_chunks);
+        }
         return _chunks->alloc(size, _chunk_size);
     } else {
         size_t allocate = sizeof(stash::DeleteMemory) + size;
@@ -62,6 +70,7 @@ Stash::do_alloc(size_t size)
 
 Stash::Stash(size_t chunk_size) noexcept
     : _chunks(nullptr),
+      _spare(nullptr),
       _cleanup(nullptr),
       _chunk_size(std::max(size_t(128), chunk_size))
 {
@@ -69,10 +78,12 @@ Stash::Stash(size_t chunk_size) noexcept
 
 Stash::Stash(Stash &&rhs) noexcept
     : _chunks(rhs._chunks),
+      _spare(rhs._spare),
       _cleanup(rhs._cleanup),
       _chunk_size(rhs._chunk_size)
 {
     rhs._chunks = nullptr;
+    rhs._spare = nullptr;
     rhs._cleanup = nullptr;
 }
 
@@ -81,10 +92,13 @@ Stash::operator=(Stash &&rhs) noexcept
 {
     stash::run_cleanup(_cleanup);
     stash::free_chunks(_chunks);
+    stash::free_chunks(_spare);
     _chunks = rhs._chunks;
+    _spare = rhs._spare;
     _cleanup = rhs._cleanup;
     _chunk_size = rhs._chunk_size;
     rhs._chunks = nullptr;
+    rhs._spare = nullptr;
     rhs._cleanup = nullptr;
     return *this;
 }
@@ -93,6 +107,7 @@ Stash::~Stash()
 {
     stash::run_cleanup(_cleanup);
     stash::free_chunks(_chunks);
+    stash::free_chunks(_spare);
 }
 
 void
@@ -100,6 +115,22 @@ Stash::clear()
 {
     _cleanup = stash::run_cleanup(_cleanup);
     _chunks = stash::keep_one(_chunks);
+    _spare = stash::free_chunks(_spare);
+}
+
+void
+Stash::reset()
+{
+    _cleanup = stash::run_cleanup(_cleanup);
+    // spare chunks not needed since the previous reset are freed, so
+    // that a single large piece of work does not pin its memory forever
+    _spare = stash::free_chunks(_spare);
+    while (_chunks != nullptr) {
+        stash::Chunk *chunk = _chunks;
+        _chunks = chunk->next;
+        chunk->next = _spare;
+        _spare = chunk;
+    }
 }
 
 void
@@ -131,6 +162,9 @@ Stash::get_memory_usage() const
         allocated += _chunk_size;
         used += chunk->used;
     }
+    for (stash::Chunk *chunk = _spare; chunk != nullptr; chunk = chunk->next) {
+        allocated += _chunk_size;
+    }
     for (auto cleanup = _cleanup; cleanup; cleanup = cleanup->next) {
         auto extra = cleanup->allocated();
         allocated += extra;
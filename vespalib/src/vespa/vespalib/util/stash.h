@@ -85,6 +85,7 @@ class Stash
 {
 private:
     stash::Chunk   *_chunks;
+    stash::Chunk   *_spare;
     stash::Cleanup *_cleanup;
     size_t          _chunk_size;
 
@@ -142,6 +143,19 @@ public:
 
     void clear();
 
+    /**
+     * Destruct all objects in the stash like clear, but keep the
+     * memory chunks in use for later allocations instead of freeing
+     * all but one of them. This makes allocation free of heap
+     * operations in steady state when the stash is used to perform
+     * the same kind of work over and over again. Chunks kept by the
+     * previous reset that were not needed since then are freed, so
+     * the stash only retains what the last round of work used.
+     * Objects allocated outside the chunks (see class comment) are
+     * still freed.
+     **/
+    void reset();
+
     Mark mark() const noexcept { return Mark(_cleanup, _chunks); }
     void revert(const Mark &mark);
 